@@ -0,0 +1,525 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <yoga/YGMarker.h>
+
+namespace {
+
+struct Registration {
+  std::string name;
+  YGBenchmarkFactory factory;
+};
+
+std::vector<Registration>& registrations() {
+  static std::vector<Registration> registrations;
+  return registrations;
+}
+
+struct Options {
+  uint32_t warmupIterations = 10;
+  double warmupTimeMs = 100;
+  uint32_t minIterations = 30;
+  uint32_t maxIterations = 100000;
+  double minTimeMs = 500;
+  int cpu = -2; // The CPU the benchmark starts on; -1 disables pinning.
+  std::string filter;
+  std::string jsonPath;
+  std::string baselinePath;
+  double threshold = 0.05;
+};
+
+struct Result {
+  std::string name;
+  uint32_t iterations = 0;
+  double minNs = 0;
+  double medianNs = 0;
+  double meanNs = 0;
+  double stddevNs = 0;
+  double p90Ns = 0;
+  double p99Ns = 0;
+  double maxNs = 0;
+  // Means per iteration of the counters of the layout marker.
+  double layouts = 0;
+  double measures = 0;
+  double cachedLayouts = 0;
+  double cachedMeasures = 0;
+};
+
+struct Baseline {
+  double medianNs = 0;
+  double layouts = -1;
+  double measures = -1;
+};
+
+// The counters of the layouts timed by the current iteration. The runner is
+// single threaded, so the marker callback can add them up in a global.
+YGMarkerLayoutData layoutCounters;
+
+void endMarker(YGMarker marker, YGNodeRef, YGMarkerData data, void*) {
+  if (marker == YGMarkerLayout) {
+    const YGMarkerLayoutData& layout = *data.layout;
+    layoutCounters.layouts += layout.layouts;
+    layoutCounters.measures += layout.measures;
+    layoutCounters.cachedLayouts += layout.cachedLayouts;
+    layoutCounters.cachedMeasures += layout.cachedMeasures;
+  }
+}
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// Linearly interpolates between the closest ranks of sorted samples.
+double percentile(const std::vector<double>& sorted, double p) {
+  const double rank = p * (sorted.size() - 1);
+  const size_t lower = static_cast<size_t>(rank);
+  const size_t upper = std::min(lower + 1, sorted.size() - 1);
+  return sorted[lower] + (rank - lower) * (sorted[upper] - sorted[lower]);
+}
+
+Result summarize(
+    const std::string& name,
+    std::vector<double> samples,
+    const YGMarkerLayoutData& counters) {
+  std::sort(samples.begin(), samples.end());
+  Result result;
+  result.name = name;
+  result.layouts = static_cast<double>(counters.layouts) / samples.size();
+  result.measures = static_cast<double>(counters.measures) / samples.size();
+  result.cachedLayouts =
+      static_cast<double>(counters.cachedLayouts) / samples.size();
+  result.cachedMeasures =
+      static_cast<double>(counters.cachedMeasures) / samples.size();
+  result.iterations = static_cast<uint32_t>(samples.size());
+  result.minNs = samples.front();
+  result.maxNs = samples.back();
+  result.medianNs = percentile(samples, 0.5);
+  result.p90Ns = percentile(samples, 0.9);
+  result.p99Ns = percentile(samples, 0.99);
+
+  double sum = 0;
+  for (const double sample : samples) {
+    sum += sample;
+  }
+  result.meanNs = sum / samples.size();
+  double variance = 0;
+  for (const double sample : samples) {
+    variance += (sample - result.meanNs) * (sample - result.meanNs);
+  }
+  result.stddevNs = std::sqrt(variance / samples.size());
+  return result;
+}
+
+double timeIteration(YGBenchmarkScenario& scenario, uint32_t iteration) {
+  scenario.setUp(iteration);
+  // Layouts done by setUp are not counted, like they are not timed.
+  layoutCounters = {};
+  const auto start = Clock::now();
+  scenario.run();
+  const auto end = Clock::now();
+  scenario.tearDown();
+  return elapsedNs(start, end);
+}
+
+Result runBenchmark(const Registration& registration, const Options& options) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMarkerCallbacks(config, {nullptr, endMarker});
+  std::unique_ptr<YGBenchmarkScenario> scenario = registration.factory(config);
+
+  // Warms up caches, the allocator and the branch predictors until both the
+  // iteration count and the time are reached.
+  uint32_t iteration = 0;
+  double warmupNs = 0;
+  while (iteration < options.warmupIterations ||
+         warmupNs < options.warmupTimeMs * 1e6) {
+    warmupNs += timeIteration(*scenario, iteration++);
+  }
+
+  std::vector<double> samples;
+  YGMarkerLayoutData counters = {};
+  double totalNs = 0;
+  while (samples.size() < options.maxIterations &&
+         (samples.size() < options.minIterations ||
+          totalNs < options.minTimeMs * 1e6)) {
+    samples.push_back(timeIteration(*scenario, iteration++));
+    totalNs += samples.back();
+    counters.layouts += layoutCounters.layouts;
+    counters.measures += layoutCounters.measures;
+    counters.cachedLayouts += layoutCounters.cachedLayouts;
+    counters.cachedMeasures += layoutCounters.cachedMeasures;
+  }
+
+  scenario.reset();
+  YGConfigFree(config);
+  return summarize(registration.name, std::move(samples), counters);
+}
+
+int pinToCpu(int cpu) {
+#ifdef __linux__
+  if (cpu == -2) {
+    cpu = sched_getcpu();
+  }
+  if (cpu < 0) {
+    return -1;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    std::fprintf(stderr, "warning: could not pin to CPU %d\n", cpu);
+    return -1;
+  }
+  return cpu;
+#else
+  if (cpu >= 0) {
+    std::fprintf(stderr, "warning: CPU pinning is not supported\n");
+  }
+  return -1;
+#endif
+}
+
+std::string escapeJson(const std::string& string) {
+  std::string escaped;
+  for (const char c : string) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+void writeJson(
+    std::FILE* file,
+    const std::vector<Result>& results,
+    const Options& options,
+    int cpu) {
+  std::fprintf(file, "{\n  \"context\": {\n");
+  std::fprintf(file, "    \"cpu\": %d,\n", cpu);
+  std::fprintf(
+      file, "    \"warmup_iterations\": %u,\n", options.warmupIterations);
+  std::fprintf(file, "    \"min_iterations\": %u,\n", options.minIterations);
+  std::fprintf(file, "    \"min_time_ms\": %.1f\n", options.minTimeMs);
+  std::fprintf(file, "  },\n  \"benchmarks\": [");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& result = results[i];
+    std::fprintf(file, "%s\n    {\n", i == 0 ? "" : ",");
+    std::fprintf(
+        file, "      \"name\": \"%s\",\n", escapeJson(result.name).c_str());
+    std::fprintf(file, "      \"iterations\": %u,\n", result.iterations);
+    std::fprintf(file, "      \"min_ns\": %.1f,\n", result.minNs);
+    std::fprintf(file, "      \"median_ns\": %.1f,\n", result.medianNs);
+    std::fprintf(file, "      \"mean_ns\": %.1f,\n", result.meanNs);
+    std::fprintf(file, "      \"stddev_ns\": %.1f,\n", result.stddevNs);
+    std::fprintf(file, "      \"p90_ns\": %.1f,\n", result.p90Ns);
+    std::fprintf(file, "      \"p99_ns\": %.1f,\n", result.p99Ns);
+    std::fprintf(file, "      \"max_ns\": %.1f,\n", result.maxNs);
+    std::fprintf(file, "      \"layouts\": %.2f,\n", result.layouts);
+    std::fprintf(file, "      \"measures\": %.2f,\n", result.measures);
+    std::fprintf(
+        file, "      \"cached_layouts\": %.2f,\n", result.cachedLayouts);
+    std::fprintf(
+        file, "      \"cached_measures\": %.2f\n", result.cachedMeasures);
+    std::fprintf(file, "    }");
+  }
+  std::fprintf(file, "\n  ]\n}\n");
+}
+
+void printTable(std::FILE* file, const std::vector<Result>& results) {
+  std::fprintf(
+      file,
+      "%-36s %8s %12s %12s %12s %12s\n",
+      "benchmark",
+      "iters",
+      "median us",
+      "p90 us",
+      "p99 us",
+      "stddev us");
+  for (const Result& result : results) {
+    std::fprintf(
+        file,
+        "%-36s %8u %12.3f %12.3f %12.3f %12.3f\n",
+        result.name.c_str(),
+        result.iterations,
+        result.medianNs / 1e3,
+        result.p90Ns / 1e3,
+        result.p99Ns / 1e3,
+        result.stddevNs / 1e3);
+  }
+
+  std::fprintf(
+      file,
+      "\n%-36s %12s %12s %14s %15s\n",
+      "per iteration",
+      "layouts",
+      "measures",
+      "cachedLayouts",
+      "cachedMeasures");
+  for (const Result& result : results) {
+    std::fprintf(
+        file,
+        "%-36s %12.1f %12.1f %14.1f %15.1f\n",
+        result.name.c_str(),
+        result.layouts,
+        result.measures,
+        result.cachedLayouts,
+        result.cachedMeasures);
+  }
+}
+
+// Returns the number following key in the benchmark at position, or fallback
+// for files written before the key was added.
+double readNumber(
+    const std::string& json,
+    const std::string& key,
+    size_t position,
+    size_t end,
+    double fallback) {
+  const size_t found = json.find("\"" + key + "\": ", position);
+  if (found == std::string::npos || found > end) {
+    return fallback;
+  }
+  return std::strtod(json.c_str() + found + key.size() + 4, nullptr);
+}
+
+// Reads the results back from a file written by writeJson. This only has to
+// understand the output of this benchmark, so it scans for the keys it needs
+// instead of parsing JSON in general.
+bool readBaseline(
+    const std::string& path,
+    std::map<std::string, Baseline>& baselines) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string json = buffer.str();
+
+  const std::string nameKey = "\"name\": \"";
+  size_t position = json.find("\"benchmarks\"");
+  while (position != std::string::npos &&
+         (position = json.find(nameKey, position)) != std::string::npos) {
+    const size_t nameStart = position + nameKey.size();
+    const size_t nameEnd = json.find('"', nameStart);
+    if (nameEnd == std::string::npos) {
+      return false;
+    }
+    const size_t end = json.find('}', nameEnd);
+    Baseline& baseline = baselines[json.substr(nameStart, nameEnd - nameStart)];
+    baseline.medianNs = readNumber(json, "median_ns", nameEnd, end, -1);
+    if (baseline.medianNs < 0) {
+      return false;
+    }
+    baseline.layouts = readNumber(json, "layouts", nameEnd, end, -1);
+    baseline.measures = readNumber(json, "measures", nameEnd, end, -1);
+    position = end;
+  }
+  return true;
+}
+
+// Compares medians, which unlike means are not skewed by the occasional
+// descheduled iteration. The counters do not depend on timing at all, so more
+// layouts or measures than in the baseline are flagged too, which catches
+// caching regressions that are too small to stand out from the noise.
+// Returns the number of regressions.
+int compareWithBaseline(
+    std::FILE* file,
+    const std::vector<Result>& results,
+    const std::map<std::string, Baseline>& baselines,
+    double threshold) {
+  int regressions = 0;
+  std::fprintf(
+      file,
+      "\n%-36s %12s %12s %9s\n",
+      "benchmark",
+      "baseline us",
+      "median us",
+      "change");
+  for (const Result& result : results) {
+    const auto entry = baselines.find(result.name);
+    if (entry == baselines.end()) {
+      std::fprintf(file, "%-36s %12s\n", result.name.c_str(), "new");
+      continue;
+    }
+    const Baseline& baseline = entry->second;
+    const double change = result.medianNs / baseline.medianNs - 1;
+    const char* verdict = "";
+    if (change > threshold) {
+      verdict = "  REGRESSION";
+      regressions++;
+    } else if (
+        (baseline.layouts >= 0 &&
+         result.layouts > baseline.layouts * (1 + threshold)) ||
+        (baseline.measures >= 0 &&
+         result.measures > baseline.measures * (1 + threshold))) {
+      verdict = "  REGRESSION (more layouts or measures)";
+      regressions++;
+    } else if (change < -threshold) {
+      verdict = "  improvement";
+    }
+    std::fprintf(
+        file,
+        "%-36s %12.3f %12.3f %+8.1f%%%s\n",
+        result.name.c_str(),
+        baseline.medianNs / 1e3,
+        result.medianNs / 1e3,
+        change * 100,
+        verdict);
+  }
+  return regressions;
+}
+
+void printUsage(const char* program) {
+  std::fprintf(
+      stderr,
+      "usage: %s [options]\n"
+      "  --filter=SUBSTRING   only run benchmarks whose name contains it\n"
+      "  --warmup=N           untimed iterations before measuring (10)\n"
+      "  --warmup-time=MS     minimum time spent warming up (100)\n"
+      "  --iterations=N       minimum timed iterations (30)\n"
+      "  --max-iterations=N   maximum timed iterations (100000)\n"
+      "  --min-time=MS        minimum time spent measuring (500)\n"
+      "  --cpu=N              CPU to pin to, -1 to not pin (current CPU)\n"
+      "  --json=PATH          write results as JSON, - for stdout\n"
+      "  --baseline=PATH      compare with results written by --json\n"
+      "  --threshold=PERCENT  median slowdown that is a regression (5)\n",
+      program);
+}
+
+bool parseOptions(int argc, const char* argv[], Options& options) {
+  for (int i = 1; i < argc; i++) {
+    const char* argument = argv[i];
+    const char* value = std::strchr(argument, '=');
+    if (value == nullptr) {
+      return false;
+    }
+    const std::string name(argument, value - argument);
+    value++;
+    if (name == "--filter") {
+      options.filter = value;
+    } else if (name == "--warmup") {
+      options.warmupIterations = std::strtoul(value, nullptr, 10);
+    } else if (name == "--warmup-time") {
+      options.warmupTimeMs = std::strtod(value, nullptr);
+    } else if (name == "--iterations") {
+      options.minIterations = std::max(1ul, std::strtoul(value, nullptr, 10));
+    } else if (name == "--max-iterations") {
+      options.maxIterations = std::max(1ul, std::strtoul(value, nullptr, 10));
+    } else if (name == "--min-time") {
+      options.minTimeMs = std::strtod(value, nullptr);
+    } else if (name == "--cpu") {
+      options.cpu = std::max(-1l, std::strtol(value, nullptr, 10));
+    } else if (name == "--json") {
+      options.jsonPath = value;
+    } else if (name == "--baseline") {
+      options.baselinePath = value;
+    } else if (name == "--threshold") {
+      options.threshold = std::strtod(value, nullptr) / 100;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+void YGRegisterBenchmark(const char* name, YGBenchmarkFactory factory) {
+  registrations().push_back({name, std::move(factory)});
+}
+
+void YGRegisterColdLayoutBenchmark(
+    const char* name,
+    YGColdLayoutScenario::CreateTree createTree) {
+  YGRegisterBenchmark(name, [createTree](YGConfigRef config) {
+    return std::unique_ptr<YGBenchmarkScenario>(
+        new YGColdLayoutScenario(config, createTree));
+  });
+}
+
+int main(int argc, const char* argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  std::map<std::string, Baseline> baselines;
+  if (!options.baselinePath.empty() &&
+      !readBaseline(options.baselinePath, baselines)) {
+    std::fprintf(
+        stderr, "error: could not read %s\n", options.baselinePath.c_str());
+    return 2;
+  }
+
+  YGRegisterLayoutBenchmarks();
+
+  const int cpu = pinToCpu(options.cpu);
+  // Progress and tables go to stderr when stdout is taken by the JSON.
+  std::FILE* const report = options.jsonPath == "-" ? stderr : stdout;
+  std::vector<Result> results;
+  for (const Registration& registration : registrations()) {
+    if (registration.name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+    results.push_back(runBenchmark(registration, options));
+    const Result& result = results.back();
+    std::fprintf(
+        report,
+        "%s: median: %.3f us, p90: %.3f us\n",
+        result.name.c_str(),
+        result.medianNs / 1e3,
+        result.p90Ns / 1e3);
+    std::fflush(report);
+  }
+
+  std::fprintf(report, "\n");
+  printTable(report, results);
+
+  if (options.jsonPath == "-") {
+    writeJson(stdout, results, options, cpu);
+  } else if (!options.jsonPath.empty()) {
+    std::FILE* const file = std::fopen(options.jsonPath.c_str(), "w");
+    if (file == nullptr) {
+      std::fprintf(
+          stderr, "error: could not write %s\n", options.jsonPath.c_str());
+      return 2;
+    }
+    writeJson(file, results, options, cpu);
+    std::fclose(file);
+  }
+
+  if (!options.baselinePath.empty()) {
+    const int regressions =
+        compareWithBaseline(report, results, baselines, options.threshold);
+    if (regressions > 0) {
+      std::fprintf(report, "\n%d regression(s)\n", regressions);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <yoga/Yoga.h>
+
+// A benchmark scenario. The runner calls setUp before and tearDown after every
+// call to run, and only run is timed. Scenarios are created once per run of the
+// benchmark, so state that outlives iterations belongs to the scenario itself.
+class YGBenchmarkScenario {
+ public:
+  virtual ~YGBenchmarkScenario() = default;
+  virtual void setUp(uint32_t iteration) {}
+  virtual void run() = 0;
+  virtual void tearDown() {}
+};
+
+using YGBenchmarkFactory =
+    std::function<std::unique_ptr<YGBenchmarkScenario>(YGConfigRef config)>;
+
+// Times the first layout of a tree built by createTree before every iteration.
+class YGColdLayoutScenario : public YGBenchmarkScenario {
+ public:
+  using CreateTree = std::function<YGNodeRef(YGConfigRef config)>;
+
+  YGColdLayoutScenario(YGConfigRef config, CreateTree createTree)
+      : config_(config), createTree_(std::move(createTree)) {}
+
+  void setUp(uint32_t iteration) override {
+    root_ = createTree_(config_);
+  }
+
+  void run() override {
+    YGNodeCalculateLayout(root_, YGUndefined, YGUndefined, YGDirectionLTR);
+  }
+
+  void tearDown() override {
+    YGNodeFreeRecursive(root_);
+    root_ = nullptr;
+  }
+
+ private:
+  YGConfigRef config_;
+  CreateTree createTree_;
+  YGNodeRef root_ = nullptr;
+};
+
+// Registers a scenario under a unique name. Every scenario gets a config of
+// its own, which the runner frees after the scenario.
+void YGRegisterBenchmark(const char* name, YGBenchmarkFactory factory);
+
+void YGRegisterColdLayoutBenchmark(
+    const char* name,
+    YGColdLayoutScenario::CreateTree createTree);
+
+// Defined in YGBenchmarkScenarios.cpp.
+void YGRegisterLayoutBenchmarks();
@@ -0,0 +1,530 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGBenchmark.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+YGSize measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{
+      widthMode == YGMeasureModeUndefined ? 10 : width,
+      heightMode == YGMeasureModeUndefined ? 10 : width,
+  };
+}
+
+YGNodeRef createStackWithFlex(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  for (uint32_t i = 0; i < 10; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeSetMeasureFunc(child, measure);
+    YGNodeStyleSetFlex(child, 1);
+    YGNodeInsertChild(root, child, 0);
+  }
+  return root;
+}
+
+YGNodeRef createAlignStretchInUndefinedAxis(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+
+  for (uint32_t i = 0; i < 10; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetHeight(child, 20);
+    YGNodeSetMeasureFunc(child, measure);
+    YGNodeInsertChild(root, child, 0);
+  }
+  return root;
+}
+
+YGNodeRef createNestedFlex(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+
+  for (uint32_t i = 0; i < 10; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlex(child, 1);
+    YGNodeInsertChild(root, child, 0);
+
+    for (uint32_t ii = 0; ii < 10; ii++) {
+      const YGNodeRef grandChild = YGNodeNewWithConfig(config);
+      YGNodeSetMeasureFunc(grandChild, measure);
+      YGNodeStyleSetFlex(grandChild, 1);
+      YGNodeInsertChild(child, grandChild, 0);
+    }
+  }
+  return root;
+}
+
+YGNodeRef createHugeNestedLayout(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  std::vector<YGNodeRef> level{root};
+  for (uint32_t depth = 0; depth < 4; depth++) {
+    std::vector<YGNodeRef> nextLevel;
+    for (const YGNodeRef owner : level) {
+      for (uint32_t i = 0; i < 10; i++) {
+        const YGNodeRef child = YGNodeNewWithConfig(config);
+        if (depth % 2 == 1) {
+          YGNodeStyleSetFlexDirection(child, YGFlexDirectionRow);
+        }
+        YGNodeStyleSetFlexGrow(child, 1);
+        YGNodeStyleSetWidth(child, 10);
+        YGNodeStyleSetHeight(child, 10);
+        YGNodeInsertChild(owner, child, 0);
+        nextLevel.push_back(child);
+      }
+    }
+    level = std::move(nextLevel);
+  }
+  return root;
+}
+
+YGNodeRef createWrappingRowsOfColumns(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  for (uint32_t i = 0; i < 100; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidthPercent(child, 9.5);
+    YGNodeStyleSetMargin(child, YGEdgeAll, 2);
+    YGNodeInsertChild(root, child, i);
+
+    for (uint32_t ii = 0; ii < 10; ii++) {
+      const YGNodeRef grandChild = YGNodeNewWithConfig(config);
+      YGNodeStyleSetHeight(grandChild, 10);
+      YGNodeStyleSetFlexShrink(grandChild, 1);
+      YGNodeInsertChild(child, grandChild, ii);
+    }
+  }
+  return root;
+}
+
+// One story of the feed in tests/YGAndroidNewsFeed.cpp: an image next to a
+// column of two lines.
+YGNodeRef createNewsFeedStory(
+    YGConfigRef config,
+    float marginStart,
+    float imageSize) {
+  const YGNodeRef story = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignContent(story, YGAlignStretch);
+
+  const YGNodeRef row = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+  YGNodeStyleSetAlignContent(row, YGAlignStretch);
+  YGNodeStyleSetAlignItems(row, YGAlignFlexStart);
+  YGNodeStyleSetMargin(row, YGEdgeStart, marginStart);
+  YGNodeStyleSetMargin(row, YGEdgeTop, 24);
+  YGNodeInsertChild(story, row, 0);
+
+  const YGNodeRef imageContainer = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(imageContainer, YGFlexDirectionRow);
+  YGNodeStyleSetAlignContent(imageContainer, YGAlignStretch);
+  YGNodeInsertChild(row, imageContainer, 0);
+
+  const YGNodeRef image = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignContent(image, YGAlignStretch);
+  YGNodeStyleSetWidth(image, imageSize);
+  YGNodeStyleSetHeight(image, imageSize);
+  YGNodeInsertChild(imageContainer, image, 0);
+
+  const YGNodeRef text = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignContent(text, YGAlignStretch);
+  YGNodeStyleSetFlexShrink(text, 1);
+  YGNodeStyleSetMargin(text, YGEdgeRight, 36);
+  YGNodeStyleSetPadding(text, YGEdgeLeft, 36);
+  YGNodeStyleSetPadding(text, YGEdgeTop, 21);
+  YGNodeStyleSetPadding(text, YGEdgeRight, 36);
+  YGNodeStyleSetPadding(text, YGEdgeBottom, 18);
+  YGNodeInsertChild(row, text, 1);
+
+  const YGNodeRef title = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(title, YGFlexDirectionRow);
+  YGNodeStyleSetAlignContent(title, YGAlignStretch);
+  YGNodeStyleSetFlexShrink(title, 1);
+  YGNodeInsertChild(text, title, 0);
+
+  const YGNodeRef subtitle = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignContent(subtitle, YGAlignStretch);
+  YGNodeStyleSetFlexShrink(subtitle, 1);
+  YGNodeInsertChild(text, subtitle, 1);
+  return story;
+}
+
+YGNodeRef createNewsFeedContent(YGConfigRef config) {
+  const YGNodeRef content = YGNodeNewWithConfig(config);
+  const YGNodeRef stories = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignContent(stories, YGAlignStretch);
+  YGNodeInsertChild(content, stories, 0);
+  YGNodeInsertChild(stories, createNewsFeedStory(config, 36, 120), 0);
+  YGNodeInsertChild(stories, createNewsFeedStory(config, 174, 72), 1);
+  return content;
+}
+
+YGNodeRef createAndroidNewsFeed(YGConfigRef config, uint32_t copies) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignContent(root, YGAlignStretch);
+  YGNodeStyleSetWidth(root, 1080);
+  for (uint32_t i = 0; i < copies; i++) {
+    YGNodeInsertChild(root, createNewsFeedContent(config), i);
+  }
+  return root;
+}
+
+// Nests columns and rows in turn, so every level stretches and grows the one
+// below it, down to a measured leaf.
+YGNodeRef createDeepChain(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 2000);
+  YGNodeRef owner = root;
+  for (uint32_t depth = 0; depth < 500; depth++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(
+        child, depth % 2 == 0 ? YGFlexDirectionRow : YGFlexDirectionColumn);
+    YGNodeStyleSetFlexGrow(child, 1);
+    YGNodeStyleSetPadding(child, YGEdgeAll, 1);
+    YGNodeInsertChild(owner, child, 0);
+    owner = child;
+  }
+  const YGNodeRef leaf = YGNodeNewWithConfig(config);
+  YGNodeSetMeasureFunc(leaf, measure);
+  YGNodeInsertChild(owner, leaf, 0);
+  return root;
+}
+
+YGNodeRef createFlexWrap(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  YGNodeStyleSetAlignContent(root, YGAlignFlexStart);
+  YGNodeStyleSetWidth(root, 1000);
+  for (uint32_t i = 0; i < 10000; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(child, 10 + i % 7 * 5);
+    YGNodeStyleSetHeight(child, 10 + i % 3 * 5);
+    YGNodeStyleSetMargin(child, YGEdgeAll, 1);
+    YGNodeStyleSetFlexGrow(child, i % 5 == 0 ? 1 : 0);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+// Widths of the words of a paragraph, which measureText breaks into lines the
+// way a text layout engine would.
+struct Text {
+  std::vector<float> words;
+};
+
+const std::vector<Text>& texts() {
+  static const std::vector<Text> texts = [] {
+    std::minstd_rand random(42);
+    std::vector<Text> texts(256);
+    for (Text& text : texts) {
+      text.words.resize(1 + random() % 60);
+      for (float& word : text.words) {
+        word = 8 + random() % 50;
+      }
+    }
+    return texts;
+  }();
+  return texts;
+}
+
+YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  constexpr float kSpaceWidth = 4;
+  constexpr float kLineHeight = 20;
+  const Text& text = *static_cast<const Text*>(YGNodeGetContext(node));
+  const bool fitsAnywhere = widthMode == YGMeasureModeUndefined;
+
+  float lineWidth = 0;
+  float maxLineWidth = 0;
+  uint32_t lines = 1;
+  for (const float word : text.words) {
+    if (lineWidth == 0) {
+      lineWidth = word;
+    } else if (fitsAnywhere || lineWidth + kSpaceWidth + word <= width) {
+      lineWidth += kSpaceWidth + word;
+    } else {
+      maxLineWidth = std::max(maxLineWidth, lineWidth);
+      lineWidth = word;
+      lines++;
+    }
+  }
+  maxLineWidth = std::max(maxLineWidth, lineWidth);
+  return YGSize{
+      widthMode == YGMeasureModeExactly ? width : maxLineWidth,
+      lines * kLineHeight,
+  };
+}
+
+YGNodeRef createText(YGConfigRef config, uint32_t index) {
+  const YGNodeRef text = YGNodeNewWithConfig(config);
+  YGNodeSetContext(
+      text, const_cast<Text*>(&texts()[index % texts().size()]));
+  YGNodeSetMeasureFunc(text, measureText);
+  YGNodeStyleSetFlexShrink(text, 1);
+  return text;
+}
+
+// Comment threads: every row has an avatar, a column with a name, the comment
+// and its actions, and a timestamp that competes with the column for width.
+YGNodeRef createTextTree(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 1080);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 16);
+  uint32_t index = 0;
+  for (uint32_t i = 0; i < 200; i++) {
+    const YGNodeRef row = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetAlignItems(row, YGAlignFlexStart);
+    YGNodeStyleSetMargin(row, YGEdgeStart, i % 4 * 48);
+    YGNodeStyleSetMargin(row, YGEdgeBottom, 12);
+    YGNodeInsertChild(root, row, i);
+
+    const YGNodeRef avatar = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(avatar, 40);
+    YGNodeStyleSetHeight(avatar, 40);
+    YGNodeStyleSetMargin(avatar, YGEdgeEnd, 8);
+    YGNodeInsertChild(row, avatar, 0);
+
+    const YGNodeRef body = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexShrink(body, 1);
+    YGNodeInsertChild(row, body, 1);
+    YGNodeInsertChild(body, createText(config, index++), 0);
+    YGNodeInsertChild(body, createText(config, index++), 1);
+
+    const YGNodeRef actions = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(actions, YGFlexDirectionRow);
+    YGNodeStyleSetFlexWrap(actions, YGWrapWrap);
+    YGNodeInsertChild(body, actions, 2);
+    for (uint32_t j = 0; j < 3; j++) {
+      const YGNodeRef action = createText(config, index++);
+      YGNodeStyleSetMargin(action, YGEdgeEnd, 12);
+      YGNodeInsertChild(actions, action, j);
+    }
+
+    const YGNodeRef timestamp = createText(config, index++);
+    YGNodeStyleSetMaxWidth(timestamp, 120);
+    YGNodeStyleSetMargin(timestamp, YGEdgeStart, 8);
+    YGNodeInsertChild(row, timestamp, 2);
+  }
+  return root;
+}
+
+// Tiles every node with four children sized, spaced and placed in percentages
+// of it.
+void insertPercentageChildren(YGConfigRef config, YGNodeRef owner, int depth) {
+  if (depth == 0) {
+    return;
+  }
+  YGNodeStyleSetFlexDirection(owner, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(owner, YGWrapWrap);
+  YGNodeStyleSetPaddingPercent(owner, YGEdgeAll, 2);
+  for (uint32_t i = 0; i < 4; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidthPercent(child, 46);
+    YGNodeStyleSetHeightPercent(child, 46);
+    YGNodeStyleSetMarginPercent(child, YGEdgeAll, 1);
+    YGNodeStyleSetMinWidthPercent(child, 10);
+    YGNodeStyleSetMaxHeightPercent(child, 48);
+    if (i % 2 == 1) {
+      YGNodeStyleSetFlexBasisPercent(child, 40);
+      YGNodeStyleSetFlexGrow(child, 1);
+    }
+    YGNodeInsertChild(owner, child, i);
+    insertPercentageChildren(config, child, depth - 1);
+  }
+}
+
+YGNodeRef createPercentageTree(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 1000);
+  YGNodeStyleSetHeight(root, 1000);
+  insertPercentageChildren(config, root, 5);
+  return root;
+}
+
+// Lays out a tree built and laid out once, after setUp applied a mutation to
+// it. Layouts that setUp needs to undo the previous mutation are not timed.
+class IncrementalLayout : public YGBenchmarkScenario {
+ public:
+  explicit IncrementalLayout(YGNodeRef root) : root_(root) {
+    layout();
+  }
+
+  ~IncrementalLayout() override {
+    YGNodeFreeRecursive(root_);
+  }
+
+  void run() override {
+    layout();
+  }
+
+ protected:
+  void layout() {
+    YGNodeCalculateLayout(root_, YGUndefined, YGUndefined, YGDirectionLTR);
+  }
+
+  const YGNodeRef root_;
+};
+
+// Cycles the width of the root through widths, as rotating a device or
+// resizing a window would.
+class RootResize : public IncrementalLayout {
+ public:
+  RootResize(YGNodeRef root, std::vector<float> widths)
+      : IncrementalLayout(root), widths_(std::move(widths)) {}
+
+  void setUp(uint32_t iteration) override {
+    YGNodeStyleSetWidth(root_, widths_[iteration % widths_.size()]);
+  }
+
+ private:
+  const std::vector<float> widths_;
+};
+
+// Widens the avatar of one row of the text tree at a time, which dirties the
+// row and its ancestors only.
+class StyleChange : public IncrementalLayout {
+ public:
+  explicit StyleChange(YGConfigRef config)
+      : IncrementalLayout(createTextTree(config)) {}
+
+  void setUp(uint32_t iteration) override {
+    const uint32_t rowCount = YGNodeGetChildCount(root_);
+    const YGNodeRef row = YGNodeGetChild(root_, iteration * 37 % rowCount);
+    YGNodeStyleSetWidth(
+        YGNodeGetChild(row, 0), iteration / rowCount % 2 == 0 ? 48 : 40);
+  }
+};
+
+// Inserts a story into the news feed, in a different place every time. The
+// story inserted by the previous iteration is removed first.
+class ChildInsertion : public IncrementalLayout {
+ public:
+  explicit ChildInsertion(YGConfigRef config)
+      : IncrementalLayout(createAndroidNewsFeed(config, 100)),
+        config_(config) {}
+
+  void setUp(uint32_t iteration) override {
+    if (inserted_ != nullptr) {
+      YGNodeRemoveChild(root_, inserted_);
+      YGNodeFreeRecursive(inserted_);
+      layout();
+    }
+    inserted_ = createNewsFeedContent(config_);
+    YGNodeInsertChild(
+        root_, inserted_, iteration * 37 % YGNodeGetChildCount(root_));
+  }
+
+ private:
+  const YGConfigRef config_;
+  YGNodeRef inserted_ = nullptr;
+};
+
+// Removes a story from the news feed, in a different place every time. The
+// story removed by the previous iteration is inserted back first.
+class ChildRemoval : public IncrementalLayout {
+ public:
+  explicit ChildRemoval(YGConfigRef config)
+      : IncrementalLayout(createAndroidNewsFeed(config, 100)) {}
+
+  ~ChildRemoval() override {
+    if (removed_ != nullptr) {
+      YGNodeFreeRecursive(removed_);
+    }
+  }
+
+  void setUp(uint32_t iteration) override {
+    if (removed_ != nullptr) {
+      YGNodeInsertChild(root_, removed_, removedIndex_);
+      layout();
+    }
+    removedIndex_ = iteration * 37 % YGNodeGetChildCount(root_);
+    removed_ = YGNodeGetChild(root_, removedIndex_);
+    YGNodeRemoveChild(root_, removed_);
+  }
+
+ private:
+  YGNodeRef removed_ = nullptr;
+  uint32_t removedIndex_ = 0;
+};
+
+// Moves the text tree by a fraction of a pixel, by alternating the padding of a
+// root wrapped around it. The text tree is not laid out again, but all of its
+// frames are rounded to the pixel grid again.
+class SubpixelMove : public IncrementalLayout {
+ public:
+  explicit SubpixelMove(YGConfigRef config)
+      : IncrementalLayout(createWrappedTextTree(config)) {}
+
+  void setUp(uint32_t iteration) override {
+    YGNodeStyleSetPadding(root_, YGEdgeTop, iteration % 2 == 0 ? 0.3f : 0.55f);
+  }
+
+ private:
+  static YGNodeRef createWrappedTextTree(YGConfigRef config) {
+    YGConfigSetPointScaleFactor(config, 3);
+    const YGNodeRef root = YGNodeNewWithConfig(config);
+    YGNodeInsertChild(root, createTextTree(config), 0);
+    return root;
+  }
+};
+
+template <typename Scenario>
+YGBenchmarkFactory incremental() {
+  return [](YGConfigRef config) {
+    return std::unique_ptr<YGBenchmarkScenario>(new Scenario(config));
+  };
+}
+
+} // namespace
+
+void YGRegisterLayoutBenchmarks() {
+  YGRegisterColdLayoutBenchmark("stack_with_flex", createStackWithFlex);
+  YGRegisterColdLayoutBenchmark(
+      "align_stretch_in_undefined_axis", createAlignStretchInUndefinedAxis);
+  YGRegisterColdLayoutBenchmark("nested_flex", createNestedFlex);
+  // The width of the root alternates, so the whole tree is laid out again
+  // every time.
+  YGRegisterBenchmark("wrapping_rows_of_columns", [](YGConfigRef config) {
+    return std::unique_ptr<YGBenchmarkScenario>(
+        new RootResize(createWrappingRowsOfColumns(config), {1000, 1001}));
+  });
+  YGRegisterColdLayoutBenchmark("huge_nested_layout", createHugeNestedLayout);
+  YGRegisterColdLayoutBenchmark("android_news_feed", [](YGConfigRef config) {
+    return createAndroidNewsFeed(config, 1);
+  });
+  YGRegisterColdLayoutBenchmark(
+      "android_news_feed_x100",
+      [](YGConfigRef config) { return createAndroidNewsFeed(config, 100); });
+  YGRegisterColdLayoutBenchmark("deep_chain_500", createDeepChain);
+  YGRegisterColdLayoutBenchmark("flex_wrap_10k", createFlexWrap);
+  YGRegisterColdLayoutBenchmark("text_tree", createTextTree);
+  YGRegisterColdLayoutBenchmark("percentage_tree", createPercentageTree);
+
+  YGRegisterBenchmark("incremental_style_change", incremental<StyleChange>());
+  YGRegisterBenchmark("incremental_insert", incremental<ChildInsertion>());
+  YGRegisterBenchmark("incremental_remove", incremental<ChildRemoval>());
+  YGRegisterBenchmark("incremental_root_resize", [](YGConfigRef config) {
+    return std::unique_ptr<YGBenchmarkScenario>(
+        new RootResize(createTextTree(config), {1080, 1000, 720}));
+  });
+  YGRegisterBenchmark("incremental_subpixel_move", incremental<SubpixelMove>());
+}
@@ -0,0 +1,16 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+namespace Facebook.Yoga
+{
+    [System.Flags]
+    public enum YogaSnapshotOptions
+    {
+        Layout = 1,
+        LayoutCache = 2,
+    }
+}
@@ -104,6 +104,15 @@ ENUMS = {
         ('Style', 2),
         ('Children', 4),
     ],
+    'LayoutChange': [
+        ('Position', 1),
+        ('Size', 2),
+    ],
+    'SnapshotOptions': [
+        ('Layout', 1),
+        # Implies Layout.
+        ('LayoutCache', 2),
+    ],
 }
 
 LICENSE = """/**
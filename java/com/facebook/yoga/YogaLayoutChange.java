@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+package com.facebook.yoga;
+
+import com.facebook.proguard.annotations.DoNotStrip;
+
+@DoNotStrip
+public enum YogaLayoutChange {
+  POSITION(1),
+  SIZE(2);
+
+  private final int mIntValue;
+
+  YogaLayoutChange(int intValue) {
+    mIntValue = intValue;
+  }
+
+  public int intValue() {
+    return mIntValue;
+  }
+
+  public static YogaLayoutChange fromInt(int value) {
+    switch (value) {
+      case 1: return POSITION;
+      case 2: return SIZE;
+      default: throw new IllegalArgumentException("Unknown enum value: " + value);
+    }
+  }
+}
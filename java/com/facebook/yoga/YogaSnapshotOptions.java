@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+package com.facebook.yoga;
+
+import com.facebook.proguard.annotations.DoNotStrip;
+
+@DoNotStrip
+public enum YogaSnapshotOptions {
+  LAYOUT(1),
+  LAYOUT_CACHE(2);
+
+  private final int mIntValue;
+
+  YogaSnapshotOptions(int intValue) {
+    mIntValue = intValue;
+  }
+
+  public int intValue() {
+    return mIntValue;
+  }
+
+  public static YogaSnapshotOptions fromInt(int value) {
+    switch (value) {
+      case 1: return LAYOUT;
+      case 2: return LAYOUT_CACHE;
+      default: throw new IllegalArgumentException("Unknown enum value: " + value);
+    }
+  }
+}
@@ -60,6 +60,10 @@ const CONSTANTS = {
   JUSTIFY_SPACE_AROUND: 4,
   JUSTIFY_SPACE_EVENLY: 5,
 
+  LAYOUT_CHANGE_COUNT: 2,
+  LAYOUT_CHANGE_POSITION: 1,
+  LAYOUT_CHANGE_SIZE: 2,
+
   LOG_LEVEL_COUNT: 6,
   LOG_LEVEL_ERROR: 0,
   LOG_LEVEL_WARN: 1,
@@ -91,6 +95,10 @@ const CONSTANTS = {
   PRINT_OPTIONS_STYLE: 2,
   PRINT_OPTIONS_CHILDREN: 4,
 
+  SNAPSHOT_OPTIONS_COUNT: 2,
+  SNAPSHOT_OPTIONS_LAYOUT: 1,
+  SNAPSHOT_OPTIONS_LAYOUT_CACHE: 2,
+
   UNIT_COUNT: 4,
   UNIT_UNDEFINED: 0,
   UNIT_POINT: 1,
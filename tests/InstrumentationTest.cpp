@@ -197,6 +197,50 @@ TEST_F(MarkerTest, layout_marker_has_max_measure_cache) {
       (YGMarkerLayoutData{.layouts = 3, .measures = 3, .maxMeasureCache = 7}));
 }
 
+TEST_F(MarkerTest, layout_marker_counts_measure_cache_misses_and_evictions) {
+  YGConfigSetMeasureCacheCapacity(config.get(), 1, 1);
+  auto root = makeNode();
+  auto a = addChild(root);
+  auto b = addChild(root);
+  YGNodeStyleSetFlexBasis(a.get(), 10.0f);
+
+  for (auto s : {20, 30, 40}) {
+    calculateLayout(root, s, s);
+  }
+
+  auto& markerCookie = findLastMarker(YGMarkerLayout);
+
+  ASSERT_EQ(markerCookie.end.markerData.layout.measureCacheMisses, 3);
+  ASSERT_EQ(markerCookie.end.markerData.layout.measureCacheEvictions, 3);
+}
+
+TEST_F(MarkerTest, layout_batch_uses_single_marker) {
+  auto rootA = makeNode();
+  auto rootB = makeNode();
+  auto childA = addChild(rootB);
+  auto childB = addChild(rootB);
+  const YGNodeRef roots[] = {rootA.get(), rootB.get()};
+  const YGLayoutConstraints constraints[] = {
+      {YGUndefined, YGUndefined, YGDirectionLTR},
+      {YGUndefined, YGUndefined, YGDirectionLTR}};
+  YGMarkerLayoutData layoutData[2];
+
+  YGNodeCalculateLayoutBatch(roots, constraints, 2, layoutData);
+
+  ASSERT_EQ(1u, markerCookies.size());
+  auto& markerCookie = findLastMarker(YGMarkerLayout);
+  ASSERT_EQ(markerCookie.start.node, rootA.get());
+  ASSERT_EQ(
+      markerCookie.end.markerData.layout,
+      (YGMarkerLayoutData{.layouts = 4, .measures = 4, .maxMeasureCache = 3}));
+  ASSERT_EQ(
+      layoutData[0],
+      (YGMarkerLayoutData{.layouts = 1, .measures = 0, .maxMeasureCache = 1}));
+  ASSERT_EQ(
+      layoutData[1],
+      (YGMarkerLayoutData{.layouts = 3, .measures = 4, .maxMeasureCache = 3}));
+}
+
 TEST_F(MarkerTest, measure_functions_get_wrapped) {
   auto root = makeNode();
   YGNodeSetMeasureFunc(
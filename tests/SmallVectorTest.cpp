@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <yoga/SmallVector.h>
+#include <gtest/gtest.h>
+#include <utility>
+
+using facebook::yoga::detail::SmallVector;
+
+using IntVector = SmallVector<int, 2>;
+
+static void expectElements(const IntVector& v, std::initializer_list<int> e) {
+  ASSERT_EQ(e.size(), v.size());
+  size_t i = 0;
+  for (int value : e) {
+    ASSERT_EQ(value, v[i++]);
+  }
+}
+
+TEST(YogaTest, small_vector_stays_inline_up_to_capacity) {
+  IntVector v;
+  v.push_back(1);
+  v.push_back(2);
+  ASSERT_EQ(2u, v.capacity());
+  expectElements(v, {1, 2});
+}
+
+TEST(YogaTest, small_vector_grows_to_heap) {
+  IntVector v;
+  for (int i = 0; i < 9; i++) {
+    v.push_back(i);
+  }
+  ASSERT_GE(v.capacity(), 9u);
+  expectElements(v, {0, 1, 2, 3, 4, 5, 6, 7, 8});
+
+  v.clear();
+  v.push_back(7);
+  v.shrink_to_fit();
+  ASSERT_EQ(2u, v.capacity());
+  expectElements(v, {7});
+}
+
+TEST(YogaTest, small_vector_insert_and_erase) {
+  IntVector v = {1, 3};
+  v.insert(v.begin() + 1, 2);
+  v.insert(v.begin(), 0);
+  v.insert(v.end(), v[0]);
+  expectElements(v, {0, 1, 2, 3, 0});
+
+  v.erase(v.begin());
+  v.erase(v.begin() + 2);
+  expectElements(v, {1, 2, 0});
+  ASSERT_THROW(v.at(3), std::out_of_range);
+}
+
+TEST(YogaTest, small_vector_copy_and_move) {
+  IntVector inlineValues = {1};
+  IntVector heapValues = {1, 2, 3};
+
+  IntVector copy = heapValues;
+  expectElements(copy, {1, 2, 3});
+  copy = inlineValues;
+  expectElements(copy, {1});
+
+  IntVector moved = std::move(heapValues);
+  expectElements(moved, {1, 2, 3});
+  ASSERT_TRUE(heapValues.empty());
+
+  moved = std::move(inlineValues);
+  expectElements(moved, {1});
+  ASSERT_TRUE(inlineValues.empty());
+}
@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+#include <cmath>
+
+static int measureCalls = 0;
+static int batchCalls = 0;
+static int batchedRequests = 0;
+
+static YGSize _measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const float textWidth = 7.0f * *static_cast<int*>(YGNodeGetContext(node));
+  float measuredWidth = textWidth;
+  if (widthMode == YGMeasureModeExactly) {
+    measuredWidth = width;
+  } else if (widthMode == YGMeasureModeAtMost) {
+    measuredWidth = fminf(textWidth, width);
+  }
+  const float lines =
+      measuredWidth > 0 ? ceilf(textWidth / measuredWidth) : 1.0f;
+  float measuredHeight = 16.0f * lines;
+  if (heightMode == YGMeasureModeExactly) {
+    measuredHeight = height;
+  } else if (heightMode == YGMeasureModeAtMost) {
+    measuredHeight = fminf(measuredHeight, height);
+  }
+  return YGSize{measuredWidth, measuredHeight};
+}
+
+static YGSize _countingMeasure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  measureCalls++;
+  return _measureText(node, width, widthMode, height, heightMode);
+}
+
+static void _batchMeasure(
+    YGMeasureRequest* requests,
+    uint32_t count,
+    void* layoutContext) {
+  batchCalls++;
+  batchedRequests += count;
+  for (uint32_t i = 0; i < count; i++) {
+    requests[i].size = _measureText(
+        requests[i].node,
+        requests[i].width,
+        requests[i].widthMode,
+        requests[i].height,
+        requests[i].heightMode);
+  }
+}
+
+static int textLengths[] = {3, 40, 12, 25, 8, 60};
+
+static YGNodeRef createRows(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 200);
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef row = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetPadding(row, YGEdgeAll, 3);
+    if (i == 1) {
+      YGNodeStyleSetFlexWrap(row, YGWrapWrap);
+    }
+    if (i == 2) {
+      YGNodeStyleSetAlignItems(row, YGAlignFlexStart);
+    }
+    for (uint32_t j = 0; j < 6; j++) {
+      const YGNodeRef text = YGNodeNewWithConfig(config);
+      YGNodeSetContext(text, &textLengths[j]);
+      YGNodeSetMeasureFunc(text, _countingMeasure);
+      YGNodeStyleSetFlexShrink(text, 1);
+      YGNodeStyleSetFlexGrow(text, j % 2);
+      YGNodeStyleSetMargin(text, YGEdgeRight, 2);
+      YGNodeInsertChild(row, text, j);
+    }
+    YGNodeInsertChild(root, row, i);
+  }
+  return root;
+}
+
+TEST(YogaTest, batch_measure_matches_measure_func) {
+  const YGConfigRef config = YGConfigNew();
+  const YGConfigRef batchConfig = YGConfigNew();
+  YGConfigSetBatchMeasureFunc(batchConfig, _batchMeasure);
+
+  const YGNodeRef expected = createRows(config);
+  const YGNodeRef root = createRows(batchConfig);
+
+  for (float width : {200.0f, 120.0f, 333.5f}) {
+    YGNodeStyleSetWidth(expected, width);
+    YGNodeStyleSetWidth(root, width);
+    YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    measureCalls = 0;
+    batchCalls = 0;
+    batchedRequests = 0;
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    ASSERT_TRUE(root->isLayoutTreeEqualToNode(*expected));
+    ASSERT_GT(batchCalls, 0);
+    ASSERT_EQ(0, measureCalls);
+  }
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+  YGConfigFree(batchConfig);
+}
+
+TEST(YogaTest, batch_measure_skips_cached_measurements) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetBatchMeasureFunc(config, _batchMeasure);
+  const YGNodeRef root = createRows(config);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  measureCalls = 0;
+  batchedRequests = 0;
+  YGNodeMarkDirty(YGNodeGetChild(YGNodeGetChild(root, 0), 1));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(0, measureCalls);
+  ASSERT_GT(batchedRequests, 0);
+  ASSERT_LT(batchedRequests, 6);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+#include <thread>
+#include <vector>
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{
+      .width = widthMode == YGMeasureModeExactly ? width : 25,
+      .height = heightMode == YGMeasureModeExactly ? height : 12.5f,
+  };
+}
+
+static YGNodeRef createTree(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  YGNodeStyleSetWidth(root, 333);
+
+  for (uint32_t i = 0; i < 50; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(child, 1);
+    YGNodeStyleSetPadding(child, YGEdgeAll, 3);
+    YGNodeInsertChild(root, child, i);
+
+    for (uint32_t j = 0; j < 3; j++) {
+      const YGNodeRef leaf = YGNodeNewWithConfig(config);
+      YGNodeSetMeasureFunc(leaf, _measure);
+      YGNodeStyleSetFlexShrink(leaf, 1);
+      YGNodeInsertChild(child, leaf, j);
+    }
+  }
+
+  return root;
+}
+
+static void layoutRepeatedly(const YGNodeRef root) {
+  for (int i = 0; i < 20; i++) {
+    YGNodeStyleSetWidth(root, i % 2 == 0 ? 200 : 333);
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  }
+}
+
+static void expectSameLayout(const YGNodeRef a, const YGNodeRef b) {
+  ASSERT_EQ(YGNodeLayoutGetLeft(a), YGNodeLayoutGetLeft(b));
+  ASSERT_EQ(YGNodeLayoutGetTop(a), YGNodeLayoutGetTop(b));
+  ASSERT_EQ(YGNodeLayoutGetWidth(a), YGNodeLayoutGetWidth(b));
+  ASSERT_EQ(YGNodeLayoutGetHeight(a), YGNodeLayoutGetHeight(b));
+  ASSERT_EQ(YGNodeGetChildCount(a), YGNodeGetChildCount(b));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(a); i++) {
+    expectSameLayout(YGNodeGetChild(a, i), YGNodeGetChild(b, i));
+  }
+}
+
+TEST(YogaTest, concurrent_layout_of_disjoint_trees) {
+  const YGConfigRef config = YGConfigNew();
+
+  const YGNodeRef reference = createTree(config);
+  layoutRepeatedly(reference);
+
+  std::vector<YGNodeRef> roots;
+  for (int i = 0; i < 8; i++) {
+    roots.push_back(createTree(config));
+  }
+
+  std::vector<std::thread> threads;
+  for (const YGNodeRef root : roots) {
+    threads.emplace_back(layoutRepeatedly, root);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const YGNodeRef root : roots) {
+    expectSameLayout(reference, root);
+    YGNodeFreeRecursive(root);
+  }
+
+  YGNodeFreeRecursive(reference);
+  YGConfigFree(config);
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static std::atomic<int> executorCalls{0};
+
+static void _threadExecutor(
+    YGConfigRef config,
+    YGLayoutTaskFunc runTask,
+    void* tasks,
+    uint32_t taskCount) {
+  executorCalls++;
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < taskCount; i++) {
+    threads.emplace_back([=]() { runTask(tasks, i); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+static YGNodeRef createCell(const YGConfigRef config, uint32_t index) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 4);
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(child, i + 1);
+    YGNodeStyleSetHeight(child, 10 + index % 7);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+static void testBatchMatchesSingleLayouts(const YGConfigRef config) {
+  const uint32_t count = 16;
+  std::vector<YGNodeRef> roots;
+  std::vector<YGNodeRef> expected;
+  std::vector<YGLayoutConstraints> constraints;
+  for (uint32_t i = 0; i < count; i++) {
+    roots.push_back(createCell(config, i));
+    expected.push_back(createCell(config, i));
+    constraints.push_back({100.0f + i * 3.5f, YGUndefined, YGDirectionRTL});
+    YGNodeCalculateLayout(
+        expected[i],
+        constraints[i].ownerWidth,
+        constraints[i].ownerHeight,
+        constraints[i].ownerDirection);
+  }
+
+  std::vector<YGMarkerLayoutData> layoutData(count);
+  YGNodeCalculateLayoutBatch(
+      roots.data(), constraints.data(), count, layoutData.data());
+
+  for (uint32_t i = 0; i < count; i++) {
+    ASSERT_TRUE(roots[i]->isLayoutTreeEqualToNode(*expected[i]));
+    ASSERT_EQ(4, layoutData[i].layouts);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    YGNodeFreeRecursive(roots[i]);
+    YGNodeFreeRecursive(expected[i]);
+  }
+}
+
+TEST(YogaTest, layout_batch_matches_single_layouts) {
+  const YGConfigRef config = YGConfigNew();
+  testBatchMatchesSingleLayouts(config);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_batch_distributes_roots_to_executor) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutExecutor(config, _threadExecutor);
+  executorCalls = 0;
+
+  testBatchMatchesSingleLayouts(config);
+  ASSERT_EQ(1, executorCalls);
+
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_batch_of_nothing) {
+  YGNodeCalculateLayoutBatch(nullptr, nullptr, 0, nullptr);
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/Yoga-internal.h>
+#include <yoga/Yoga.h>
+#include <map>
+
+using Changes = std::map<YGNodeRef, int>;
+
+static void recordChange(
+    YGNodeRef node,
+    YGLayoutChange changes,
+    void* layoutContext) {
+  auto& recorded = *static_cast<Changes*>(layoutContext);
+  ASSERT_EQ(0u, recorded.count(node));
+  recorded[node] = changes;
+}
+
+static Changes calculateLayout(const YGNodeRef root) {
+  Changes changes;
+  YGNodeCalculateLayoutWithContext(
+      root, YGUndefined, YGUndefined, YGDirectionLTR, &changes);
+  return changes;
+}
+
+static void testLayoutChanges(const float pointScaleFactor) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, pointScaleFactor);
+  YGConfigSetLayoutChangedFunc(config, recordChange);
+
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  const YGNodeRef root_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(root_child0, 10);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  const YGNodeRef root_child1 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(root_child1, 10);
+  YGNodeInsertChild(root, root_child1, 1);
+
+  const YGNodeRef root_child1_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root_child1_child0, 5);
+  YGNodeInsertChild(root_child1, root_child1_child0, 0);
+
+  const int all = YGLayoutChangePosition | YGLayoutChangeSize;
+  ASSERT_EQ(
+      (Changes{{root, all},
+               {root_child0, all},
+               {root_child1, all},
+               {root_child1_child0, all}}),
+      calculateLayout(root));
+
+  ASSERT_EQ(Changes{}, calculateLayout(root));
+
+  YGNodeStyleSetHeight(root_child0, 20);
+  ASSERT_EQ(
+      (Changes{{root_child0, YGLayoutChangeSize},
+               {root_child1, YGLayoutChangePosition}}),
+      calculateLayout(root));
+
+  YGNodeStyleSetDisplay(root_child1, YGDisplayNone);
+  ASSERT_EQ(
+      (Changes{{root_child1, all}, {root_child1_child0, YGLayoutChangeSize}}),
+      calculateLayout(root));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_changed_func_reports_changed_frames) {
+  testLayoutChanges(1.0f);
+}
+
+TEST(YogaTest, layout_changed_func_reports_changed_frames_without_rounding) {
+  testLayoutChanges(0.0f);
+}
@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGMarker.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static std::atomic<int> executorCalls{0};
+static std::atomic<int> executedTasks{0};
+
+static void _threadExecutor(
+    YGConfigRef config,
+    YGLayoutTaskFunc runTask,
+    void* tasks,
+    uint32_t taskCount) {
+  executorCalls++;
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < taskCount; i++) {
+    threads.emplace_back([=]() {
+      runTask(tasks, i);
+      executedTasks++;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{
+      .width = widthMode == YGMeasureModeExactly ? width : 40,
+      .height = heightMode == YGMeasureModeExactly ? height : 17,
+  };
+}
+
+static YGNodeRef createCard(const YGConfigRef config, uint32_t leafCount) {
+  const YGNodeRef card = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPadding(card, YGEdgeAll, 7);
+  YGNodeStyleSetFlexDirection(card, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(card, YGWrapWrap);
+  for (uint32_t i = 0; i < leafCount; i++) {
+    const YGNodeRef leaf = YGNodeNewWithConfig(config);
+    YGNodeSetMeasureFunc(leaf, _measure);
+    YGNodeStyleSetFlexGrow(leaf, i % 3);
+    YGNodeStyleSetMargin(leaf, YGEdgeAll, 1.5);
+    YGNodeInsertChild(card, leaf, i);
+  }
+  return card;
+}
+
+static YGNodeRef createFeed(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 360);
+
+  // Stretched cards are laid out from STEP 7.
+  for (uint32_t i = 0; i < 6; i++) {
+    YGNodeInsertChild(root, createCard(config, 40), i);
+  }
+
+  // Flexible cards with a definite cross size are laid out from the second
+  // pass of distributing free space.
+  const YGNodeRef row = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+  YGNodeStyleSetHeight(row, 500);
+  YGNodeStyleSetAlignItems(row, YGAlignFlexStart);
+  for (uint32_t i = 0; i < 4; i++) {
+    const YGNodeRef card = createCard(config, 40);
+    YGNodeStyleSetFlexGrow(card, 1);
+    YGNodeStyleSetHeight(card, 300);
+    YGNodeInsertChild(row, card, i);
+  }
+  YGNodeInsertChild(root, row, 6);
+
+  // A small card stays on the calling thread.
+  YGNodeInsertChild(root, createCard(config, 2), 7);
+
+  return root;
+}
+
+static void expectSameLayout(const YGNodeRef a, const YGNodeRef b) {
+  ASSERT_EQ(YGNodeLayoutGetLeft(a), YGNodeLayoutGetLeft(b));
+  ASSERT_EQ(YGNodeLayoutGetTop(a), YGNodeLayoutGetTop(b));
+  ASSERT_EQ(YGNodeLayoutGetWidth(a), YGNodeLayoutGetWidth(b));
+  ASSERT_EQ(YGNodeLayoutGetHeight(a), YGNodeLayoutGetHeight(b));
+  ASSERT_EQ(YGNodeLayoutGetHadOverflow(a), YGNodeLayoutGetHadOverflow(b));
+  ASSERT_EQ(YGNodeGetChildCount(a), YGNodeGetChildCount(b));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(a); i++) {
+    expectSameLayout(YGNodeGetChild(a, i), YGNodeGetChild(b, i));
+  }
+}
+
+static YGMarkerLayoutData lastLayoutData;
+
+static void* _startMarker(YGMarker, YGNodeRef, YGMarkerData) {
+  return nullptr;
+}
+
+static void _endMarker(YGMarker marker, YGNodeRef, YGMarkerData data, void*) {
+  if (marker == YGMarkerLayout) {
+    lastLayoutData = *data.layout;
+  }
+}
+
+TEST(YogaTest, layout_executor_matches_serial_layout) {
+  const YGConfigRef serialConfig = YGConfigNew();
+  YGConfigSetMarkerCallbacks(serialConfig, {_startMarker, _endMarker});
+  const YGConfigRef parallelConfig = YGConfigNew();
+  YGConfigSetMarkerCallbacks(parallelConfig, {_startMarker, _endMarker});
+  YGConfigSetLayoutExecutor(parallelConfig, _threadExecutor);
+  YGConfigSetLayoutExecutorMinSubtreeSize(parallelConfig, 10);
+
+  const YGNodeRef serialRoot = createFeed(serialConfig);
+  const YGNodeRef parallelRoot = createFeed(parallelConfig);
+
+  executorCalls = 0;
+  executedTasks = 0;
+  YGNodeCalculateLayout(serialRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  const YGMarkerLayoutData serialData = lastLayoutData;
+  ASSERT_EQ(0, executorCalls);
+
+  YGNodeCalculateLayout(
+      parallelRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  const YGMarkerLayoutData parallelData = lastLayoutData;
+  ASSERT_LT(0, executorCalls);
+  ASSERT_LE(10, executedTasks);
+
+  expectSameLayout(serialRoot, parallelRoot);
+  ASSERT_EQ(serialData.layouts, parallelData.layouts);
+  ASSERT_EQ(serialData.measures, parallelData.measures);
+  ASSERT_EQ(serialData.maxMeasureCache, parallelData.maxMeasureCache);
+  ASSERT_EQ(serialData.cachedLayouts, parallelData.cachedLayouts);
+  ASSERT_EQ(serialData.cachedMeasures, parallelData.cachedMeasures);
+
+  // Nothing needs to be laid out again, so nothing is handed out.
+  executorCalls = 0;
+  YGNodeCalculateLayout(
+      parallelRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, executorCalls);
+
+  YGNodeStyleSetWidth(serialRoot, 250);
+  YGNodeStyleSetWidth(parallelRoot, 250);
+  YGNodeCalculateLayout(serialRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(
+      parallelRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  expectSameLayout(serialRoot, parallelRoot);
+
+  YGNodeFreeRecursive(serialRoot);
+  YGNodeFreeRecursive(parallelRoot);
+  YGConfigFree(serialConfig);
+  YGConfigFree(parallelConfig);
+}
+
+TEST(YogaTest, layout_executor_not_used_below_min_subtree_size) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutExecutor(config, _threadExecutor);
+  YGConfigSetLayoutExecutorMinSubtreeSize(config, 1000);
+
+  const YGNodeRef root = createFeed(config);
+  executorCalls = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, executorCalls);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
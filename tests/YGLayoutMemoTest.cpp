@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGConfig.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+static int measureCalls = 0;
+
+// Text whose length is given by the content key, wrapped to the given width.
+static YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  measureCalls++;
+  const float textWidth = 7.5f * YGNodeGetMeasureContentKey(node);
+  if (widthMode == YGMeasureModeUndefined || textWidth <= width) {
+    return YGSize{textWidth, 12};
+  }
+  return YGSize{width, 12 * std::ceil(textWidth / width)};
+}
+
+static YGNodeRef createText(const YGConfigRef config, const uint64_t length) {
+  const YGNodeRef text = YGNodeNewWithConfig(config);
+  YGNodeSetMeasureFunc(text, measureText);
+  YGNodeSetMeasureContentKey(text, length);
+  return text;
+}
+
+static YGNodeRef createCell(const YGConfigRef config, const uint64_t variant) {
+  const YGNodeRef cell = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(cell, YGFlexDirectionRow);
+  YGNodeStyleSetPaddingPercent(cell, YGEdgeHorizontal, 2);
+  YGNodeStyleSetPadding(cell, YGEdgeVertical, 5);
+
+  const YGNodeRef image = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(image, 40);
+  YGNodeStyleSetHeight(image, 40);
+  YGNodeStyleSetMargin(image, YGEdgeEnd, 8);
+  YGNodeInsertChild(cell, image, 0);
+
+  const YGNodeRef body = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexGrow(body, 1);
+  YGNodeStyleSetFlexShrink(body, 1);
+  YGNodeInsertChild(body, createText(config, 10 + variant), 0);
+  YGNodeInsertChild(body, createText(config, 20 + 15 * variant), 1);
+  YGNodeInsertChild(cell, body, 1);
+  return cell;
+}
+
+static YGNodeRef createFeed(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 4);
+  for (uint32_t i = 0; i < 30; i++) {
+    YGNodeInsertChild(root, createCell(config, i % 3), i);
+  }
+  return root;
+}
+
+static void expectSameLayout(const YGNodeRef expected, const YGNodeRef actual) {
+  ASSERT_EQ(YGNodeLayoutGetLeft(expected), YGNodeLayoutGetLeft(actual));
+  ASSERT_EQ(YGNodeLayoutGetTop(expected), YGNodeLayoutGetTop(actual));
+  ASSERT_EQ(YGNodeLayoutGetRight(expected), YGNodeLayoutGetRight(actual));
+  ASSERT_EQ(YGNodeLayoutGetBottom(expected), YGNodeLayoutGetBottom(actual));
+  ASSERT_EQ(YGNodeLayoutGetWidth(expected), YGNodeLayoutGetWidth(actual));
+  ASSERT_EQ(YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+  ASSERT_EQ(
+      YGNodeLayoutGetDirection(expected), YGNodeLayoutGetDirection(actual));
+  ASSERT_EQ(
+      YGNodeLayoutGetPadding(expected, YGEdgeLeft),
+      YGNodeLayoutGetPadding(actual, YGEdgeLeft));
+  ASSERT_EQ(
+      YGNodeLayoutGetMargin(expected, YGEdgeRight),
+      YGNodeLayoutGetMargin(actual, YGEdgeRight));
+  ASSERT_FALSE(YGNodeIsDirty(actual));
+  ASSERT_EQ(YGNodeGetChildCount(expected), YGNodeGetChildCount(actual));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(actual); i++) {
+    expectSameLayout(YGNodeGetChild(expected, i), YGNodeGetChild(actual, i));
+  }
+}
+
+TEST(YogaTest, layout_memo_matches_full_layout) {
+  const YGConfigRef config = YGConfigNew();
+  const YGConfigRef memoConfig = YGConfigNew();
+  YGConfigSetLayoutMemoCapacity(memoConfig, 64);
+
+  for (const auto direction : {YGDirectionLTR, YGDirectionRTL}) {
+    for (const float width : {320.0f, 215.5f, YGUndefined}) {
+      const YGNodeRef expected = createFeed(config);
+      const YGNodeRef actual = createFeed(memoConfig);
+
+      measureCalls = 0;
+      YGNodeCalculateLayout(expected, width, YGUndefined, direction);
+      const int fullMeasureCalls = measureCalls;
+      measureCalls = 0;
+      YGNodeCalculateLayout(actual, width, YGUndefined, direction);
+
+      expectSameLayout(expected, actual);
+      ASSERT_LT(measureCalls * 5, fullMeasureCalls);
+
+      YGNodeFreeRecursive(expected);
+      YGNodeFreeRecursive(actual);
+    }
+  }
+  ASSERT_GT(memoConfig->layoutMemo->size(), 0u);
+
+  YGConfigFree(config);
+  YGConfigFree(memoConfig);
+}
+
+TEST(YogaTest, layout_memo_tracks_changes_to_subtrees) {
+  const YGConfigRef config = YGConfigNew();
+  const YGConfigRef memoConfig = YGConfigNew();
+  YGConfigSetLayoutMemoCapacity(memoConfig, 64);
+  const YGNodeRef expected = createFeed(config);
+  const YGNodeRef actual = createFeed(memoConfig);
+  YGNodeCalculateLayout(expected, 300, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(actual, 300, YGUndefined, YGDirectionLTR);
+
+  for (const YGNodeRef root : {expected, actual}) {
+    const YGNodeRef cell = YGNodeGetChild(root, 4);
+    YGNodeStyleSetWidth(YGNodeGetChild(cell, 0), 60);
+    const YGNodeRef text = YGNodeGetChild(YGNodeGetChild(root, 7), 1);
+    YGNodeSetMeasureContentKey(YGNodeGetChild(text, 0), 90);
+    YGNodeMarkDirty(YGNodeGetChild(text, 0));
+    YGNodeInsertChild(
+        YGNodeGetChild(YGNodeGetChild(root, 9), 1),
+        createText(root->getConfig(), 12),
+        2);
+  }
+  YGNodeCalculateLayout(expected, 300, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(actual, 300, YGUndefined, YGDirectionLTR);
+  expectSameLayout(expected, actual);
+
+  // A new feed reuses the memoized layouts of unchanged cells.
+  const YGNodeRef feed = createFeed(memoConfig);
+  measureCalls = 0;
+  YGNodeCalculateLayout(feed, 300, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, measureCalls);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(actual);
+  YGNodeFreeRecursive(feed);
+  YGConfigFree(config);
+  YGConfigFree(memoConfig);
+}
+
+TEST(YogaTest, layout_memo_skips_subtrees_measured_without_content_key) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutMemoCapacity(config, 64);
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef cell = YGNodeNewWithConfig(config);
+    YGNodeInsertChild(cell, createText(config, 0), 0);
+    YGNodeInsertChild(root, cell, i);
+  }
+
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0u, config->layoutMemo->size());
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -7,6 +7,8 @@
 #include <gtest/gtest.h>
 #include <yoga/YGNode.h>
 #include <yoga/Yoga.h>
+#include <thread>
+#include <vector>
 
 static YGSize _measureMax(
     YGNodeRef node,
@@ -179,3 +181,145 @@ TEST(
 
   ASSERT_EQ(1, measureCount);
 }
+
+TEST(YogaTest, measurement_cache_allocated_only_for_measured_nodes) {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  const YGNodeRef root_child0 = YGNodeNew();
+  YGNodeStyleSetWidth(root_child0, 100);
+  YGNodeStyleSetHeight(root_child0, 20);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  const YGNodeRef root_child1 = YGNodeNew();
+  int measureCount = 0;
+  root_child1->setContext(&measureCount);
+  root_child1->setMeasureFunc(_measureMax);
+  YGNodeInsertChild(root, root_child1, 1);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FALSE(root->getLayout().cachedMeasurements.isAllocated());
+  ASSERT_FALSE(root_child0->getLayout().cachedMeasurements.isAllocated());
+  ASSERT_TRUE(root_child1->getLayout().cachedMeasurements.isAllocated());
+  ASSERT_EQ(1, measureCount);
+
+  YGNodeFreeRecursive(root);
+}
+
+static const YGCachedMeasurement& _addMeasurement(
+    YGMeasurementCache& cache,
+    const YGMeasurementCache::Limits& limits,
+    float width,
+    bool* evicted) {
+  YGCachedMeasurement entry;
+  entry.availableWidth = width;
+  entry.availableHeight = YGUndefined;
+  entry.widthMeasureMode = YGMeasureModeAtMost;
+  entry.heightMeasureMode = YGMeasureModeUndefined;
+  entry.computedWidth = width;
+  entry.computedHeight = 10;
+  return cache.add(entry, limits, 1.0f, evicted);
+}
+
+static bool _hasMeasurement(const YGMeasurementCache& cache, float width) {
+  for (size_t i = 0; i < cache.size(); i++) {
+    if (cache[i].availableWidth == width) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TEST(YogaTest, measurement_cache_replaces_least_recently_used_entry) {
+  YGMeasurementCache cache;
+  const YGMeasurementCache::Limits limits = {3, 3};
+  bool evicted;
+  const YGCachedMeasurement& first =
+      _addMeasurement(cache, limits, 10, &evicted);
+  _addMeasurement(cache, limits, 20, &evicted);
+  _addMeasurement(cache, limits, 30, &evicted);
+  ASSERT_FALSE(evicted);
+
+  cache.markUsed(first);
+  _addMeasurement(cache, limits, 40, &evicted);
+
+  ASSERT_TRUE(evicted);
+  ASSERT_EQ(3u, cache.size());
+  ASSERT_TRUE(_hasMeasurement(cache, 10));
+  ASSERT_FALSE(_hasMeasurement(cache, 20));
+  ASSERT_TRUE(_hasMeasurement(cache, 30));
+  ASSERT_TRUE(_hasMeasurement(cache, 40));
+}
+
+TEST(YogaTest, measurement_cache_grows_after_replacing_all_entries) {
+  YGMeasurementCache cache;
+  const YGMeasurementCache::Limits limits = {2, 3};
+  bool evicted;
+  for (float width : {10, 20, 30, 40}) {
+    _addMeasurement(cache, limits, width, &evicted);
+  }
+  ASSERT_TRUE(evicted);
+  ASSERT_EQ(2u, cache.capacity());
+
+  _addMeasurement(cache, limits, 50, &evicted);
+  ASSERT_FALSE(evicted);
+  ASSERT_EQ(3u, cache.capacity());
+  ASSERT_TRUE(_hasMeasurement(cache, 30));
+  ASSERT_TRUE(_hasMeasurement(cache, 40));
+  ASSERT_TRUE(_hasMeasurement(cache, 50));
+
+  cache.clear();
+  ASSERT_EQ(0u, cache.size());
+  ASSERT_EQ(3u, cache.capacity());
+}
+
+TEST(YogaTest, measurement_cache_rounds_sizes_for_point_scale_factor) {
+  YGMeasurementCache cache;
+  bool evicted;
+  _addMeasurement(cache, {2, 2}, 10.3f, &evicted);
+  ASSERT_FLOAT_EQ(10.0f, cache.effectiveWidth(0));
+  ASSERT_TRUE(YGFloatIsUndefined(cache.effectiveHeight(0)));
+
+  cache.setPointScaleFactor(2.0f);
+  ASSERT_FLOAT_EQ(10.5f, cache.effectiveWidth(0));
+
+  cache.setPointScaleFactor(0.0f);
+  ASSERT_FLOAT_EQ(10.3f, cache.effectiveWidth(0));
+}
+
+TEST(YogaTest, measurement_caches_can_be_freed_on_other_threads) {
+  const YGMeasurementCache::Limits limits{YG_MAX_CACHED_RESULT_COUNT,
+                                          YG_MAX_CACHED_RESULT_COUNT};
+  bool evicted;
+  std::vector<YGMeasurementCache> caches(200);
+  // The thread allocating the caches exits while they are still in use.
+  std::thread([&] {
+    for (size_t i = 0; i < caches.size(); i++) {
+      _addMeasurement(caches[i], limits, i, &evicted);
+    }
+  }).join();
+
+  std::vector<YGMeasurementCache> copies(caches);
+  for (size_t i = 0; i < copies.size(); i++) {
+    ASSERT_TRUE(_hasMeasurement(copies[i], i));
+  }
+  caches.resize(100);
+  std::thread([&] {
+    caches.clear();
+    copies.resize(50);
+  }).join();
+
+  // Storage released by the other thread is used again.
+  std::vector<YGMeasurementCache> more(200);
+  for (size_t i = 0; i < more.size(); i++) {
+    _addMeasurement(more[i], limits, i, &evicted);
+  }
+  for (size_t i = 0; i < copies.size(); i++) {
+    ASSERT_TRUE(_hasMeasurement(copies[i], i));
+  }
+  for (size_t i = 0; i < more.size(); i++) {
+    ASSERT_TRUE(_hasMeasurement(more[i], i));
+  }
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGConfig.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+static int measureCalls = 0;
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  measureCalls++;
+  return YGSize{10, 10};
+}
+
+static YGNodeRef createList(const YGConfigRef config, uint64_t keys[], int n) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  for (int i = 0; i < n; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeSetMeasureFunc(child, _measure);
+    YGNodeSetMeasureContentKey(child, keys[i]);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+TEST(YogaTest, measure_memo_measures_identical_content_once) {
+  measureCalls = 0;
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMeasureMemoCapacity(config, 16);
+  uint64_t keys[] = {1, 1, 1, 2, 2};
+  const YGNodeRef root = createList(config, keys, 5);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(2, measureCalls);
+  for (uint32_t i = 0; i < 5; i++) {
+    ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(YGNodeGetChild(root, i)));
+  }
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetHeight(root));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, measure_memo_ignores_nodes_without_content_key) {
+  measureCalls = 0;
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMeasureMemoCapacity(config, 16);
+  uint64_t keys[] = {0, 0, 0};
+  const YGNodeRef root = createList(config, keys, 3);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(3, measureCalls);
+  ASSERT_EQ(0u, config->measureMemo->size());
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, measure_memo_is_shared_across_trees) {
+  measureCalls = 0;
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMeasureMemoCapacity(config, 16);
+  uint64_t keys[] = {7, 8};
+  const YGNodeRef first = createList(config, keys, 2);
+  const YGNodeRef second = createList(config, keys, 2);
+
+  YGNodeCalculateLayout(first, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(2, measureCalls);
+  YGNodeCalculateLayout(second, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(2, measureCalls);
+
+  YGNodeFreeRecursive(first);
+  YGNodeFreeRecursive(second);
+  YGConfigFree(config);
+}
+
+static YGMeasureMemo::Key _key(uint64_t contentKey, float width) {
+  return {contentKey,
+          width,
+          YGMeasureModeAtMost,
+          YGUndefined,
+          YGMeasureModeUndefined};
+}
+
+TEST(YogaTest, measure_memo_evicts_least_recently_used) {
+  YGMeasureMemo memo{2};
+  YGSize found;
+  memo.put(_key(1, 10), {1, 2});
+  memo.put(_key(2, 10), {1, 2});
+  ASSERT_TRUE(memo.get(_key(1, 10), &found));
+  memo.put(_key(3, 10), {1, 2});
+
+  ASSERT_EQ(2u, memo.size());
+  ASSERT_TRUE(memo.get(_key(1, 10), &found));
+  ASSERT_FLOAT_EQ(2, found.height);
+  ASSERT_FALSE(memo.get(_key(2, 10), &found));
+  ASSERT_FALSE(memo.get(_key(1, 20), &found));
+  ASSERT_TRUE(memo.get(_key(3, 10), &found));
+}
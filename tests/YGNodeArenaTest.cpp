@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+static YGNodeRef createTree(const YGConfigRef config, uint32_t childCount) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  for (uint32_t i = 0; i < childCount; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetHeight(child, 10);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+TEST(YogaTest, arena_nodes_lay_out_like_heap_nodes) {
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  const YGNodeArenaRef arena = YGNodeArenaNew();
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetNodeArena(config, arena);
+
+  const YGNodeRef root = createTree(config, 300);
+  ASSERT_TRUE(root->isArenaAllocated());
+  ASSERT_EQ(301, YGNodeGetInstanceCount() - instanceCount);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(3000, YGNodeLayoutGetHeight(root));
+  ASSERT_FLOAT_EQ(2990, YGNodeLayoutGetTop(YGNodeGetChild(root, 299)));
+
+  YGNodeFreeRecursive(root);
+  ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+
+  YGNodeArenaFree(arena);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, arena_free_releases_all_nodes) {
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  const YGNodeArenaRef arena = YGNodeArenaNew();
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetNodeArena(config, arena);
+
+  const YGNodeRef root = createTree(config, 500);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(501, YGNodeGetInstanceCount() - instanceCount);
+
+  YGNodeArenaFree(arena);
+  ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, arena_reset_allows_reuse) {
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  const YGNodeArenaRef arena = YGNodeArenaNew();
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetNodeArena(config, arena);
+
+  for (int i = 0; i < 3; i++) {
+    const YGNodeRef root = createTree(config, 200);
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    ASSERT_FLOAT_EQ(2000, YGNodeLayoutGetHeight(root));
+    YGNodeArenaReset(arena);
+    ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+  }
+
+  YGNodeArenaFree(arena);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, clone_of_arena_node) {
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  const YGNodeArenaRef arena = YGNodeArenaNew();
+  const YGConfigRef arenaConfig = YGConfigNew();
+  YGConfigSetNodeArena(arenaConfig, arena);
+  const YGConfigRef heapConfig = YGConfigNew();
+
+  const YGNodeRef arenaNode = YGNodeNewWithConfig(arenaConfig);
+  const YGNodeRef heapNode = YGNodeNewWithConfig(heapConfig);
+  ASSERT_TRUE(arenaNode->isArenaAllocated());
+  ASSERT_FALSE(heapNode->isArenaAllocated());
+
+  const YGNodeRef arenaClone = YGNodeClone(arenaNode);
+  ASSERT_TRUE(arenaClone->isArenaAllocated());
+
+  // Moving the original node to a heap config makes its clones heap nodes.
+  arenaNode->setConfig(heapConfig);
+  const YGNodeRef heapClone = YGNodeClone(arenaNode);
+  ASSERT_FALSE(heapClone->isArenaAllocated());
+
+  YGNodeFree(heapClone);
+  YGNodeFree(arenaClone);
+  YGNodeFree(arenaNode);
+  YGNodeFree(heapNode);
+  ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+
+  YGNodeArenaFree(arena);
+  YGConfigFree(arenaConfig);
+  YGConfigFree(heapConfig);
+}
+
+TEST(YogaTest, reset_keeps_arena_membership) {
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  const YGNodeArenaRef arena = YGNodeArenaNew();
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetNodeArena(config, arena);
+
+  const YGNodeRef node = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(node, 10);
+  YGNodeReset(node);
+  ASSERT_TRUE(node->isArenaAllocated());
+
+  YGNodeFree(node);
+  ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+  YGNodeArenaFree(arena);
+  YGConfigFree(config);
+}
@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <cstdint>
+
+static size_t offsetInNode(const YGNode& node, const void* field) {
+  return reinterpret_cast<uintptr_t>(field) -
+      reinterpret_cast<uintptr_t>(&node);
+}
+
+TEST(YGNode, hot_fields_share_first_cache_line) {
+  const YGNode node{};
+  ASSERT_LT(offsetInNode(node, &node.getChildren()), 64u);
+  ASSERT_LT(offsetInNode(node, &node.getChildren()) + sizeof(YGVector), 64u);
+}
+
+TEST(YGNode, layout_is_placed_before_style) {
+  const YGNode node{};
+  ASSERT_LT(
+      offsetInNode(node, &node.getLayout()),
+      offsetInNode(node, &node.getSharedStyle()));
+}
+
+TEST(YGNode, size_does_not_regress) {
+  if (sizeof(void*) == 8) {
+    ASSERT_LE(sizeof(YGNode), 344u);
+  }
+}
+
+TEST(YGNode, clone_keeps_rarely_used_callbacks) {
+  auto n = YGNode{};
+  n.setDirtiedFunc([](YGNode*) {});
+  n.setBaselineFunc([](YGNode*, float, float) { return 42.0f; });
+
+  auto clone = YGNode{n};
+  ASSERT_EQ(n.getDirtied(), clone.getDirtied());
+  ASSERT_TRUE(clone.hasBaselineFunc());
+  ASSERT_EQ(42.0f, clone.baseline(0, 0, nullptr));
+
+  n.setDirtiedFunc(nullptr);
+  ASSERT_EQ(nullptr, n.getDirtied());
+  ASSERT_NE(nullptr, clone.getDirtied());
+}
@@ -5,8 +5,9 @@
  * file in the root directory of this source tree.
  */
 #include <gtest/gtest.h>
-#include <yoga/Yoga.h>
+#include <yoga/YGNode.h>
 #include <yoga/Yoga-internal.h>
+#include <yoga/Yoga.h>
 
 TEST(YogaTest, rounding_value) {
   // Test that whole numbers are rounded to whole despite ceil/floor flags
@@ -79,3 +80,249 @@ TEST(YogaTest, consistent_rounding_during_repeated_layouts) {
 
   YGConfigFree(config);
 }
+
+static YGNodeRef createRoundingTree(const YGConfigRef config, float offset) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100.3);
+
+  const YGNodeRef spacer = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(spacer, offset);
+  YGNodeInsertChild(root, spacer, 0);
+
+  const YGNodeRef row = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+  YGNodeInsertChild(root, row, 1);
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef cell = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(cell, 1);
+    YGNodeStyleSetHeight(cell, 10.7);
+    YGNodeInsertChild(row, cell, i);
+  }
+
+  const YGNodeRef column = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPadding(column, YGEdgeAll, 0.55);
+  YGNodeInsertChild(root, column, 2);
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef cell = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(cell, 20.2);
+    YGNodeStyleSetHeight(cell, 10.7);
+    YGNodeInsertChild(column, cell, i);
+  }
+  return root;
+}
+
+static void assertSameFrames(const YGNodeRef expected, const YGNodeRef actual) {
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetLeft(expected), YGNodeLayoutGetLeft(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(expected), YGNodeLayoutGetTop(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetWidth(expected), YGNodeLayoutGetWidth(actual));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+  ASSERT_EQ(YGNodeGetChildCount(expected), YGNodeGetChildCount(actual));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(expected); i++) {
+    assertSameFrames(YGNodeGetChild(expected, i), YGNodeGetChild(actual, i));
+  }
+}
+
+TEST(YogaTest, rounding_moved_subtree_matches_fresh_layout) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, 3);
+
+  const YGNodeRef root = createRoundingTree(config, 1.2);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  for (float offset : {2.45f, 3.1f, 0.6f, 5.35f, 0.2f}) {
+    // Only the spacer is laid out again, the row is moved.
+    YGNodeStyleSetHeight(YGNodeGetChild(root, 0), offset);
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    const YGNodeRef expected = createRoundingTree(config, offset);
+    YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+    assertSameFrames(expected, root);
+    YGNodeFreeRecursive(expected);
+  }
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, rounding_skips_subtrees_that_did_not_change) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, 3);
+
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  const YGNodeRef changed = createRoundingTree(config, 1.2);
+  YGNodeInsertChild(root, changed, 0);
+  const YGNodeRef unchanged = createRoundingTree(config, 1.2);
+  YGNodeInsertChild(root, unchanged, 1);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Frames which are not rounded again keep values written behind the back of
+  // the rounding pass.
+  const YGNodeRef unchangedCell =
+      YGNodeGetChild(YGNodeGetChild(unchanged, 1), 1);
+  unchangedCell->getLayout().position[YGEdgeLeft] = -1;
+  const YGNodeRef changedCell = YGNodeGetChild(YGNodeGetChild(changed, 1), 1);
+  changedCell->getLayout().position[YGEdgeLeft] = -1;
+
+  YGNodeStyleSetHeight(YGNodeGetChild(changed, 0), 2.45);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(-1, YGNodeLayoutGetLeft(unchangedCell));
+  ASSERT_NE(-1, YGNodeLayoutGetLeft(changedCell));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+static YGSize measureFractionalText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return (YGSize){.width = 10.2, .height = 10.2};
+}
+
+TEST(YogaTest, rounding_mixed_text_and_box_siblings) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, 2);
+
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignItems(root, YGAlignFlexStart);
+  for (uint32_t i = 0; i < 6; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    if (i % 2 == 0) {
+      YGNodeSetMeasureFunc(child, measureFractionalText);
+      YGNodeSetNodeType(child, YGNodeTypeText);
+    } else {
+      YGNodeStyleSetWidth(child, 10.2);
+      YGNodeStyleSetHeight(child, 10.2);
+    }
+    YGNodeInsertChild(root, child, i);
+  }
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Text is never shrunk by rounding, so its positions are rounded down and
+  // its far edges up. Other values are rounded to the nearest pixel.
+  const float expectedTops[] = {0, 10, 20, 30.5, 40.5, 51};
+  const float expectedHeights[] = {10.5, 10.5, 11, 10.5, 10.5, 10};
+  for (uint32_t i = 0; i < 6; i++) {
+    const YGNodeRef child = YGNodeGetChild(root, i);
+    ASSERT_FLOAT_EQ(expectedTops[i], YGNodeLayoutGetTop(child));
+    ASSERT_FLOAT_EQ(expectedHeights[i], YGNodeLayoutGetHeight(child));
+    ASSERT_FLOAT_EQ(i % 2 == 0 ? 10.5 : 10, YGNodeLayoutGetWidth(child));
+  }
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+static YGNodeRef createFractionalTree(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  YGNodeStyleSetWidth(root, 301.7);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 0.35);
+  for (uint32_t i = 0; i < 23; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    if (i % 3 == 0) {
+      YGNodeSetMeasureFunc(child, measureFractionalText);
+      YGNodeSetNodeType(child, YGNodeTypeText);
+    } else {
+      YGNodeStyleSetWidth(child, 7.13 * i);
+      YGNodeStyleSetHeight(child, 3.3 + 0.61 * i);
+    }
+    YGNodeStyleSetMargin(child, YGEdgeLeft, i % 4 == 1 ? -4.3 : 0.17 * i);
+    YGNodeStyleSetMargin(child, YGEdgeTop, i % 5 == 2 ? -2.55 : 0);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+static uint32_t floatBits(const float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static bool hasFractionalSize(const float size, const float pointScaleFactor) {
+  const float fraction = fmodf(size * pointScaleFactor, 1.0);
+  return !YGFloatsEqual(fraction, 0) && !YGFloatsEqual(fraction, 1.0);
+}
+
+// Compares the rounded frames of rounded with rounding the frames of
+// unrounded one at a time.
+static void expectRoundedFrames(
+    const YGNodeRef unrounded,
+    const YGNodeRef rounded,
+    const float pointScaleFactor,
+    const float absoluteLeft,
+    const float absoluteTop) {
+  const bool text = YGNodeGetNodeType(unrounded) == YGNodeTypeText;
+  const float left = YGNodeLayoutGetLeft(unrounded);
+  const float top = YGNodeLayoutGetTop(unrounded);
+  const float width = YGNodeLayoutGetWidth(unrounded);
+  const float height = YGNodeLayoutGetHeight(unrounded);
+  const float absoluteNodeLeft = absoluteLeft + left;
+  const float absoluteNodeTop = absoluteTop + top;
+  const bool fractionalWidth = hasFractionalSize(width, pointScaleFactor);
+  const bool fractionalHeight = hasFractionalSize(height, pointScaleFactor);
+
+  EXPECT_EQ(
+      floatBits(YGRoundValueToPixelGrid(left, pointScaleFactor, false, text)),
+      floatBits(YGNodeLayoutGetLeft(rounded)));
+  EXPECT_EQ(
+      floatBits(YGRoundValueToPixelGrid(top, pointScaleFactor, false, text)),
+      floatBits(YGNodeLayoutGetTop(rounded)));
+  EXPECT_EQ(
+      floatBits(
+          YGRoundValueToPixelGrid(
+              absoluteNodeLeft + width,
+              pointScaleFactor,
+              text && fractionalWidth,
+              text && !fractionalWidth) -
+          YGRoundValueToPixelGrid(
+              absoluteNodeLeft, pointScaleFactor, false, text)),
+      floatBits(YGNodeLayoutGetWidth(rounded)));
+  EXPECT_EQ(
+      floatBits(
+          YGRoundValueToPixelGrid(
+              absoluteNodeTop + height,
+              pointScaleFactor,
+              text && fractionalHeight,
+              text && !fractionalHeight) -
+          YGRoundValueToPixelGrid(
+              absoluteNodeTop, pointScaleFactor, false, text)),
+      floatBits(YGNodeLayoutGetHeight(rounded)));
+
+  for (uint32_t i = 0; i < YGNodeGetChildCount(unrounded); i++) {
+    expectRoundedFrames(
+        YGNodeGetChild(unrounded, i),
+        YGNodeGetChild(rounded, i),
+        pointScaleFactor,
+        absoluteNodeLeft,
+        absoluteNodeTop);
+  }
+}
+
+TEST(YogaTest, rounding_many_frames_matches_rounding_each_value) {
+  const YGConfigRef unroundedConfig = YGConfigNew();
+  YGConfigSetPointScaleFactor(unroundedConfig, 0);
+  const YGNodeRef unrounded = createFractionalTree(unroundedConfig);
+  YGNodeCalculateLayout(unrounded, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  for (const float pointScaleFactor : {1.0f, 2.0f, 3.0f, 2.625f}) {
+    const YGConfigRef config = YGConfigNew();
+    YGConfigSetPointScaleFactor(config, pointScaleFactor);
+    const YGNodeRef rounded = createFractionalTree(config);
+    YGNodeCalculateLayout(rounded, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    expectRoundedFrames(unrounded, rounded, pointScaleFactor, 0, 0);
+
+    YGNodeFreeRecursive(rounded);
+    YGConfigFree(config);
+  }
+
+  YGNodeFreeRecursive(unrounded);
+  YGConfigFree(unroundedConfig);
+}
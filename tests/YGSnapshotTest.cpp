@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/YGNodeArena.h>
+#include <yoga/Yoga.h>
+#include <vector>
+
+static YGNodeRef createTree(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 10);
+  YGNodeStyleSetWidth(root, 200);
+
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef column = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(column, 1);
+    YGNodeStyleSetMargin(column, YGEdgeHorizontal, 5);
+    for (uint32_t j = 0; j < 2; j++) {
+      const YGNodeRef item = YGNodeNewWithConfig(config);
+      YGNodeStyleSetHeightPercent(item, 25);
+      YGNodeStyleSetMinHeight(item, 10);
+      YGNodeInsertChild(column, item, j);
+    }
+    YGNodeInsertChild(root, column, i);
+  }
+  const YGNodeRef text = YGNodeGetChild(YGNodeGetChild(root, 1), 1);
+  YGNodeSetNodeType(text, YGNodeTypeText);
+  YGNodeSetMeasureContentKey(text, 42);
+  return root;
+}
+
+static std::vector<char> saveSnapshot(
+    const YGNodeRef root,
+    const YGSnapshotOptions options) {
+  std::vector<char> snapshot(YGNodeSnapshotSave(root, options, nullptr, 0));
+  const size_t size =
+      YGNodeSnapshotSave(root, options, snapshot.data(), snapshot.size());
+  EXPECT_EQ(snapshot.size(), size);
+  return snapshot;
+}
+
+static void expectSameTree(const YGNodeRef expected, const YGNodeRef actual) {
+  ASSERT_EQ(expected->getStyle(), actual->getStyle());
+  ASSERT_EQ(YGNodeGetNodeType(expected), YGNodeGetNodeType(actual));
+  ASSERT_EQ(
+      YGNodeGetMeasureContentKey(expected), YGNodeGetMeasureContentKey(actual));
+  ASSERT_EQ(YGNodeLayoutGetLeft(expected), YGNodeLayoutGetLeft(actual));
+  ASSERT_EQ(YGNodeLayoutGetTop(expected), YGNodeLayoutGetTop(actual));
+  ASSERT_EQ(YGNodeLayoutGetWidth(expected), YGNodeLayoutGetWidth(actual));
+  ASSERT_EQ(YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+  ASSERT_EQ(YGNodeGetChildCount(expected), YGNodeGetChildCount(actual));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(actual); i++) {
+    ASSERT_EQ(actual, YGNodeGetOwner(YGNodeGetChild(actual, i)));
+    expectSameTree(YGNodeGetChild(expected, i), YGNodeGetChild(actual, i));
+  }
+}
+
+TEST(YogaTest, snapshot_restores_tree_and_layout) {
+  const YGConfigRef config = YGConfigGetDefault();
+  const YGNodeRef root = createTree(config);
+  YGNodeCalculateLayout(root, YGUndefined, 100, YGDirectionLTR);
+
+  const std::vector<char> snapshot =
+      saveSnapshot(root, YGSnapshotOptionsLayout);
+  const YGNodeRef loaded =
+      YGNodeSnapshotLoad(snapshot.data(), snapshot.size(), config);
+  ASSERT_NE(nullptr, loaded);
+  ASSERT_EQ(nullptr, YGNodeGetOwner(loaded));
+  expectSameTree(root, loaded);
+
+  YGNodeFreeRecursive(root);
+  YGNodeFreeRecursive(loaded);
+}
+
+TEST(YogaTest, snapshot_without_layout_lays_out_like_original) {
+  const YGConfigRef config = YGConfigGetDefault();
+  const YGNodeRef root = createTree(config);
+  const std::vector<char> snapshot = saveSnapshot(root, YGSnapshotOptions(0));
+  const YGNodeRef loaded =
+      YGNodeSnapshotLoad(snapshot.data(), snapshot.size(), config);
+  ASSERT_NE(nullptr, loaded);
+  ASSERT_TRUE(YGFloatIsUndefined(YGNodeLayoutGetWidth(loaded)));
+
+  YGNodeCalculateLayout(root, YGUndefined, 100, YGDirectionRTL);
+  YGNodeCalculateLayout(loaded, YGUndefined, 100, YGDirectionRTL);
+  expectSameTree(root, loaded);
+
+  YGNodeFreeRecursive(root);
+  YGNodeFreeRecursive(loaded);
+}
+
+TEST(YogaTest, snapshot_shares_equal_styles) {
+  const YGConfigRef config = YGConfigGetDefault();
+  const YGNodeRef root = createTree(config);
+  ASSERT_FALSE(YGNodeGetChild(YGNodeGetChild(root, 0), 0)
+                   ->getSharedStyle()
+                   .isSharedWith(YGNodeGetChild(YGNodeGetChild(root, 0), 1)
+                                     ->getSharedStyle()));
+  const std::vector<char> snapshot = saveSnapshot(root, YGSnapshotOptions(0));
+  const YGNodeRef loaded =
+      YGNodeSnapshotLoad(snapshot.data(), snapshot.size(), config);
+
+  const YGNodeRef column = YGNodeGetChild(loaded, 0);
+  ASSERT_TRUE(YGNodeGetChild(column, 0)->getSharedStyle().isSharedWith(
+      YGNodeGetChild(column, 1)->getSharedStyle()));
+  ASSERT_FALSE(column->getSharedStyle().isSharedWith(
+      YGNodeGetChild(column, 0)->getSharedStyle()));
+
+  YGNodeFreeRecursive(root);
+  YGNodeFreeRecursive(loaded);
+}
+
+TEST(YogaTest, snapshot_loads_into_node_arena) {
+  const YGNodeRef root = createTree(YGConfigGetDefault());
+  const std::vector<char> snapshot = saveSnapshot(root, YGSnapshotOptions(0));
+
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeArenaRef arena = YGNodeArenaNew();
+  YGConfigSetNodeArena(config, arena);
+  const YGNodeRef loaded =
+      YGNodeSnapshotLoad(snapshot.data(), snapshot.size(), config);
+  ASSERT_NE(nullptr, loaded);
+  ASSERT_EQ(config, loaded->getConfig());
+  ASSERT_EQ(10u, arena->getLiveNodeCount());
+
+  YGNodeArenaFree(arena);
+  YGConfigFree(config);
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, snapshot_rejects_invalid_data) {
+  const YGConfigRef config = YGConfigGetDefault();
+  const YGNodeRef root = createTree(config);
+  std::vector<char> snapshot = saveSnapshot(root, YGSnapshotOptionsLayout);
+
+  ASSERT_EQ(nullptr, YGNodeSnapshotLoad(snapshot.data(), 0, config));
+  ASSERT_EQ(
+      nullptr,
+      YGNodeSnapshotLoad(snapshot.data(), snapshot.size() - 1, config));
+
+  std::vector<char> badMagic = snapshot;
+  badMagic[0]++;
+  ASSERT_EQ(
+      nullptr, YGNodeSnapshotLoad(badMagic.data(), badMagic.size(), config));
+
+  // Removing the last node leaves its parent with a missing child.
+  std::vector<char> missingChild = snapshot;
+  uint32_t nodeCount;
+  memcpy(&nodeCount, missingChild.data() + 20, sizeof(nodeCount));
+  nodeCount--;
+  memcpy(missingChild.data() + 20, &nodeCount, sizeof(nodeCount));
+  ASSERT_EQ(
+      nullptr,
+      YGNodeSnapshotLoad(missingChild.data(), missingChild.size(), config));
+
+  YGNodeFreeRecursive(root);
+}
+
+static int measureCount = 0;
+
+static YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  measureCount++;
+  return YGSize{widthMode == YGMeasureModeUndefined ? 30 : width, 12};
+}
+
+static YGNodeRef createMeasuredTree(const YGConfigRef config) {
+  const YGNodeRef root = createTree(config);
+  YGNodeSetMeasureFunc(YGNodeGetChild(YGNodeGetChild(root, 1), 1), measureText);
+  return root;
+}
+
+TEST(YogaTest, snapshot_restores_layout_cache) {
+  const YGConfigRef config = YGConfigGetDefault();
+  const YGNodeRef root = createMeasuredTree(config);
+  measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, 100, YGDirectionLTR);
+  ASSERT_GT(measureCount, 0);
+  const std::vector<char> snapshot =
+      saveSnapshot(root, YGSnapshotOptionsLayoutCache);
+
+  const YGNodeRef rebuilt = createMeasuredTree(config);
+  ASSERT_TRUE(YGNodeIsDirty(rebuilt));
+  ASSERT_TRUE(YGNodeSnapshotRestoreLayoutCache(
+      rebuilt, snapshot.data(), snapshot.size()));
+  ASSERT_FALSE(YGNodeIsDirty(rebuilt));
+  measureCount = 0;
+  YGNodeCalculateLayout(rebuilt, YGUndefined, 100, YGDirectionLTR);
+  ASSERT_EQ(0, measureCount);
+  expectSameTree(root, rebuilt);
+
+  // Measure functions are not part of snapshots, so caches are restored onto
+  // loaded trees once they are set.
+  const YGNodeRef loaded =
+      YGNodeSnapshotLoad(snapshot.data(), snapshot.size(), config);
+  const YGNodeRef text = YGNodeGetChild(YGNodeGetChild(loaded, 1), 1);
+  ASSERT_FALSE(YGNodeSnapshotRestoreLayoutCache(
+      loaded, snapshot.data(), snapshot.size()));
+  YGNodeSetMeasureFunc(text, measureText);
+  ASSERT_TRUE(YGNodeSnapshotRestoreLayoutCache(
+      loaded, snapshot.data(), snapshot.size()));
+  measureCount = 0;
+  YGNodeCalculateLayout(loaded, YGUndefined, 100, YGDirectionLTR);
+  ASSERT_EQ(0, measureCount);
+  expectSameTree(root, loaded);
+
+  YGNodeCalculateLayout(root, 150, 100, YGDirectionRTL);
+  YGNodeCalculateLayout(rebuilt, 150, 100, YGDirectionRTL);
+  expectSameTree(root, rebuilt);
+
+  YGNodeFreeRecursive(root);
+  YGNodeFreeRecursive(rebuilt);
+  YGNodeFreeRecursive(loaded);
+}
+
+TEST(YogaTest, snapshot_invalidates_changed_layout_cache) {
+  const YGConfigRef config = YGConfigGetDefault();
+  const YGNodeRef root = createMeasuredTree(config);
+  YGNodeCalculateLayout(root, YGUndefined, 100, YGDirectionLTR);
+  const std::vector<char> snapshot =
+      saveSnapshot(root, YGSnapshotOptionsLayoutCache);
+
+  const YGNodeRef expected = createMeasuredTree(config);
+  const YGNodeRef changed = createMeasuredTree(config);
+  for (const YGNodeRef tree : {expected, changed}) {
+    YGNodeStyleSetMinHeight(YGNodeGetChild(YGNodeGetChild(tree, 2), 0), 60);
+  }
+  ASSERT_FALSE(YGNodeSnapshotRestoreLayoutCache(
+      changed, snapshot.data(), snapshot.size()));
+  ASSERT_TRUE(YGNodeIsDirty(changed));
+  ASSERT_FALSE(YGNodeIsDirty(YGNodeGetChild(changed, 0)));
+  ASSERT_FALSE(YGNodeIsDirty(YGNodeGetChild(changed, 1)));
+  ASSERT_TRUE(YGNodeIsDirty(YGNodeGetChild(changed, 2)));
+  ASSERT_TRUE(YGNodeIsDirty(YGNodeGetChild(YGNodeGetChild(changed, 2), 0)));
+  ASSERT_FALSE(YGNodeIsDirty(YGNodeGetChild(YGNodeGetChild(changed, 2), 1)));
+
+  YGNodeCalculateLayout(expected, YGUndefined, 100, YGDirectionLTR);
+  YGNodeCalculateLayout(changed, YGUndefined, 100, YGDirectionLTR);
+  expectSameTree(expected, changed);
+
+  // Snapshots without layout caches are not restored.
+  const std::vector<char> withoutCache =
+      saveSnapshot(root, YGSnapshotOptionsLayout);
+  ASSERT_FALSE(YGNodeSnapshotRestoreLayoutCache(
+      changed, withoutCache.data(), withoutCache.size()));
+  ASSERT_FALSE(YGNodeIsDirty(changed));
+
+  YGNodeFreeRecursive(root);
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(changed);
+}
@@ -0,0 +1,331 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+// Columns without flexible children are laid out by a dedicated stacking
+// routine. These tests compare its results with the general algorithm, which
+// is forced by adding a child with display: none to the same tree.
+
+static YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const float textWidth = 45.5f;
+  if (widthMode == YGMeasureModeExactly ||
+      (widthMode == YGMeasureModeAtMost && width < textWidth)) {
+    return YGSize{width, textWidth * 10 / width};
+  }
+  return YGSize{textWidth, 10};
+}
+
+struct StackSize {
+  float width;
+  float height;
+  float minHeight;
+  float maxHeight;
+};
+
+static YGNodeRef createStack(
+    const YGConfigRef config,
+    const YGFlexDirection flexDirection,
+    const YGAlign alignItems,
+    const StackSize& size,
+    const bool useGeneralLayout) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, flexDirection);
+  YGNodeStyleSetAlignItems(root, alignItems);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 5);
+  YGNodeStyleSetBorder(root, YGEdgeTop, 2);
+  YGNodeStyleSetMinHeight(root, size.minHeight);
+  YGNodeStyleSetMaxHeight(root, size.maxHeight);
+
+  const YGNodeRef fixed = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(fixed, 10);
+  YGNodeStyleSetMargin(fixed, YGEdgeAll, 3);
+  YGNodeInsertChild(root, fixed, 0);
+
+  const YGNodeRef text = YGNodeNewWithConfig(config);
+  text->setMeasureFunc(measureText);
+  YGNodeStyleSetMargin(text, YGEdgeStart, 4);
+  YGNodeInsertChild(root, text, 1);
+
+  const YGNodeRef percent = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidthPercent(percent, 50);
+  YGNodeStyleSetHeight(percent, 20);
+  YGNodeInsertChild(root, percent, 2);
+
+  const YGNodeRef bounded = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(bounded, 30);
+  YGNodeStyleSetMinHeight(bounded, 12);
+  YGNodeStyleSetMaxWidth(bounded, 25);
+  YGNodeInsertChild(root, bounded, 3);
+
+  const YGNodeRef nested = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPadding(nested, YGEdgeLeft, 2);
+  const YGNodeRef nestedChild = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(nestedChild, 7);
+  YGNodeStyleSetWidth(nestedChild, 60);
+  YGNodeInsertChild(nested, nestedChild, 0);
+  YGNodeInsertChild(root, nested, 4);
+
+  const YGNodeRef centered = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignSelf(centered, YGAlignCenter);
+  YGNodeStyleSetWidth(centered, 20);
+  YGNodeStyleSetHeight(centered, 5);
+  YGNodeInsertChild(root, centered, 5);
+
+  if (useGeneralLayout) {
+    const YGNodeRef hidden = YGNodeNewWithConfig(config);
+    YGNodeStyleSetDisplay(hidden, YGDisplayNone);
+    YGNodeInsertChild(root, hidden, 6);
+  }
+  return root;
+}
+
+static void expectSameLayout(const YGNodeRef expected, const YGNodeRef actual) {
+  ASSERT_EQ(YGNodeLayoutGetLeft(expected), YGNodeLayoutGetLeft(actual));
+  ASSERT_EQ(YGNodeLayoutGetTop(expected), YGNodeLayoutGetTop(actual));
+  ASSERT_EQ(YGNodeLayoutGetWidth(expected), YGNodeLayoutGetWidth(actual));
+  ASSERT_EQ(YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+  ASSERT_EQ(
+      YGNodeLayoutGetHadOverflow(expected), YGNodeLayoutGetHadOverflow(actual));
+  const uint32_t childCount = YGNodeGetChildCount(actual);
+  for (uint32_t i = 0; i < childCount; i++) {
+    expectSameLayout(YGNodeGetChild(expected, i), YGNodeGetChild(actual, i));
+  }
+}
+
+static const StackSize kStackSizes[] = {
+    {YGUndefined, YGUndefined, YGUndefined, YGUndefined},
+    {100, YGUndefined, YGUndefined, YGUndefined},
+    {100, 200, YGUndefined, YGUndefined},
+    {100, 30, YGUndefined, YGUndefined},
+    {100, YGUndefined, 150, YGUndefined},
+    {100, YGUndefined, YGUndefined, 40},
+    {40, YGUndefined, YGUndefined, YGUndefined},
+};
+
+TEST(YogaTest, stack_layout_matches_general_layout) {
+  const YGConfigRef config = YGConfigNew();
+  for (const auto flexDirection :
+       {YGFlexDirectionColumn, YGFlexDirectionColumnReverse}) {
+    for (const auto alignItems :
+         {YGAlignStretch, YGAlignFlexStart, YGAlignCenter, YGAlignFlexEnd}) {
+      for (const auto direction : {YGDirectionLTR, YGDirectionRTL}) {
+        for (const auto& size : kStackSizes) {
+          const YGNodeRef expected =
+              createStack(config, flexDirection, alignItems, size, true);
+          const YGNodeRef actual =
+              createStack(config, flexDirection, alignItems, size, false);
+          YGNodeCalculateLayout(expected, size.width, size.height, direction);
+          YGNodeCalculateLayout(actual, size.width, size.height, direction);
+
+          expectSameLayout(expected, actual);
+
+          YGNodeFreeRecursive(expected);
+          YGNodeFreeRecursive(actual);
+        }
+      }
+    }
+  }
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, stack_layout_falls_back_once_child_flexes) {
+  const YGConfigRef config = YGConfigNew();
+  const StackSize size = {100, 200, YGUndefined, YGUndefined};
+  const YGNodeRef expected = createStack(
+      config, YGFlexDirectionColumn, YGAlignStretch, size, true);
+  const YGNodeRef actual = createStack(
+      config, YGFlexDirectionColumn, YGAlignStretch, size, false);
+  YGNodeCalculateLayout(actual, size.width, size.height, YGDirectionLTR);
+
+  YGNodeStyleSetFlexGrow(YGNodeGetChild(expected, 2), 1);
+  YGNodeStyleSetFlexGrow(YGNodeGetChild(actual, 2), 1);
+  YGNodeCalculateLayout(expected, size.width, size.height, YGDirectionLTR);
+  YGNodeCalculateLayout(actual, size.width, size.height, YGDirectionLTR);
+
+  ASSERT_GT(YGNodeLayoutGetHeight(YGNodeGetChild(actual, 2)), 20);
+  expectSameLayout(expected, actual);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(actual);
+  YGConfigFree(config);
+}
+
+static YGMarkerLayoutData lastLayoutData;
+
+static void* startMarker(YGMarker, YGNodeRef, YGMarkerData) {
+  return nullptr;
+}
+
+static void endMarker(YGMarker marker, YGNodeRef, YGMarkerData data, void*) {
+  if (marker == YGMarkerLayout) {
+    lastLayoutData = *data.layout;
+  }
+}
+
+static void appendItems(
+    const YGConfigRef config,
+    const YGNodeRef list,
+    const uint32_t count,
+    const float maxWidth) {
+  for (uint32_t i = 0; i < count; i++) {
+    const uint32_t index = YGNodeGetChildCount(list);
+    const YGNodeRef item = YGNodeNewWithConfig(config);
+    if (index % 2 == 0) {
+      item->setMeasureFunc(measureText);
+    } else {
+      YGNodeStyleSetHeight(item, 10);
+      YGNodeStyleSetWidth(item, std::min(maxWidth, 20.0f + index));
+      YGNodeStyleSetAlignSelf(item, YGAlignCenter);
+    }
+    YGNodeStyleSetMargin(item, YGEdgeVertical, 1);
+    YGNodeInsertChild(list, item, index);
+  }
+}
+
+static YGNodeRef createFeed(
+    const YGConfigRef config,
+    const YGAlign listAlign,
+    const uint32_t count,
+    const float maxWidth) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 2000);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 4);
+  const YGNodeRef list = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPadding(list, YGEdgeBottom, 3);
+  YGNodeStyleSetAlignSelf(list, listAlign);
+  YGNodeStyleSetAlignItems(list, YGAlignFlexStart);
+  appendItems(config, list, count, maxWidth);
+  YGNodeInsertChild(root, list, 0);
+  return root;
+}
+
+TEST(YogaTest, stack_layout_only_lays_out_appended_children) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMarkerCallbacks(config, {startMarker, endMarker});
+  for (const auto listAlign : {YGAlignStretch, YGAlignFlexStart}) {
+    const YGNodeRef expected = createFeed(config, listAlign, 220, 100);
+    const YGNodeRef actual = createFeed(config, listAlign, 200, 100);
+    YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    appendItems(config, YGNodeGetChild(actual, 0), 20, 100);
+    YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+    YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+    expectSameLayout(expected, actual);
+
+    // The earlier children are not visited, not even to hit their caches.
+    ASSERT_LT(
+        lastLayoutData.layouts + lastLayoutData.measures +
+            lastLayoutData.cachedLayouts + lastLayoutData.cachedMeasures,
+        100);
+
+    YGNodeFreeRecursive(expected);
+    YGNodeFreeRecursive(actual);
+  }
+  YGConfigFree(config);
+}
+
+static YGSize measureWideText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const float textWidth = 350;
+  if (widthMode != YGMeasureModeUndefined && width < textWidth) {
+    return YGSize{width, textWidth * 10 / width};
+  }
+  return YGSize{textWidth, 10};
+}
+
+static YGNodeRef createShrinkingFeed(
+    const YGConfigRef config,
+    const uint32_t count) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 300);
+  const YGNodeRef list = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexShrink(list, 1);
+  YGNodeStyleSetAlignItems(list, YGAlignFlexStart);
+  const YGNodeRef wide = YGNodeNewWithConfig(config);
+  wide->setMeasureFunc(measureWideText);
+  YGNodeInsertChild(list, wide, 0);
+  appendItems(config, list, count - 1, 100);
+  YGNodeInsertChild(root, list, 0);
+  const YGNodeRef sidebar = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(sidebar, 50);
+  YGNodeInsertChild(root, sidebar, 1);
+  return root;
+}
+
+TEST(YogaTest, stack_layout_only_lays_out_appended_children_rtl) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef expected = createShrinkingFeed(config, 12);
+  const YGNodeRef actual = createShrinkingFeed(config, 10);
+  YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionRTL);
+
+  // Measuring the list for its flex basis re-measures the earlier children
+  // under other constraints, which must not move them.
+  appendItems(config, YGNodeGetChild(actual, 0), 2, 100);
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionRTL);
+  YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionRTL);
+  expectSameLayout(expected, actual);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(actual);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, stack_layout_relays_out_when_appended_children_widen_it) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef expected = createFeed(config, YGAlignFlexStart, 60, 1000);
+  const YGNodeRef actual = createFeed(config, YGAlignFlexStart, 40, 1000);
+  YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+  const YGNodeRef centered = YGNodeGetChild(YGNodeGetChild(actual, 0), 1);
+  const float centeredLeft = YGNodeLayoutGetLeft(centered);
+
+  // Centered children move as the list widens.
+  appendItems(config, YGNodeGetChild(actual, 0), 20, 1000);
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_GT(YGNodeLayoutGetLeft(centered), centeredLeft);
+  expectSameLayout(expected, actual);
+
+  // So do all children once an earlier one is changed.
+  YGNodeStyleSetWidth(YGNodeGetChild(YGNodeGetChild(expected, 0), 1), 5);
+  YGNodeStyleSetWidth(centered, 5);
+  appendItems(config, YGNodeGetChild(expected, 0), 1, 1000);
+  appendItems(config, YGNodeGetChild(actual, 0), 1, 1000);
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+  expectSameLayout(expected, actual);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(actual);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, stack_layout_state_does_not_allocate_cold_data) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = createFeed(config, YGAlignFlexStart, 20, 100);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  const YGNodeRef list = YGNodeGetChild(root, 0);
+  ASSERT_NE(nullptr, list->getStackLayoutState());
+  ASSERT_FALSE(list->hasColdData());
+  ASSERT_NE(nullptr, root->getStackLayoutState());
+  ASSERT_FALSE(root->hasColdData());
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
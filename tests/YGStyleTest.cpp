@@ -57,6 +57,59 @@ TEST(YogaTest, copy_style_modified_same) {
   YGNodeFree(node1);
 }
 
+TEST(YogaTest, copy_style_shares_style) {
+  const YGNodeRef node0 = YGNodeNew();
+  const YGNodeRef node1 = YGNodeNew();
+  YGNodeStyleSetWidth(node1, 10);
+
+  YGNodeCopyStyle(node0, node1);
+  ASSERT_EQ(&node1->getStyle(), &node0->getStyle());
+
+  YGNodeStyleSetWidth(node0, 20);
+  ASSERT_NE(&node1->getStyle(), &node0->getStyle());
+  ASSERT_FLOAT_EQ(10, YGNodeStyleGetWidth(node1).value);
+  ASSERT_FLOAT_EQ(20, YGNodeStyleGetWidth(node0).value);
+
+  YGNodeFree(node0);
+  YGNodeFree(node1);
+}
+
+TEST(YogaTest, clone_shares_style_until_changed) {
+  const YGNodeRef node = YGNodeNew();
+  YGNodeStyleSetMargin(node, YGEdgeTop, 5);
+  const YGNodeRef clone = YGNodeClone(node);
+  ASSERT_EQ(&node->getStyle(), &clone->getStyle());
+
+  // Setting an unchanged value keeps the style shared.
+  YGNodeStyleSetMargin(clone, YGEdgeTop, 5);
+  ASSERT_EQ(&node->getStyle(), &clone->getStyle());
+
+  YGNodeStyleSetMargin(clone, YGEdgeTop, 6);
+  ASSERT_NE(&node->getStyle(), &clone->getStyle());
+  ASSERT_FLOAT_EQ(5, YGNodeStyleGetMargin(node, YGEdgeTop).value);
+  ASSERT_FLOAT_EQ(6, YGNodeStyleGetMargin(clone, YGEdgeTop).value);
+
+  YGNodeFree(node);
+  YGNodeFree(clone);
+}
+
+TEST(YogaTest, new_nodes_share_default_style) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetUseWebDefaults(config, true);
+  const YGNodeRef node0 = YGNodeNewWithConfig(config);
+  const YGNodeRef node1 = YGNodeNewWithConfig(config);
+  ASSERT_EQ(&node0->getStyle(), &node1->getStyle());
+  ASSERT_EQ(YGFlexDirectionRow, YGNodeStyleGetFlexDirection(node0));
+  ASSERT_EQ(YGAlignStretch, YGNodeStyleGetAlignContent(node0));
+
+  YGNodeStyleSetFlexDirection(node0, YGFlexDirectionColumn);
+  ASSERT_EQ(YGFlexDirectionRow, YGNodeStyleGetFlexDirection(node1));
+
+  YGNodeFree(node0);
+  YGNodeFree(node1);
+  YGConfigFree(config);
+}
+
 TEST(YogaTest, initialise_flexShrink_flexGrow) {
   const YGNodeRef node0 = YGNodeNew();
   YGNodeStyleSetFlexShrink(node0, 1);
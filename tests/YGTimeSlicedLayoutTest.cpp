@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+#include <cmath>
+
+static YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const float length = *static_cast<float*>(node->getContext());
+  if (widthMode == YGMeasureModeUndefined || length <= width) {
+    return YGSize{length, 10};
+  }
+  return YGSize{width, 10 * std::ceil(length / width)};
+}
+
+static YGNodeRef createTree(
+    const YGConfigRef config,
+    std::vector<float>& textLengths) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 300);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 3.5f);
+  for (uint32_t i = 0; i < textLengths.size() / 4; i++) {
+    const YGNodeRef row = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetFlexWrap(row, i % 3 == 0 ? YGWrapWrap : YGWrapNoWrap);
+    YGNodeStyleSetAlignItems(row, YGAlignBaseline);
+    YGNodeStyleSetMargin(row, YGEdgeBottom, 1.25f);
+    for (uint32_t j = 0; j < 4; j++) {
+      const YGNodeRef text = YGNodeNewWithConfig(config);
+      YGNodeSetContext(text, &textLengths[i * 4 + j]);
+      YGNodeSetMeasureFunc(text, measureText);
+      YGNodeStyleSetFlexShrink(text, 1);
+      YGNodeStyleSetFlexGrow(text, j % 2);
+      YGNodeInsertChild(row, text, j);
+    }
+    YGNodeInsertChild(root, row, i);
+  }
+  return root;
+}
+
+static void assertSameLayout(const YGNodeRef expected, const YGNodeRef actual) {
+  ASSERT_EQ(YGNodeLayoutGetLeft(expected), YGNodeLayoutGetLeft(actual));
+  ASSERT_EQ(YGNodeLayoutGetTop(expected), YGNodeLayoutGetTop(actual));
+  ASSERT_EQ(YGNodeLayoutGetWidth(expected), YGNodeLayoutGetWidth(actual));
+  ASSERT_EQ(YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+  ASSERT_EQ(YGNodeIsDirty(expected), YGNodeIsDirty(actual));
+  ASSERT_EQ(YGNodeGetChildCount(expected), YGNodeGetChildCount(actual));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(expected); i++) {
+    assertSameLayout(YGNodeGetChild(expected, i), YGNodeGetChild(actual, i));
+  }
+}
+
+static void assertNotLaidOut(const YGNodeRef node) {
+  ASSERT_TRUE(YGFloatIsUndefined(YGNodeLayoutGetWidth(node)));
+  ASSERT_TRUE(YGFloatIsUndefined(YGNodeLayoutGetHeight(node)));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    assertNotLaidOut(YGNodeGetChild(node, i));
+  }
+}
+
+TEST(YogaTest, time_sliced_layout_matches_calculate_layout) {
+  const YGConfigRef config = YGConfigNew();
+  std::vector<float> textLengths(200);
+  for (uint32_t i = 0; i < textLengths.size(); i++) {
+    textLengths[i] = 17.5f * (i % 11);
+  }
+  const YGNodeRef expected = createTree(config, textLengths);
+  const YGNodeRef actual = createTree(config, textLengths);
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  const YGLayoutJobRef job =
+      YGLayoutBegin(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+  uint32_t steps = 0;
+  while (!YGLayoutStep(job, 0)) {
+    ASSERT_FALSE(YGLayoutIsDone(job));
+    assertNotLaidOut(actual);
+    ASSERT_TRUE(YGNodeIsDirty(actual));
+    steps++;
+  }
+  ASSERT_TRUE(YGLayoutIsDone(job));
+  ASSERT_TRUE(YGLayoutStep(job, 0));
+  ASSERT_GT(steps, 1u);
+  ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+  assertSameLayout(expected, actual);
+  YGLayoutFree(job);
+
+  // Once published, the layout is cached like one calculated at once.
+  textLengths[21] = 250;
+  YGNodeMarkDirty(YGNodeGetChild(YGNodeGetChild(expected, 5), 1));
+  YGNodeMarkDirty(YGNodeGetChild(YGNodeGetChild(actual, 5), 1));
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+  assertSameLayout(expected, actual);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(actual);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, time_sliced_layout_keeps_previous_layout_until_done) {
+  const YGConfigRef config = YGConfigNew();
+  std::vector<float> textLengths(40, 50);
+  const YGNodeRef root = createTree(config, textLengths);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  const YGNodeRef text = YGNodeGetChild(YGNodeGetChild(root, 3), 0);
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(text));
+
+  YGNodeStyleSetWidth(text, 80);
+  const YGLayoutJobRef job =
+      YGLayoutBegin(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FALSE(YGLayoutStep(job, 0));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(text));
+  ASSERT_TRUE(YGNodeIsDirty(text));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+
+  while (!YGLayoutStep(job, 0)) {
+    ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(text));
+  }
+  YGLayoutFree(job);
+  ASSERT_FLOAT_EQ(80, YGNodeLayoutGetWidth(text));
+  ASSERT_FALSE(YGNodeIsDirty(text));
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, time_sliced_layout_can_be_discarded) {
+  const YGConfigRef config = YGConfigNew();
+  std::vector<float> textLengths(40, 50);
+  const YGNodeRef expected = createTree(config, textLengths);
+  const YGNodeRef actual = createTree(config, textLengths);
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+
+  const YGLayoutJobRef job =
+      YGLayoutBegin(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FALSE(YGLayoutStep(job, 0));
+  ASSERT_FALSE(YGLayoutStep(job, 0));
+  YGLayoutFree(job);
+  ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+  assertNotLaidOut(actual);
+
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+  assertSameLayout(expected, actual);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(actual);
+  YGConfigFree(config);
+}
+
+static int cloneCount = 0;
+
+static YGNodeRef countClone(YGNodeRef, YGNodeRef, int) {
+  cloneCount++;
+  return nullptr;
+}
+
+static YGNodeRef createLegacySubtree(const YGConfigRef legacyConfig) {
+  const YGNodeRef node = YGNodeNewWithConfig(legacyConfig);
+  YGNodeStyleSetAlignItems(node, YGAlignFlexStart);
+  const YGNodeRef child = YGNodeNewWithConfig(legacyConfig);
+  YGNodeStyleSetFlexGrow(child, 1);
+  YGNodeStyleSetFlexShrink(child, 1);
+  YGNodeInsertChild(node, child, 0);
+  const YGNodeRef grandchild = YGNodeNewWithConfig(legacyConfig);
+  YGNodeStyleSetFlexGrow(grandchild, 1);
+  YGNodeStyleSetFlexShrink(grandchild, 1);
+  YGNodeInsertChild(child, grandchild, 0);
+  return node;
+}
+
+TEST(YogaTest, time_sliced_layout_keeps_configs_of_nodes) {
+  const YGConfigRef config = YGConfigNew();
+  const YGConfigRef legacyConfig = YGConfigNew();
+  YGConfigSetUseLegacyStretchBehaviour(legacyConfig, true);
+  YGConfigSetCloneNodeFunc(legacyConfig, countClone);
+  std::vector<float> textLengths(40, 50);
+  const YGNodeRef expected = createTree(config, textLengths);
+  const YGNodeRef actual = createTree(config, textLengths);
+  YGNodeInsertChild(expected, createLegacySubtree(legacyConfig), 0);
+  YGNodeInsertChild(actual, createLegacySubtree(legacyConfig), 0);
+
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  const YGLayoutJobRef job =
+      YGLayoutBegin(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+  while (!YGLayoutStep(job, 0)) {
+  }
+  YGLayoutFree(job);
+  assertSameLayout(expected, actual);
+  const YGNodeRef legacyChild = YGNodeGetChild(YGNodeGetChild(actual, 0), 0);
+  ASSERT_TRUE(YGNodeLayoutGetDidUseLegacyFlag(legacyChild));
+  ASSERT_EQ(legacyConfig, legacyChild->getConfig());
+  // Private copies are not made with the clone callbacks meant for the tree.
+  ASSERT_EQ(0, cloneCount);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(actual);
+  YGConfigFree(legacyConfig);
+  YGConfigFree(config);
+}
+
+#if GTEST_HAS_DEATH_TEST
+TEST(YogaDeathTest, time_sliced_layout_cannot_publish_to_changed_tree) {
+  const YGConfigRef config = YGConfigNew();
+  std::vector<float> textLengths(40, 50);
+  const YGNodeRef root = createTree(config, textLengths);
+  const YGLayoutJobRef job =
+      YGLayoutBegin(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FALSE(YGLayoutStep(job, 0));
+
+  YGNodeInsertChild(root, YGNodeNewWithConfig(config), 0);
+  ASSERT_DEATH(
+      {
+        while (!YGLayoutStep(job, 0)) {
+        }
+      },
+      "Cannot publish layout.*");
+
+  YGLayoutFree(job);
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+#endif
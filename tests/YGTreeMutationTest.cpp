@@ -109,3 +109,24 @@ TEST(YogaTest, set_children_keeps_and_reorders_common_children) {
   YGNodeFreeRecursive(root);
   YGNodeFree(root_child0);
 }
+
+TEST(YogaTest, insert_and_remove_beyond_inline_child_capacity) {
+  YGNodeRef const root = YGNodeNew();
+  std::vector<YGNodeRef> expectedChildren;
+  for (uint32_t i = 0; i < 10; i++) {
+    YGNodeRef const child = YGNodeNew();
+    YGNodeInsertChild(root, child, 0);
+    expectedChildren.insert(expectedChildren.begin(), child);
+  }
+  ASSERT_EQ(getChildren(root), expectedChildren);
+
+  for (uint32_t i = 0; i < 8; i++) {
+    YGNodeRef const child = expectedChildren.back();
+    YGNodeRemoveChild(root, child);
+    YGNodeFree(child);
+    expectedChildren.pop_back();
+  }
+  ASSERT_EQ(getChildren(root), expectedChildren);
+
+  YGNodeFreeRecursive(root);
+}
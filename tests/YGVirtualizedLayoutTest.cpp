@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+static YGSize measureItem(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  (*static_cast<int*>(node->getContext()))++;
+  return YGSize{width, 30};
+}
+
+static YGNodeRef createFeed(
+    const YGConfigRef config,
+    std::vector<int>& measureCounts) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetPadding(root, YGEdgeTop, 5);
+  for (uint32_t i = 0; i < measureCounts.size(); i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeSetContext(child, &measureCounts[i]);
+    YGNodeSetMeasureFunc(child, measureItem);
+    YGNodeStyleSetMargin(child, YGEdgeBottom, 2);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+TEST(YogaTest, virtualized_window_matches_full_layout) {
+  const YGConfigRef config = YGConfigNew();
+  std::vector<int> expectedCounts(100);
+  std::vector<int> actualCounts(100);
+  const YGNodeRef expected = createFeed(config, expectedCounts);
+  const YGNodeRef actual = createFeed(config, actualCounts);
+  YGNodeSetVirtualizedWindow(actual, 320, 200, 30, 50);
+
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(actual, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+  for (uint32_t i = 0; i < 100; i++) {
+    const YGNodeRef expectedChild = YGNodeGetChild(expected, i);
+    const YGNodeRef actualChild = YGNodeGetChild(actual, i);
+    ASSERT_EQ(
+        YGNodeLayoutGetLeft(expectedChild), YGNodeLayoutGetLeft(actualChild));
+    ASSERT_EQ(
+        YGNodeLayoutGetTop(expectedChild), YGNodeLayoutGetTop(actualChild));
+    ASSERT_EQ(
+        YGNodeLayoutGetWidth(expectedChild),
+        YGNodeLayoutGetWidth(actualChild));
+    ASSERT_EQ(
+        YGNodeLayoutGetHeight(expectedChild),
+        YGNodeLayoutGetHeight(actualChild));
+  }
+
+  // Children intersecting the window widened by the overscan, from 270 to 570.
+  for (uint32_t i = 0; i < 100; i++) {
+    const float top = YGNodeLayoutGetTop(YGNodeGetChild(actual, i));
+    ASSERT_EQ(top + 32 > 270 && top < 570, actualCounts[i] > 0);
+  }
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(actual);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, virtualized_window_estimates_children_outside) {
+  const YGConfigRef config = YGConfigNew();
+  std::vector<int> measureCounts(1000);
+  const YGNodeRef root = createFeed(config, measureCounts);
+  YGNodeSetVirtualizedWindow(root, 0, 100, 10, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Children 0 to 2 start before 100, as each of them takes 32 points once it
+  // is laid out.
+  for (uint32_t i = 0; i < 1000; i++) {
+    ASSERT_EQ(i < 3, measureCounts[i] > 0);
+  }
+  const YGNodeRef estimated = YGNodeGetChild(root, 10);
+  ASSERT_FLOAT_EQ(5 + 3 * 32 + 7 * 12, YGNodeLayoutGetTop(estimated));
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetWidth(estimated));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(estimated));
+  ASSERT_FLOAT_EQ(5 + 3 * 32 + 997 * 12, YGNodeLayoutGetHeight(root));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, virtualized_window_keeps_positions_stable) {
+  const YGConfigRef config = YGConfigNew();
+  std::vector<int> measureCounts(1000);
+  const YGNodeRef root = createFeed(config, measureCounts);
+  YGNodeSetVirtualizedWindow(root, 0, 100, 10, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Child 23 is the first one intersecting the window after it moved.
+  const YGNodeRef first = YGNodeGetChild(root, 23);
+  const float firstTop = YGNodeLayoutGetTop(first);
+  ASSERT_FLOAT_EQ(5 + 3 * 32 + 20 * 12, firstTop);
+
+  YGNodeSetVirtualizedWindow(root, firstTop, 100, 10, 0);
+  ASSERT_TRUE(YGNodeIsDirty(root));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(0, measureCounts[22]);
+  ASSERT_GT(measureCounts[23], 0);
+  ASSERT_FLOAT_EQ(firstTop, YGNodeLayoutGetTop(first));
+  ASSERT_FLOAT_EQ(30, YGNodeLayoutGetHeight(first));
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef child = YGNodeGetChild(root, i);
+    ASSERT_FLOAT_EQ(5 + i * 32, YGNodeLayoutGetTop(child));
+    ASSERT_FLOAT_EQ(30, YGNodeLayoutGetHeight(child));
+  }
+
+  // Moving back keeps the size of children that were laid out before.
+  YGNodeSetVirtualizedWindow(root, 0, 100, 10, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(firstTop, YGNodeLayoutGetTop(first));
+  ASSERT_FLOAT_EQ(30, YGNodeLayoutGetHeight(first));
+  ASSERT_FLOAT_EQ(firstTop + 32, YGNodeLayoutGetTop(YGNodeGetChild(root, 24)));
+
+  YGNodeClearVirtualizedWindow(root);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(5 + 1000 * 32, YGNodeLayoutGetHeight(root));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
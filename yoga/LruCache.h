@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace facebook {
+namespace yoga {
+namespace detail {
+
+// Bits of a float for comparing and hashing keys. Undefined sizes are NaNs,
+// which are all mapped to the same bits.
+inline uint32_t canonicalBits(float value) {
+  if (std::isnan(value)) {
+    value = NAN;
+  }
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Map of bounded size, which evicts the least recently used entry once full.
+// Keys are hashed with Key::Hash. All operations lock the cache, so it can be
+// shared by concurrent layouts.
+template <typename K, typename V>
+class LruCache {
+public:
+  using Key = K;
+  using Value = V;
+
+private:
+  using Entries = std::list<std::pair<Key, Value>>;
+
+  const size_t capacity_;
+  // Most recently used entries first.
+  Entries entries_;
+  std::unordered_map<Key, typename Entries::iterator, typename Key::Hash>
+      index_;
+  mutable std::mutex mutex_;
+
+public:
+  explicit LruCache(size_t capacity) : capacity_(capacity) {}
+
+  LruCache(const LruCache&) = delete;
+  LruCache& operator=(const LruCache&) = delete;
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return entries_.size();
+  }
+
+  // Looks up a value, and marks it as most recently used.
+  bool get(const Key& key, Value* value) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    const auto entry = index_.find(key);
+    if (entry == index_.end()) {
+      return false;
+    }
+    entries_.splice(entries_.begin(), entries_, entry->second);
+    *value = entry->second->second;
+    return true;
+  }
+
+  // Stores a value, evicting the least recently used one if full.
+  void put(const Key& key, Value value) {
+    if (capacity_ == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock{mutex_};
+    const auto entry = index_.find(key);
+    if (entry != index_.end()) {
+      entry->second->second = std::move(value);
+      entries_.splice(entries_.begin(), entries_, entry->second);
+      return;
+    }
+    if (entries_.size() == capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+    entries_.emplace_front(key, std::move(value));
+    index_.emplace(key, entries_.begin());
+  }
+};
+
+} // namespace detail
+} // namespace yoga
+} // namespace facebook
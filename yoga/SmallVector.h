@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace facebook {
+namespace yoga {
+namespace detail {
+
+// Vector of trivially copyable values which stores up to N elements inline,
+// and only allocates once it grows beyond that. Most nodes have few children,
+// so this avoids a heap allocation per container node.
+template <typename T, uint32_t N>
+class SmallVector {
+  static_assert(
+      std::is_trivially_copyable<T>::value,
+      "SmallVector only supports trivially copyable types");
+  static_assert(N > 0, "SmallVector needs an inline capacity");
+
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  SmallVector() noexcept : inline_{} {}
+
+  SmallVector(const T* first, const T* last) : SmallVector() {
+    assign(first, static_cast<size_t>(last - first));
+  }
+
+  SmallVector(std::initializer_list<T> values) : SmallVector() {
+    assign(values.begin(), values.size());
+  }
+
+  SmallVector(const SmallVector& other) : SmallVector() {
+    assign(other.data(), other.size());
+  }
+
+  SmallVector(SmallVector&& other) noexcept : SmallVector() {
+    steal(other);
+  }
+
+  ~SmallVector() {
+    if (!isInline()) {
+      std::free(heap_);
+    }
+  }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      assign(other.data(), other.size());
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept {
+    if (this != &other) {
+      if (!isInline()) {
+        std::free(heap_);
+        capacity_ = N;
+      }
+      size_ = 0;
+      steal(other);
+    }
+    return *this;
+  }
+
+  T* data() noexcept {
+    return isInline() ? inline_ : heap_;
+  }
+  const T* data() const noexcept {
+    return isInline() ? inline_ : heap_;
+  }
+
+  size_t size() const noexcept {
+    return size_;
+  }
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  iterator begin() noexcept {
+    return data();
+  }
+  iterator end() noexcept {
+    return data() + size_;
+  }
+  const_iterator begin() const noexcept {
+    return data();
+  }
+  const_iterator end() const noexcept {
+    return data() + size_;
+  }
+
+  T& operator[](size_t i) noexcept {
+    return data()[i];
+  }
+  const T& operator[](size_t i) const noexcept {
+    return data()[i];
+  }
+
+  const T& at(size_t i) const {
+    if (i >= size_) {
+      throw std::out_of_range("SmallVector index out of range");
+    }
+    return data()[i];
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) {
+      grow(capacity);
+    }
+  }
+
+  void push_back(const T& value) {
+    const T copy = value;
+    if (size_ == capacity_) {
+      grow(capacity_ * 2);
+    }
+    data()[size_++] = copy;
+  }
+
+  iterator insert(const_iterator position, const T& value) {
+    const size_t index = static_cast<size_t>(position - begin());
+    const T copy = value;
+    if (size_ == capacity_) {
+      grow(capacity_ * 2);
+    }
+    T* elements = data();
+    std::memmove(
+        elements + index + 1, elements + index, (size_ - index) * sizeof(T));
+    elements[index] = copy;
+    size_++;
+    return elements + index;
+  }
+
+  iterator erase(const_iterator position) {
+    const size_t index = static_cast<size_t>(position - begin());
+    T* elements = data();
+    std::memmove(
+        elements + index,
+        elements + index + 1,
+        (size_ - index - 1) * sizeof(T));
+    size_--;
+    return elements + index;
+  }
+
+  void clear() noexcept {
+    size_ = 0;
+  }
+
+  // Moves the elements back inline if they fit.
+  void shrink_to_fit() noexcept {
+    if (!isInline() && size_ <= N) {
+      T* heap = heap_;
+      std::memcpy(inline_, heap, size_ * sizeof(T));
+      std::free(heap);
+      capacity_ = N;
+    }
+  }
+
+private:
+  union {
+    T inline_[N];
+    T* heap_;
+  };
+  uint32_t size_ = 0;
+  uint32_t capacity_ = N;
+
+  bool isInline() const noexcept {
+    return capacity_ == N;
+  }
+
+  void assign(const T* values, size_t count) {
+    reserve(count);
+    if (count > 0) {
+      std::memmove(data(), values, count * sizeof(T));
+    }
+    size_ = static_cast<uint32_t>(count);
+  }
+
+  // Takes the elements of other, which must not own the current storage.
+  void steal(SmallVector& other) noexcept {
+    if (other.isInline()) {
+      std::memcpy(inline_, other.inline_, other.size_ * sizeof(T));
+    } else {
+      heap_ = other.heap_;
+      capacity_ = other.capacity_;
+      other.capacity_ = N;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  void grow(size_t capacity) {
+    T* heap = static_cast<T*>(std::malloc(capacity * sizeof(T)));
+    if (heap == nullptr) {
+      throw std::bad_alloc();
+    }
+    std::memcpy(heap, data(), size_ * sizeof(T));
+    if (!isInline()) {
+      std::free(heap_);
+    }
+    heap_ = heap;
+    capacity_ = static_cast<uint32_t>(capacity);
+  }
+};
+
+} // namespace detail
+} // namespace yoga
+} // namespace facebook
@@ -64,3 +64,30 @@ YGFloatOptional YGFloatOptionalMax(YGFloatOptional op1, YGFloatOptional op2) {
   }
   return op1.isUndefined() ? op2 : op1;
 }
+
+void YGHashStyleValues(YGHasher& hasher, const YGStyle& style) {
+  const char* begin = reinterpret_cast<const char*>(&style.flex);
+  hasher.add(begin, reinterpret_cast<const char*>(&style + 1) - begin);
+}
+
+void YGHashStyle(YGHasher& hasher, const YGStyle& style) {
+  hasher.add(style.direction);
+  hasher.add(style.flexDirection);
+  hasher.add(style.justifyContent);
+  hasher.add(style.alignContent);
+  hasher.add(style.alignItems);
+  hasher.add(style.alignSelf);
+  hasher.add(style.positionType);
+  hasher.add(style.flexWrap);
+  hasher.add(style.overflow);
+  hasher.add(style.display);
+  YGHashStyleValues(hasher, style);
+}
+
+void YGHashLayoutConfig(YGHasher& hasher, const YGConfig& config) {
+  hasher.add(config.pointScaleFactor);
+  hasher.add(config.useWebDefaults);
+  hasher.add(config.useLegacyStretchBehaviour);
+  hasher.add(
+      config.experimentalFeatures.data(), config.experimentalFeatures.size());
+}
@@ -140,3 +140,31 @@ inline YGFloatOptional YGResolveValueMargin(
     const float ownerSize) {
   return value.isAuto() ? YGFloatOptional{0} : YGResolveValue(value, ownerSize);
 }
+
+// FNV-1a hash of a sequence of values.
+struct YGHasher {
+  uint64_t hash = 14695981039346656037ull;
+
+  void add(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+  }
+
+  template <typename T>
+  void add(const T value) {
+    add(&value, sizeof(value));
+  }
+};
+
+// Adds the values of a style following its enum bitfields, which are left out,
+// as the unused bits of their storage are not guaranteed to be equal for equal
+// styles.
+void YGHashStyleValues(YGHasher& hasher, const YGStyle& style);
+
+// Adds all properties of a style.
+void YGHashStyle(YGHasher& hasher, const YGStyle& style);
+
+// Adds the config values which layout results depend on.
+void YGHashLayoutConfig(YGHasher& hasher, const YGConfig& config);
@@ -5,7 +5,10 @@
  * file in the root directory of this source tree.
  */
 #pragma once
+#include <memory>
+#include "YGLayoutMemo.h"
 #include "YGMarker.h"
+#include "YGMeasureMemo.h"
 #include "Yoga-internal.h"
 #include "Yoga.h"
 
@@ -40,11 +43,24 @@ public:
   bool useLegacyStretchBehaviour = false;
   bool shouldDiffLayoutWithoutLegacyStretchBehaviour = false;
   bool printTree = false;
+  bool printChanges = false;
+  bool printSkips = false;
   float pointScaleFactor = 1.0f;
   std::array<bool, facebook::yoga::enums::count<YGExperimentalFeature>()>
       experimentalFeatures = {};
   void* context = nullptr;
   YGMarkerCallbacks markerCallbacks = {nullptr, nullptr};
+  YGNodeArena* nodeArena = nullptr;
+  YGLayoutExecutorFunc layoutExecutor = nullptr;
+  uint32_t layoutExecutorMinSubtreeSize = 32;
+  uint32_t measureCacheCapacity = YG_MAX_CACHED_RESULT_COUNT;
+  uint32_t maxMeasureCacheCapacity = 4 * YG_MAX_CACHED_RESULT_COUNT;
+  YGLayoutChangedFunc layoutChanged = nullptr;
+  YGBatchMeasureFunc batchMeasure = nullptr;
+  // Shared with copies of this config, so they can reuse measurements.
+  std::shared_ptr<YGMeasureMemo> measureMemo;
+  // Shared with copies of this config, so they can reuse subtree layouts.
+  std::shared_ptr<YGLayoutMemo> layoutMemo;
 
   YGConfig(YGLogger logger);
   void log(YGConfig*, YGNode*, YGLogLevel, void*, const char*, va_list);
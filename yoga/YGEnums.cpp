@@ -124,6 +124,16 @@ const char* YGJustifyToString(const YGJustify value) {
   return "unknown";
 }
 
+const char* YGLayoutChangeToString(const YGLayoutChange value) {
+  switch (value) {
+    case YGLayoutChangePosition:
+      return "position";
+    case YGLayoutChangeSize:
+      return "size";
+  }
+  return "unknown";
+}
+
 const char* YGLogLevelToString(const YGLogLevel value) {
   switch (value) {
     case YGLogLevelError:
@@ -198,6 +208,16 @@ const char* YGPrintOptionsToString(const YGPrintOptions value) {
   return "unknown";
 }
 
+const char* YGSnapshotOptionsToString(const YGSnapshotOptions value) {
+  switch (value) {
+    case YGSnapshotOptionsLayout:
+      return "layout";
+    case YGSnapshotOptionsLayoutCache:
+      return "layout-cache";
+  }
+  return "unknown";
+}
+
 const char* YGUnitToString(const YGUnit value) {
   switch (value) {
     case YGUnitUndefined:
@@ -104,6 +104,11 @@ YG_ENUM_SEQ_DECL(
     YGJustifySpaceAround,
     YGJustifySpaceEvenly)
 
+YG_ENUM_DECL(
+    YGLayoutChange,
+    YGLayoutChangePosition = 1,
+    YGLayoutChangeSize = 2)
+
 YG_ENUM_SEQ_DECL(
     YGLogLevel,
     YGLogLevelError,
@@ -135,6 +140,12 @@ YG_ENUM_DECL(
     YGPrintOptionsStyle = 2,
     YGPrintOptionsChildren = 4)
 
+YG_ENUM_DECL(
+    YGSnapshotOptions,
+    YGSnapshotOptionsLayout = 1,
+    // Implies YGSnapshotOptionsLayout.
+    YGSnapshotOptionsLayoutCache = 2)
+
 YG_ENUM_SEQ_DECL(
     YGUnit,
     YGUnitUndefined,
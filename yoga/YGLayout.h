@@ -6,6 +6,7 @@
  */
 #pragma once
 #include "YGFloatOptional.h"
+#include "YGMeasurementCache.h"
 #include "Yoga-internal.h"
 
 constexpr std::array<float, 2> kYGDefaultDimensionValues = {
@@ -21,6 +22,8 @@ struct YGLayout {
   bool didUseLegacyFlag : 1;
   bool doesLegacyStretchFlagAffectsLayout : 1;
   bool hadOverflow : 1;
+  // Set when the frame changed since it was last rounded to the pixel grid.
+  bool needsRounding : 1;
 
   uint32_t computedFlexBasisGeneration = 0;
   YGFloatOptional computedFlexBasis = {};
@@ -30,21 +33,29 @@ struct YGLayout {
   uint32_t generationCount = 0;
   YGDirection lastOwnerDirection = (YGDirection) -1;
 
-  uint32_t nextCachedMeasurementsIndex = 0;
-  std::array<YGCachedMeasurement, YG_MAX_CACHED_RESULT_COUNT>
-      cachedMeasurements = {};
+  YGMeasurementCache cachedMeasurements = {};
   std::array<float, 2> measuredDimensions = kYGDefaultDimensionValues;
 
   YGCachedMeasurement cachedLayout = YGCachedMeasurement();
 
+  // Left, top, width and height as computed by layout. When rounding to the
+  // pixel grid, `position` and `dimensions` are set to rounded values, which
+  // are recomputed from these whenever the frame or its absolute position
+  // change.
+  std::array<float, 4> unroundedFrame = {{0, 0, YGUndefined, YGUndefined}};
+  // Absolute unrounded position and point scale factor of the last rounding.
+  std::array<float, 2> roundedAbsolutePosition = {{YGUndefined, YGUndefined}};
+  float roundedPointScaleFactor = 0;
+
   YGLayout()
       : direction(YGDirectionInherit),
         didUseLegacyFlag(false),
         doesLegacyStretchFlagAffectsLayout(false),
-        hadOverflow(false) {}
+        hadOverflow(false),
+        needsRounding(true) {}
 
-  bool operator==(YGLayout layout) const;
-  bool operator!=(YGLayout layout) const {
+  bool operator==(const YGLayout& layout) const;
+  bool operator!=(const YGLayout& layout) const {
     return !(*this == layout);
   }
 };
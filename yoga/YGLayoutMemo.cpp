@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGLayoutMemo.h"
+
+using facebook::yoga::detail::canonicalBits;
+
+bool YGLayoutMemoKey::operator==(const YGLayoutMemoKey& other) const {
+  return subtreeHash == other.subtreeHash && widthMode == other.widthMode &&
+      heightMode == other.heightMode &&
+      ownerDirection == other.ownerDirection &&
+      performLayout == other.performLayout &&
+      canonicalBits(width) == canonicalBits(other.width) &&
+      canonicalBits(height) == canonicalBits(other.height) &&
+      canonicalBits(ownerWidth) == canonicalBits(other.ownerWidth) &&
+      canonicalBits(ownerHeight) == canonicalBits(other.ownerHeight);
+}
+
+size_t YGLayoutMemoKey::Hash::operator()(const YGLayoutMemoKey& key) const {
+  uint64_t hash = key.subtreeHash;
+  hash ^= (static_cast<uint64_t>(canonicalBits(key.width)) << 32) |
+      canonicalBits(key.height);
+  hash *= 0x9e3779b97f4a7c15ull;
+  hash ^= (static_cast<uint64_t>(canonicalBits(key.ownerWidth)) << 32) |
+      canonicalBits(key.ownerHeight);
+  hash ^= static_cast<uint64_t>(key.widthMode) << 5 | key.heightMode << 3 |
+      key.ownerDirection << 1 | key.performLayout;
+  hash ^= hash >> 29;
+  return static_cast<size_t>(hash * 0xbf58476d1ce4e5b9ull);
+}
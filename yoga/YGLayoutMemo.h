@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "LruCache.h"
+#include "YGFloatOptional.h"
+#include "YGStyle.h"
+#include "Yoga-internal.h"
+
+// Subtrees with more nodes are not memoized. Large subtrees rarely repeat, and
+// recording them at every level of a deep tree would cost more than it saves.
+constexpr uint32_t kYGLayoutMemoMaxSubtreeSize = 256;
+
+struct YGLayoutMemoKey {
+  // Structural hash of the subtree, combined with the config values layout
+  // depends on.
+  uint64_t subtreeHash;
+  float width;
+  float height;
+  YGMeasureMode widthMode;
+  YGMeasureMode heightMode;
+  float ownerWidth;
+  float ownerHeight;
+  YGDirection ownerDirection;
+  bool performLayout;
+
+  struct Hash {
+    size_t operator()(const YGLayoutMemoKey& key) const;
+  };
+
+  bool operator==(const YGLayoutMemoKey& other) const;
+};
+
+// Layout results of a single node.
+struct YGMemoizedNodeLayout {
+  // Left, top, width and height before rounding to the pixel grid.
+  std::array<float, 4> frame;
+  std::array<float, 2> trailingPosition;
+  std::array<float, 2> measuredDimensions;
+  std::array<float, 6> margin;
+  std::array<float, 6> border;
+  std::array<float, 6> padding;
+  YGCachedMeasurement cachedLayout;
+  YGFloatOptional computedFlexBasis;
+  YGDirection direction;
+  YGDirection lastOwnerDirection;
+  // Number of children of the node when it was recorded.
+  uint32_t childCount;
+  bool hadOverflow;
+  bool didUseLegacyFlag;
+  bool doesLegacyStretchFlagAffectsLayout;
+};
+
+struct YGMemoizedLayouts {
+  // Style of the subtree root. Subtrees are only looked up by hash, so this
+  // and the child counts of the nodes are compared before results are used.
+  YGSharedStyle rootStyle;
+  // Results of all nodes of the subtree in pre-order for layouts, and of its
+  // root only for measurements.
+  std::vector<YGMemoizedNodeLayout> nodes;
+};
+
+// Bounded memo of subtree layouts, shared by all nodes of a config. Results
+// are keyed by a structural hash of the subtree and the constraints it was
+// laid out with, so that identical subtrees, like the cells of a list, are
+// laid out once and have the results copied into all others. Results stay
+// valid after being evicted.
+using YGLayoutMemo = facebook::yoga::detail::
+    LruCache<YGLayoutMemoKey, std::shared_ptr<const YGMemoizedLayouts>>;
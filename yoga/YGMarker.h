@@ -25,6 +25,9 @@ typedef struct {
   int maxMeasureCache;
   int cachedLayouts;
   int cachedMeasures;
+  int measureCacheMisses;
+  int measureCacheEvictions;
+  int memoizedLayouts;
 } YGMarkerLayoutData;
 
 typedef struct {
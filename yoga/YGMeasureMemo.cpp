@@ -0,0 +1,37 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGMeasureMemo.h"
+
+using facebook::yoga::detail::canonicalBits;
+
+YGMeasureMemoKey::YGMeasureMemoKey(
+    uint64_t contentKey,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode)
+    : contentKey(contentKey),
+      width(width),
+      widthMode(widthMode),
+      height(height),
+      heightMode(heightMode) {}
+
+bool YGMeasureMemoKey::operator==(const YGMeasureMemoKey& other) const {
+  return contentKey == other.contentKey && widthMode == other.widthMode &&
+      heightMode == other.heightMode &&
+      canonicalBits(width) == canonicalBits(other.width) &&
+      canonicalBits(height) == canonicalBits(other.height);
+}
+
+size_t YGMeasureMemoKey::Hash::operator()(const YGMeasureMemoKey& key) const {
+  uint64_t hash = key.contentKey * 0x9e3779b97f4a7c15ull;
+  hash ^= (static_cast<uint64_t>(canonicalBits(key.width)) << 32) |
+      canonicalBits(key.height);
+  hash ^= static_cast<uint64_t>(key.widthMode) << 3 | key.heightMode;
+  hash ^= hash >> 29;
+  return static_cast<size_t>(hash * 0xbf58476d1ce4e5b9ull);
+}
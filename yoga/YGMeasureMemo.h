@@ -0,0 +1,37 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+#include <cstdint>
+#include "LruCache.h"
+#include "Yoga.h"
+
+struct YGMeasureMemoKey {
+  uint64_t contentKey;
+  float width;
+  YGMeasureMode widthMode;
+  float height;
+  YGMeasureMode heightMode;
+
+  struct Hash {
+    size_t operator()(const YGMeasureMemoKey& key) const;
+  };
+
+  YGMeasureMemoKey(
+      uint64_t contentKey,
+      float width,
+      YGMeasureMode widthMode,
+      float height,
+      YGMeasureMode heightMode);
+
+  bool operator==(const YGMeasureMemoKey& other) const;
+};
+
+// Bounded memo of measure function results, shared by all nodes of a config.
+// Results are keyed by a content key supplied by the client, so that nodes
+// which measure identically share one measurement.
+using YGMeasureMemo =
+    facebook::yoga::detail::LruCache<YGMeasureMemoKey, YGSize>;
@@ -0,0 +1,420 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGMeasurementCache.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// Header of a cache allocation, followed by `capacity` slots.
+struct YGMeasurementCache::Storage {
+  struct Slot {
+    YGCachedMeasurement measurement;
+    float effectiveWidth;
+    float effectiveHeight;
+    // Value of `clock` when the entry was last recorded or used.
+    uint32_t lastUsed;
+  };
+
+  uint32_t capacity;
+  uint32_t size;
+  uint32_t clock;
+  // Number of entries replaced since the cache was allocated or last grew.
+  uint32_t evictions;
+  // Point scale factor the effective sizes were rounded with.
+  float pointScaleFactor;
+
+  Slot* slots() {
+    return reinterpret_cast<Slot*>(this + 1);
+  }
+  const Slot* slots() const {
+    return reinterpret_cast<const Slot*>(this + 1);
+  }
+
+  static constexpr size_t bytes(size_t capacity) {
+    return sizeof(Storage) + capacity * sizeof(Slot);
+  }
+};
+
+namespace {
+
+using Storage = YGMeasurementCache::Storage;
+
+// Caches of the default capacity are allocated from chunks of blocks owned by
+// the thread that allocated them, so that concurrent layouts never wait for
+// each other. A block can be released on any thread. Blocks released by the
+// owning thread go straight back to its chunk, others are pushed onto a lock
+// free list of the chunk, which the owner collects once it runs out of blocks.
+// Chunks are freed once none of their blocks are in use, except for the last
+// chunk of a thread. Chunks of threads that exited are freed by whichever
+// thread releases their last block.
+constexpr uint32_t kPooledCapacity = YG_MAX_CACHED_RESULT_COUNT;
+constexpr size_t kBlocksPerChunk = 64;
+// Set in Chunk::liveBlocks once the owning thread exited.
+constexpr uint32_t kAbandoned = 1u << 31;
+
+struct Chunk;
+
+struct Block {
+  // Null for blocks allocated on their own.
+  Chunk* chunk;
+  union {
+    Block* nextFree;
+    alignas(Storage) unsigned char storage[Storage::bytes(kPooledCapacity)];
+  };
+
+  static Block* of(void* storage) {
+    return reinterpret_cast<Block*>(
+        static_cast<unsigned char*>(storage) - offsetof(Block, storage));
+  }
+};
+
+struct Chunk {
+  const uint64_t ownerId;
+  // Number of blocks in use, plus kAbandoned once the owner exited.
+  std::atomic<uint32_t> liveBlocks{0};
+  // Blocks released by other threads.
+  std::atomic<Block*> remoteFreeList{nullptr};
+  // Only used by the owner.
+  Block* freeList;
+  Block blocks[kBlocksPerChunk];
+
+  explicit Chunk(uint64_t ownerId) : ownerId(ownerId), freeList(blocks) {
+    for (size_t i = 0; i < kBlocksPerChunk; i++) {
+      blocks[i].chunk = this;
+      blocks[i].nextFree = i + 1 < kBlocksPerChunk ? &blocks[i + 1] : nullptr;
+    }
+  }
+
+  // Moves the blocks released by other threads to the free list.
+  void collectRemoteFrees() {
+    Block* block = remoteFreeList.exchange(nullptr, std::memory_order_acquire);
+    while (block != nullptr) {
+      Block* next = block->nextFree;
+      block->nextFree = freeList;
+      freeList = block;
+      block = next;
+    }
+  }
+};
+
+// Id of the pool of the current thread, 0 before it is created and after it
+// is destroyed. Trivially destructible, so that it can be read at any time.
+thread_local uint64_t currentPoolId = 0;
+thread_local bool isCurrentPoolDestroyed = false;
+
+class StoragePool {
+  const uint64_t id_;
+  std::vector<Chunk*> chunks_;
+  // Index of the chunk blocks are taken from.
+  size_t current_ = 0;
+
+  static uint64_t nextId() {
+    static std::atomic<uint64_t> lastId{0};
+    return lastId.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  // Finds a chunk with a free block, freeing the unused chunks found on the
+  // way, or adds a new chunk.
+  Chunk* findFreeChunk() {
+    Chunk* found = nullptr;
+    for (size_t i = 0; i < chunks_.size();) {
+      Chunk* chunk = chunks_[i];
+      chunk->collectRemoteFrees();
+      if (found == nullptr && chunk->freeList != nullptr) {
+        found = chunk;
+      } else if (chunk->liveBlocks.load(std::memory_order_acquire) == 0) {
+        chunks_[i] = chunks_.back();
+        chunks_.pop_back();
+        delete chunk;
+        continue;
+      }
+      i++;
+    }
+    if (found == nullptr) {
+      found = new Chunk(id_);
+      chunks_.push_back(found);
+    }
+    current_ = std::find(chunks_.begin(), chunks_.end(), found) -
+        chunks_.begin();
+    return found;
+  }
+
+public:
+  StoragePool() : id_(nextId()) {
+    currentPoolId = id_;
+  }
+
+  ~StoragePool() {
+    for (Chunk* chunk : chunks_) {
+      if (chunk->liveBlocks.fetch_add(kAbandoned, std::memory_order_acq_rel) ==
+          0) {
+        delete chunk;
+      }
+    }
+    currentPoolId = 0;
+    isCurrentPoolDestroyed = true;
+  }
+
+  StoragePool(const StoragePool&) = delete;
+  StoragePool& operator=(const StoragePool&) = delete;
+
+  void* acquire() {
+    Chunk* chunk = current_ < chunks_.size() ? chunks_[current_] : nullptr;
+    if (chunk == nullptr || chunk->freeList == nullptr) {
+      chunk = findFreeChunk();
+    }
+    Block* block = chunk->freeList;
+    chunk->freeList = block->nextFree;
+    chunk->liveBlocks.fetch_add(1, std::memory_order_relaxed);
+    return block->storage;
+  }
+
+  // Releases a block of a chunk of this pool.
+  void release(Block* block) {
+    Chunk* chunk = block->chunk;
+    block->nextFree = chunk->freeList;
+    chunk->freeList = block;
+    if (chunk->liveBlocks.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+        chunks_.size() > 1) {
+      const auto it = std::find(chunks_.begin(), chunks_.end(), chunk);
+      *it = chunks_.back();
+      chunks_.pop_back();
+      current_ = 0;
+      delete chunk;
+    }
+  }
+
+  static StoragePool& current() {
+    static thread_local StoragePool pool;
+    return pool;
+  }
+};
+
+void* acquirePooledStorage() {
+  if (!isCurrentPoolDestroyed) {
+    return StoragePool::current().acquire();
+  }
+  // Caches allocated while the thread exits get a block of their own.
+  Block* block = static_cast<Block*>(std::malloc(sizeof(Block)));
+  if (block == nullptr) {
+    return nullptr;
+  }
+  block->chunk = nullptr;
+  return block->storage;
+}
+
+void releasePooledStorage(void* storage) {
+  Block* block = Block::of(storage);
+  Chunk* chunk = block->chunk;
+  if (chunk == nullptr) {
+    std::free(block);
+  } else if (chunk->ownerId == currentPoolId) {
+    StoragePool::current().release(block);
+  } else {
+    Block* next = chunk->remoteFreeList.load(std::memory_order_relaxed);
+    do {
+      block->nextFree = next;
+    } while (!chunk->remoteFreeList.compare_exchange_weak(
+        next, block, std::memory_order_release, std::memory_order_relaxed));
+    if (chunk->liveBlocks.fetch_sub(1, std::memory_order_acq_rel) ==
+        kAbandoned + 1) {
+      delete chunk;
+    }
+  }
+}
+
+Storage* acquireStorage(uint32_t capacity, float pointScaleFactor) {
+  void* memory = capacity == kPooledCapacity
+      ? acquirePooledStorage()
+      : std::malloc(Storage::bytes(capacity));
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  Storage* storage = new (memory) Storage{capacity, 0, 0, 0, pointScaleFactor};
+  for (uint32_t i = 0; i < capacity; i++) {
+    new (&storage->slots()[i]) Storage::Slot{YGCachedMeasurement(), 0, 0, 0};
+  }
+  return storage;
+}
+
+void releaseStorage(Storage* storage) {
+  if (storage->capacity == kPooledCapacity) {
+    releasePooledStorage(storage);
+  } else {
+    std::free(storage);
+  }
+}
+
+// Copies the recorded entries and bookkeeping of `from`, which must fit.
+void copyStorage(Storage* to, const Storage* from) {
+  to->size = from->size;
+  to->clock = from->clock;
+  to->evictions = from->evictions;
+  to->pointScaleFactor = from->pointScaleFactor;
+  std::memcpy(
+      to->slots(), from->slots(), from->size * sizeof(Storage::Slot));
+}
+
+} // namespace
+
+YGMeasurementCache::YGMeasurementCache(const YGMeasurementCache& other) {
+  if (other.storage_ != nullptr) {
+    storage_ = acquireStorage(
+        other.storage_->capacity, other.storage_->pointScaleFactor);
+    copyStorage(storage_, other.storage_);
+  }
+}
+
+YGMeasurementCache& YGMeasurementCache::operator=(
+    const YGMeasurementCache& other) {
+  if (other.storage_ == nullptr) {
+    release();
+  } else if (this != &other) {
+    if (storage_ == nullptr || storage_->capacity != other.storage_->capacity) {
+      release();
+      storage_ = acquireStorage(
+          other.storage_->capacity, other.storage_->pointScaleFactor);
+    }
+    copyStorage(storage_, other.storage_);
+  }
+  return *this;
+}
+
+YGMeasurementCache& YGMeasurementCache::operator=(
+    YGMeasurementCache&& other) noexcept {
+  if (this != &other) {
+    release();
+    storage_ = other.storage_;
+    other.storage_ = nullptr;
+  }
+  return *this;
+}
+
+void YGMeasurementCache::release() {
+  if (storage_ != nullptr) {
+    releaseStorage(storage_);
+    storage_ = nullptr;
+  }
+}
+
+void YGMeasurementCache::allocate(uint32_t capacity, float pointScaleFactor) {
+  Storage* storage = acquireStorage(capacity, pointScaleFactor);
+  if (storage_ != nullptr) {
+    copyStorage(storage, storage_);
+    storage->evictions = 0;
+    releaseStorage(storage_);
+  }
+  storage_ = storage;
+}
+
+size_t YGMeasurementCache::size() const {
+  return storage_ != nullptr ? storage_->size : 0;
+}
+
+size_t YGMeasurementCache::capacity() const {
+  return storage_ != nullptr ? storage_->capacity : 0;
+}
+
+const YGCachedMeasurement& YGMeasurementCache::operator[](size_t i) const {
+  return storage_->slots()[i].measurement;
+}
+
+YGCachedMeasurement& YGMeasurementCache::operator[](size_t i) {
+  return storage_->slots()[i].measurement;
+}
+
+float YGMeasurementCache::effectiveWidth(size_t i) const {
+  return storage_->slots()[i].effectiveWidth;
+}
+
+float YGMeasurementCache::effectiveHeight(size_t i) const {
+  return storage_->slots()[i].effectiveHeight;
+}
+
+void YGMeasurementCache::setPointScaleFactor(float pointScaleFactor) {
+  if (storage_ == nullptr || storage_->pointScaleFactor == pointScaleFactor) {
+    return;
+  }
+  storage_->pointScaleFactor = pointScaleFactor;
+  for (uint32_t i = 0; i < storage_->size; i++) {
+    Storage::Slot& slot = storage_->slots()[i];
+    slot.effectiveWidth =
+        effectiveSize(slot.measurement.availableWidth, pointScaleFactor);
+    slot.effectiveHeight =
+        effectiveSize(slot.measurement.availableHeight, pointScaleFactor);
+  }
+}
+
+void YGMeasurementCache::markUsed(const YGCachedMeasurement& entry) {
+  const size_t i = reinterpret_cast<const Storage::Slot*>(&entry) -
+      storage_->slots();
+  storage_->slots()[i].lastUsed = ++storage_->clock;
+}
+
+const YGCachedMeasurement& YGMeasurementCache::add(
+    const YGCachedMeasurement& measurement,
+    const Limits& limits,
+    const float pointScaleFactor,
+    bool* evicted) {
+  *evicted = false;
+  if (storage_ == nullptr) {
+    allocate(std::max(limits.initialCapacity, 1u), pointScaleFactor);
+  } else {
+    setPointScaleFactor(pointScaleFactor);
+  }
+
+  Storage::Slot* slot;
+  if (storage_->size < storage_->capacity) {
+    slot = &storage_->slots()[storage_->size++];
+  } else if (
+      storage_->capacity < limits.maxCapacity &&
+      storage_->evictions >= storage_->capacity) {
+    allocate(
+        std::min(storage_->capacity * 2, limits.maxCapacity),
+        pointScaleFactor);
+    slot = &storage_->slots()[storage_->size++];
+  } else {
+    // The clock may wrap around, which at worst replaces a recent entry once.
+    slot = storage_->slots();
+    for (uint32_t i = 1; i < storage_->size; i++) {
+      if (storage_->slots()[i].lastUsed < slot->lastUsed) {
+        slot = &storage_->slots()[i];
+      }
+    }
+    storage_->evictions++;
+    *evicted = true;
+  }
+  slot->measurement = measurement;
+  slot->effectiveWidth =
+      effectiveSize(measurement.availableWidth, pointScaleFactor);
+  slot->effectiveHeight =
+      effectiveSize(measurement.availableHeight, pointScaleFactor);
+  slot->lastUsed = ++storage_->clock;
+  return slot->measurement;
+}
+
+void YGMeasurementCache::clear() {
+  if (storage_ != nullptr) {
+    storage_->size = 0;
+  }
+}
+
+bool YGMeasurementCache::operator==(const YGMeasurementCache& other) const {
+  if (size() != other.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < size(); i++) {
+    if (!((*this)[i] == other[i])) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+#include "Yoga-internal.h"
+
+// Measurement cache of a single node. Only nodes which get measured before
+// being laid out record measurements, so the entries are allocated on first
+// use, from a pool of the allocating thread for caches of the default
+// capacity, instead of being embedded in every YGLayout.
+//
+// Once all entries are in use, recording a measurement replaces the least
+// recently used entry. Caches of nodes that keep missing, i.e. which replaced
+// as many entries as they hold, double their capacity instead, up to a limit.
+//
+// Lookups compare available sizes after rounding them to the pixel grid, so
+// every entry also keeps its available sizes rounded for the point scale
+// factor of the last lookup.
+class YGMeasurementCache {
+public:
+  struct Limits {
+    // Capacity a cache is allocated with.
+    uint32_t initialCapacity;
+    // Capacity a cache can grow to.
+    uint32_t maxCapacity;
+  };
+
+  struct Storage;
+
+private:
+  Storage* storage_ = nullptr;
+
+  void release();
+  void allocate(uint32_t capacity, float pointScaleFactor);
+
+public:
+  YGMeasurementCache() = default;
+  YGMeasurementCache(const YGMeasurementCache& other);
+  YGMeasurementCache(YGMeasurementCache&& other) noexcept
+      : storage_(other.storage_) {
+    other.storage_ = nullptr;
+  }
+  ~YGMeasurementCache() {
+    release();
+  }
+
+  YGMeasurementCache& operator=(const YGMeasurementCache& other);
+  YGMeasurementCache& operator=(YGMeasurementCache&& other) noexcept;
+
+  bool isAllocated() const {
+    return storage_ != nullptr;
+  }
+
+  // Number of recorded measurements.
+  size_t size() const;
+  size_t capacity() const;
+
+  const YGCachedMeasurement& operator[](size_t i) const;
+  YGCachedMeasurement& operator[](size_t i);
+
+  // Available sizes of an entry, rounded like effectiveSize does.
+  float effectiveWidth(size_t i) const;
+  float effectiveHeight(size_t i) const;
+
+  // Size used when comparing available sizes, which is rounded to the pixel
+  // grid unless rounding is disabled.
+  static float effectiveSize(float size, float pointScaleFactor) {
+    return pointScaleFactor != 0
+        ? YGRoundValueToPixelGrid(size, pointScaleFactor, false, false)
+        : size;
+  }
+
+  // Rounds the available sizes of all entries again if they were rounded
+  // with a different point scale factor.
+  void setPointScaleFactor(float pointScaleFactor);
+
+  // Marks an entry as most recently used.
+  void markUsed(const YGCachedMeasurement& entry);
+
+  // Records a measurement, and returns whether it replaced a previous one.
+  const YGCachedMeasurement& add(
+      const YGCachedMeasurement& measurement,
+      const Limits& limits,
+      float pointScaleFactor,
+      bool* evicted);
+
+  // Forgets all measurements. The capacity is kept.
+  void clear();
+
+  bool operator==(const YGMeasurementCache& other) const;
+};
@@ -14,7 +14,6 @@ using namespace facebook;
 using facebook::yoga::detail::CompactValue;
 
 YGNode::YGNode(YGNode&& node) {
-  context_ = node.context_;
   hasNewLayout_ = node.hasNewLayout_;
   isReferenceBaseline_ = node.isReferenceBaseline_;
   isDirty_ = node.isDirty_;
@@ -22,28 +21,35 @@ YGNode::YGNode(YGNode&& node) {
   measureUsesContext_ = node.measureUsesContext_;
   baselineUsesContext_ = node.baselineUsesContext_;
   printUsesContext_ = node.printUsesContext_;
-  measure_ = node.measure_;
-  baseline_ = node.baseline_;
-  print_ = node.print_;
-  dirtied_ = node.dirtied_;
-  style_ = node.style_;
-  layout_ = node.layout_;
+  isArenaAllocated_ = false;
+  hasPlainStackSummary_ = node.hasPlainStackSummary_;
+  isPlainStack_ = node.isPlainStack_;
+  hasSubtreeHash_ = node.hasSubtreeHash_;
+  isVirtualized_ = node.isVirtualized_;
+  hasStackLayoutState_ = node.hasStackLayoutState_;
   lineIndex_ = node.lineIndex_;
   owner_ = node.owner_;
   children_ = std::move(node.children_);
   config_ = node.config_;
+  measure_ = node.measure_;
+  context_ = node.context_;
   resolvedDimensions_ = node.resolvedDimensions_;
+  cold_ = std::move(node.cold_);
+  stackLayoutState_ = node.stackLayoutState_;
+  layout_ = node.layout_;
+  style_ = node.style_;
   for (auto c : children_) {
     c->setOwner(c);
   }
 }
 
 void YGNode::print(void* printContext) {
-  if (print_.noContext != nullptr) {
+  const ColdData* cold = cold_.get();
+  if (cold != nullptr && cold->print.noContext != nullptr) {
     if (printUsesContext_) {
-      print_.withContext(this, printContext);
+      cold->print.withContext(this, printContext);
     } else {
-      print_.noContext(this);
+      cold->print.noContext(this);
     }
   }
 }
@@ -53,14 +59,14 @@ YGFloatOptional YGNode::getLeadingPosition(
     const float axisSize) const {
   if (YGFlexDirectionIsRow(axis)) {
     auto leadingPosition = YGComputedEdgeValue(
-        style_.position, YGEdgeStart, CompactValue::ofUndefined());
+        getStyle().position, YGEdgeStart, CompactValue::ofUndefined());
     if (!leadingPosition.isUndefined()) {
       return YGResolveValue(leadingPosition, axisSize);
     }
   }
 
   auto leadingPosition = YGComputedEdgeValue(
-      style_.position, leading[axis], CompactValue::ofUndefined());
+      getStyle().position, leading[axis], CompactValue::ofUndefined());
 
   return leadingPosition.isUndefined()
       ? YGFloatOptional{0}
@@ -72,14 +78,14 @@ YGFloatOptional YGNode::getTrailingPosition(
     const float axisSize) const {
   if (YGFlexDirectionIsRow(axis)) {
     auto trailingPosition = YGComputedEdgeValue(
-        style_.position, YGEdgeEnd, CompactValue::ofUndefined());
+        getStyle().position, YGEdgeEnd, CompactValue::ofUndefined());
     if (!trailingPosition.isUndefined()) {
       return YGResolveValue(trailingPosition, axisSize);
     }
   }
 
   auto trailingPosition = YGComputedEdgeValue(
-      style_.position, trailing[axis], CompactValue::ofUndefined());
+      getStyle().position, trailing[axis], CompactValue::ofUndefined());
 
   return trailingPosition.isUndefined()
       ? YGFloatOptional{0}
@@ -89,45 +95,48 @@ YGFloatOptional YGNode::getTrailingPosition(
 bool YGNode::isLeadingPositionDefined(const YGFlexDirection axis) const {
   return (YGFlexDirectionIsRow(axis) &&
           !YGComputedEdgeValue(
-               style_.position, YGEdgeStart, CompactValue::ofUndefined())
+               getStyle().position, YGEdgeStart, CompactValue::ofUndefined())
                .isUndefined()) ||
       !YGComputedEdgeValue(
-           style_.position, leading[axis], CompactValue::ofUndefined())
+           getStyle().position, leading[axis], CompactValue::ofUndefined())
            .isUndefined();
 }
 
 bool YGNode::isTrailingPosDefined(const YGFlexDirection axis) const {
   return (YGFlexDirectionIsRow(axis) &&
           !YGComputedEdgeValue(
-               style_.position, YGEdgeEnd, CompactValue::ofUndefined())
+               getStyle().position, YGEdgeEnd, CompactValue::ofUndefined())
                .isUndefined()) ||
       !YGComputedEdgeValue(
-           style_.position, trailing[axis], CompactValue::ofUndefined())
+           getStyle().position, trailing[axis], CompactValue::ofUndefined())
            .isUndefined();
 }
 
 YGFloatOptional YGNode::getLeadingMargin(
     const YGFlexDirection axis,
     const float widthSize) const {
-  if (YGFlexDirectionIsRow(axis) && !style_.margin[YGEdgeStart].isUndefined()) {
-    return YGResolveValueMargin(style_.margin[YGEdgeStart], widthSize);
+  if (YGFlexDirectionIsRow(axis) &&
+      !getStyle().margin[YGEdgeStart].isUndefined()) {
+    return YGResolveValueMargin(getStyle().margin[YGEdgeStart], widthSize);
   }
 
   return YGResolveValueMargin(
-      YGComputedEdgeValue(style_.margin, leading[axis], CompactValue::ofZero()),
+      YGComputedEdgeValue(
+          getStyle().margin, leading[axis], CompactValue::ofZero()),
       widthSize);
 }
 
 YGFloatOptional YGNode::getTrailingMargin(
     const YGFlexDirection axis,
     const float widthSize) const {
-  if (YGFlexDirectionIsRow(axis) && !style_.margin[YGEdgeEnd].isUndefined()) {
-    return YGResolveValueMargin(style_.margin[YGEdgeEnd], widthSize);
+  if (YGFlexDirectionIsRow(axis) &&
+      !getStyle().margin[YGEdgeEnd].isUndefined()) {
+    return YGResolveValueMargin(getStyle().margin[YGEdgeEnd], widthSize);
   }
 
   return YGResolveValueMargin(
       YGComputedEdgeValue(
-          style_.margin, trailing[axis], CompactValue::ofZero()),
+          getStyle().margin, trailing[axis], CompactValue::ofZero()),
       widthSize);
 }
 
@@ -151,9 +160,10 @@ YGSize YGNode::measure(
 }
 
 float YGNode::baseline(float width, float height, void* layoutContext) {
+  const ColdData* cold = cold_.get();
   return baselineUsesContext_
-      ? baseline_.withContext(this, width, height, layoutContext)
-      : baseline_.noContext(this, width, height);
+      ? cold->baseline.withContext(this, width, height, layoutContext)
+      : cold->baseline.noContext(this, width, height);
 }
 
 // Setters
@@ -175,6 +185,7 @@ void YGNode::setMeasureFunc(decltype(YGNode::measure_) measureFunc) {
   }
 
   measure_ = measureFunc;
+  invalidateSubtreeHash();
 }
 
 void YGNode::setMeasureFunc(YGMeasureFunc measureFunc) {
@@ -208,14 +219,16 @@ void YGNode::setDirty(bool isDirty) {
     return;
   }
   isDirty_ = isDirty;
-  if (isDirty && dirtied_) {
-    dirtied_(this);
+  if (isDirty) {
+    hasPlainStackSummary_ = false;
+    if (YGDirtiedFunc dirtied = getDirtied()) {
+      dirtied(this);
+    }
   }
 }
 
 bool YGNode::removeChild(YGNodeRef child) {
-  std::vector<YGNodeRef>::iterator p =
-      std::find(children_.begin(), children_.end(), child);
+  YGVector::iterator p = std::find(children_.begin(), children_.end(), child);
   if (p != children_.end()) {
     children_.erase(p);
     return true;
@@ -254,6 +267,32 @@ void YGNode::setLayoutComputedFlexBasis(
 
 void YGNode::setLayoutPosition(float position, int index) {
   layout_.position[index] = position;
+  if (index == YGEdgeLeft || index == YGEdgeTop) {
+    layout_.unroundedFrame[index] = position;
+    layout_.needsRounding = true;
+  }
+}
+
+int YGNode::updateReportedFrame() {
+  const std::array<float, 4> frame = {{layout_.position[YGEdgeLeft],
+                                       layout_.position[YGEdgeTop],
+                                       layout_.dimensions[YGDimensionWidth],
+                                       layout_.dimensions[YGDimensionHeight]}};
+  std::array<float, 4>& reportedFrame = cold_.getOrCreate().reportedFrame;
+  const auto changed = [&](size_t i) {
+    return frame[i] != reportedFrame[i] &&
+        !(std::isnan(frame[i]) && std::isnan(reportedFrame[i]));
+  };
+
+  int changes = 0;
+  if (changed(0) || changed(1)) {
+    changes |= YGLayoutChangePosition;
+  }
+  if (changed(2) || changed(3)) {
+    changes |= YGLayoutChangeSize;
+  }
+  reportedFrame = frame;
+  return changes;
 }
 
 void YGNode::setLayoutComputedFlexBasisGeneration(
@@ -271,6 +310,8 @@ void YGNode::setLayoutHadOverflow(bool hadOverflow) {
 
 void YGNode::setLayoutDimension(float dimension, int index) {
   layout_.dimensions[index] = dimension;
+  layout_.unroundedFrame[2 + index] = dimension;
+  layout_.needsRounding = true;
 }
 
 // If both left and right are defined, then use left. Otherwise return +left or
@@ -299,7 +340,7 @@ void YGNode::setPosition(
   const YGDirection directionRespectingRoot =
       owner_ != nullptr ? direction : YGDirectionLTR;
   const YGFlexDirection mainAxis =
-      YGResolveFlexDirection(style_.flexDirection, directionRespectingRoot);
+      YGResolveFlexDirection(getStyle().flexDirection, directionRespectingRoot);
   const YGFlexDirection crossAxis =
       YGFlexDirectionCross(mainAxis, directionRespectingRoot);
 
@@ -325,27 +366,29 @@ void YGNode::setPosition(
 }
 
 YGValue YGNode::marginLeadingValue(const YGFlexDirection axis) const {
-  if (YGFlexDirectionIsRow(axis) && !style_.margin[YGEdgeStart].isUndefined()) {
-    return style_.margin[YGEdgeStart];
+  if (YGFlexDirectionIsRow(axis) &&
+      !getStyle().margin[YGEdgeStart].isUndefined()) {
+    return getStyle().margin[YGEdgeStart];
   } else {
-    return style_.margin[leading[axis]];
+    return getStyle().margin[leading[axis]];
   }
 }
 
 YGValue YGNode::marginTrailingValue(const YGFlexDirection axis) const {
-  if (YGFlexDirectionIsRow(axis) && !style_.margin[YGEdgeEnd].isUndefined()) {
-    return style_.margin[YGEdgeEnd];
+  if (YGFlexDirectionIsRow(axis) &&
+      !getStyle().margin[YGEdgeEnd].isUndefined()) {
+    return getStyle().margin[YGEdgeEnd];
   } else {
-    return style_.margin[trailing[axis]];
+    return getStyle().margin[trailing[axis]];
   }
 }
 
 YGValue YGNode::resolveFlexBasisPtr() const {
-  YGValue flexBasis = style_.flexBasis;
+  YGValue flexBasis = getStyle().flexBasis;
   if (flexBasis.unit != YGUnitAuto && flexBasis.unit != YGUnitUndefined) {
     return flexBasis;
   }
-  if (!style_.flex.isUndefined() && style_.flex.unwrap() > 0.0f) {
+  if (!getStyle().flex.isUndefined() && getStyle().flex.unwrap() > 0.0f) {
     return config_->useWebDefaults ? YGValueAuto : YGValueZero;
   }
   return YGValueAuto;
@@ -356,20 +399,20 @@ void YGNode::resolveDimension() {
   for (int dim = YGDimensionWidth; dim < enums::count<YGDimension>(); dim++) {
     if (!getStyle().maxDimensions[dim].isUndefined() &&
         YGValueEqual(
-            getStyle().maxDimensions[dim], style_.minDimensions[dim])) {
-      resolvedDimensions_[dim] = style_.maxDimensions[dim];
+            getStyle().maxDimensions[dim], getStyle().minDimensions[dim])) {
+      resolvedDimensions_[dim] = getStyle().maxDimensions[dim];
     } else {
-      resolvedDimensions_[dim] = style_.dimensions[dim];
+      resolvedDimensions_[dim] = getStyle().dimensions[dim];
     }
   }
 }
 
 YGDirection YGNode::resolveDirection(const YGDirection ownerDirection) {
-  if (style_.direction == YGDirectionInherit) {
+  if (getStyle().direction == YGDirectionInherit) {
     return ownerDirection > YGDirectionInherit ? ownerDirection
                                                : YGDirectionLTR;
   } else {
-    return style_.direction;
+    return getStyle().direction;
   }
 }
 
@@ -380,23 +423,52 @@ void YGNode::clearChildren() {
 
 // Other Methods
 
-void YGNode::cloneChildrenIfNeeded(void* cloneContext) {
-  iterChildrenAfterCloningIfNeeded([](YGNodeRef, void*) {}, cloneContext);
+void YGNode::cloneChildrenIfNeeded(
+    void* cloneContext,
+    YGCloneNodeFunc cloneNode) {
+  iterChildrenAfterCloningIfNeeded(
+      [](YGNodeRef, void*) {}, cloneContext, cloneNode);
+}
+
+void YGNode::invalidateSubtreeHash() {
+  for (YGNodeRef node = this; node != nullptr && node->hasSubtreeHash_;
+       node = node->owner_) {
+    node->hasSubtreeHash_ = false;
+  }
 }
 
 void YGNode::markDirtyAndPropogate() {
+  // Nodes which are dirty already can still change, so this is not covered by
+  // marking ancestors dirty.
+  invalidateSubtreeHash();
+  hasStackLayoutState_ = false;
   if (!isDirty_) {
     setDirty(true);
     setLayoutComputedFlexBasis(YGFloatOptional());
     if (owner_) {
-      owner_->markDirtyAndPropogate();
+      owner_->markDirtyAndPropogateFromChild(this);
     }
   }
 }
 
+void YGNode::markDirtyAndPropogateFromChild(const YGNode* child) {
+  bool isAppendedChild = false;
+  if (hasStackLayoutState_) {
+    const size_t laidOutChildCount =
+        std::min<size_t>(stackLayoutState_.childCount, children_.size());
+    const auto appended = children_.begin() + laidOutChildCount;
+    isAppendedChild =
+        std::find(appended, children_.end(), child) != children_.end();
+  }
+  markDirtyAndPropogate();
+  hasStackLayoutState_ = isAppendedChild;
+}
+
 void YGNode::markDirtyAndPropogateDownwards() {
   isDirty_ = true;
-  for_each(children_.begin(), children_.end(), [](YGNodeRef childNode) {
+  hasPlainStackSummary_ = false;
+  hasStackLayoutState_ = false;
+  std::for_each(children_.begin(), children_.end(), [](YGNodeRef childNode) {
     childNode->markDirtyAndPropogateDownwards();
   });
 }
@@ -406,11 +478,11 @@ float YGNode::resolveFlexGrow() {
   if (owner_ == nullptr) {
     return 0.0;
   }
-  if (!style_.flexGrow.isUndefined()) {
-    return style_.flexGrow.unwrap();
+  if (!getStyle().flexGrow.isUndefined()) {
+    return getStyle().flexGrow.unwrap();
   }
-  if (!style_.flex.isUndefined() && style_.flex.unwrap() > 0.0f) {
-    return style_.flex.unwrap();
+  if (!getStyle().flex.isUndefined() && getStyle().flex.unwrap() > 0.0f) {
+    return getStyle().flex.unwrap();
   }
   return kDefaultFlexGrow;
 }
@@ -419,48 +491,49 @@ float YGNode::resolveFlexShrink() {
   if (owner_ == nullptr) {
     return 0.0;
   }
-  if (!style_.flexShrink.isUndefined()) {
-    return style_.flexShrink.unwrap();
+  if (!getStyle().flexShrink.isUndefined()) {
+    return getStyle().flexShrink.unwrap();
   }
-  if (!config_->useWebDefaults && !style_.flex.isUndefined() &&
-      style_.flex.unwrap() < 0.0f) {
-    return -style_.flex.unwrap();
+  if (!config_->useWebDefaults && !getStyle().flex.isUndefined() &&
+      getStyle().flex.unwrap() < 0.0f) {
+    return -getStyle().flex.unwrap();
   }
   return config_->useWebDefaults ? kWebDefaultFlexShrink : kDefaultFlexShrink;
 }
 
 bool YGNode::isNodeFlexible() {
   return (
-      (style_.positionType == YGPositionTypeRelative) &&
+      (getStyle().positionType == YGPositionTypeRelative) &&
       (resolveFlexGrow() != 0 || resolveFlexShrink() != 0));
 }
 
 float YGNode::getLeadingBorder(const YGFlexDirection axis) const {
   YGValue leadingBorder;
-  if (YGFlexDirectionIsRow(axis) && !style_.border[YGEdgeStart].isUndefined()) {
-    leadingBorder = style_.border[YGEdgeStart];
+  if (YGFlexDirectionIsRow(axis) &&
+      !getStyle().border[YGEdgeStart].isUndefined()) {
+    leadingBorder = getStyle().border[YGEdgeStart];
     if (leadingBorder.value >= 0) {
       return leadingBorder.value;
     }
   }
 
-  leadingBorder =
-      YGComputedEdgeValue(style_.border, leading[axis], CompactValue::ofZero());
+  leadingBorder = YGComputedEdgeValue(
+      getStyle().border, leading[axis], CompactValue::ofZero());
   return YGFloatMax(leadingBorder.value, 0.0f);
 }
 
 float YGNode::getTrailingBorder(const YGFlexDirection flexDirection) const {
   YGValue trailingBorder;
   if (YGFlexDirectionIsRow(flexDirection) &&
-      !style_.border[YGEdgeEnd].isUndefined()) {
-    trailingBorder = style_.border[YGEdgeEnd];
+      !getStyle().border[YGEdgeEnd].isUndefined()) {
+    trailingBorder = getStyle().border[YGEdgeEnd];
     if (trailingBorder.value >= 0.0f) {
       return trailingBorder.value;
     }
   }
 
   trailingBorder = YGComputedEdgeValue(
-      style_.border, trailing[flexDirection], CompactValue::ofZero());
+      getStyle().border, trailing[flexDirection], CompactValue::ofZero());
   return YGFloatMax(trailingBorder.value, 0.0f);
 }
 
@@ -468,16 +541,16 @@ YGFloatOptional YGNode::getLeadingPadding(
     const YGFlexDirection axis,
     const float widthSize) const {
   const YGFloatOptional paddingEdgeStart =
-      YGResolveValue(style_.padding[YGEdgeStart], widthSize);
+      YGResolveValue(getStyle().padding[YGEdgeStart], widthSize);
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.padding[YGEdgeStart].isUndefined() &&
+      !getStyle().padding[YGEdgeStart].isUndefined() &&
       !paddingEdgeStart.isUndefined() && paddingEdgeStart.unwrap() >= 0.0f) {
     return paddingEdgeStart;
   }
 
   YGFloatOptional resolvedValue = YGResolveValue(
       YGComputedEdgeValue(
-          style_.padding, leading[axis], CompactValue::ofZero()),
+          getStyle().padding, leading[axis], CompactValue::ofZero()),
       widthSize);
   return YGFloatOptionalMax(resolvedValue, YGFloatOptional(0.0f));
 }
@@ -486,14 +559,14 @@ YGFloatOptional YGNode::getTrailingPadding(
     const YGFlexDirection axis,
     const float widthSize) const {
   const YGFloatOptional paddingEdgeEnd =
-      YGResolveValue(style_.padding[YGEdgeEnd], widthSize);
+      YGResolveValue(getStyle().padding[YGEdgeEnd], widthSize);
   if (YGFlexDirectionIsRow(axis) && paddingEdgeEnd >= YGFloatOptional{0.0f}) {
     return paddingEdgeEnd;
   }
 
   YGFloatOptional resolvedValue = YGResolveValue(
       YGComputedEdgeValue(
-          style_.padding, trailing[axis], CompactValue::ofZero()),
+          getStyle().padding, trailing[axis], CompactValue::ofZero()),
       widthSize);
 
   return YGFloatOptionalMax(resolvedValue, YGFloatOptional(0.0f));
@@ -529,7 +602,7 @@ bool YGNode::didUseLegacyFlag() {
 
 void YGNode::setAndPropogateUseLegacyFlag(bool useLegacyFlag) {
   config_->useLegacyStretchBehaviour = useLegacyFlag;
-  for_each(children_.begin(), children_.end(), [=](YGNodeRef childNode) {
+  std::for_each(children_.begin(), children_.end(), [=](YGNodeRef childNode) {
     childNode->getConfig()->useLegacyStretchBehaviour = useLegacyFlag;
   });
 }
@@ -556,7 +629,7 @@ bool YGNode::isLayoutTreeEqualToNode(const YGNode& node) const {
 
   bool isLayoutTreeEqual = true;
   YGNodeRef otherNodeChildren = nullptr;
-  for (std::vector<YGNodeRef>::size_type i = 0; i < children_.size(); ++i) {
+  for (YGVector::size_type i = 0; i < children_.size(); ++i) {
     otherNodeChildren = node.children_[i];
     isLayoutTreeEqual =
         children_[i]->isLayoutTreeEqualToNode(*otherNodeChildren);
@@ -578,10 +651,11 @@ void YGNode::reset() {
   clearChildren();
 
   auto config = getConfig();
+  auto isArenaAllocated = isArenaAllocated_;
   *this = YGNode{};
+  isArenaAllocated_ = isArenaAllocated;
   if (config->useWebDefaults) {
-    setStyleFlexDirection(YGFlexDirectionRow);
-    setStyleAlignContent(YGAlignStretch);
+    setStyle(YGSharedStyle::webDefaults());
   }
   setConfig(config);
 }
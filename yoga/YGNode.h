@@ -18,7 +18,32 @@ struct YGNode {
   using PrintWithContextFn = void (*)(YGNode*, void*);
 
 private:
-  void* context_ = nullptr;
+  // Data that is rarely set, allocated when first used.
+  struct ColdData {
+    union {
+      YGBaselineFunc noContext;
+      BaselineWithContextFn withContext;
+    } baseline = {nullptr};
+    union {
+      YGPrintFunc noContext;
+      PrintWithContextFn withContext;
+    } print = {nullptr};
+    YGDirtiedFunc dirtied = nullptr;
+    // Identifies the content measured by the measure function, see
+    // YGNodeSetMeasureContentKey.
+    uint64_t measureContentKey = 0;
+    // Frame (left, top, width, height) passed to the layout changed callback.
+    std::array<float, 4> reportedFrame = {
+        {YGUndefined, YGUndefined, YGUndefined, YGUndefined}};
+    // Structural hash and node count of the subtree, see YGNodeSubtreeHash.
+    uint64_t subtreeHash = 0;
+    uint32_t subtreeSize = 0;
+    // Only used while isVirtualized_ is set.
+    YGVirtualizedWindow virtualizedWindow = {};
+  };
+
+  // Fields touched by every traversal come first, so that they share the first
+  // cache line of the node.
   bool hasNewLayout_ : 1;
   bool isReferenceBaseline_ : 1;
   bool isDirty_ : 1;
@@ -26,34 +51,40 @@ private:
   bool measureUsesContext_ : 1;
   bool baselineUsesContext_ : 1;
   bool printUsesContext_ : 1;
-  union {
-    YGMeasureFunc noContext;
-    MeasureWithContextFn withContext;
-  } measure_ = {nullptr};
-  union {
-    YGBaselineFunc noContext;
-    BaselineWithContextFn withContext;
-  } baseline_ = {nullptr};
-  union {
-    YGPrintFunc noContext;
-    PrintWithContextFn withContext;
-  } print_ = {nullptr};
-  YGDirtiedFunc dirtied_ = nullptr;
-  YGStyle style_ = {};
-  YGLayout layout_ = {};
+  bool isArenaAllocated_ : 1;
+  // Cached result of YGNodeIsPlainStack, cleared when the node is marked dirty.
+  bool hasPlainStackSummary_ : 1;
+  bool isPlainStack_ : 1;
+  // Whether the subtree hash in the cold data is up to date. Hashes are
+  // computed bottom up, so a node only has one if all its descendants do.
+  bool hasSubtreeHash_ : 1;
+  bool isVirtualized_ : 1;
+  // Whether stackLayoutState_ still describes all children but those appended
+  // since, see markDirtyAndPropogateFromChild.
+  bool hasStackLayoutState_ : 1;
   uint32_t lineIndex_ = 0;
   YGNodeRef owner_ = nullptr;
   YGVector children_ = {};
   YGConfigRef config_ = nullptr;
+  union {
+    YGMeasureFunc noContext;
+    MeasureWithContextFn withContext;
+  } measure_ = {nullptr};
+  void* context_ = nullptr;
   std::array<YGValue, 2> resolvedDimensions_ = {
       {YGValueUndefined, YGValueUndefined}};
+  facebook::yoga::detail::LazyValue<ColdData> cold_ = {};
+  // Only used while hasStackLayoutState_ is set. Stacks are the most common
+  // containers, so this is not part of the cold data.
+  YGStackLayoutState stackLayoutState_ = {};
+  YGLayout layout_ = {};
+  YGSharedStyle style_ = {};
 
   YGFloatOptional relativePosition(
       const YGFlexDirection axis,
       const float axisSize) const;
 
   void setMeasureFunc(decltype(measure_));
-  void setBaselineFunc(decltype(baseline_));
 
   // DANGER DANGER DANGER!
   // If the the node assigned to has children, we'd either have to deallocate
@@ -70,9 +101,22 @@ public:
         nodeType_{YGNodeTypeDefault},
         measureUsesContext_{false},
         baselineUsesContext_{false},
-        printUsesContext_{false} {}
+        printUsesContext_{false},
+        isArenaAllocated_{false},
+        hasPlainStackSummary_{false},
+        isPlainStack_{false},
+        hasSubtreeHash_{false},
+        isVirtualized_{false},
+        hasStackLayoutState_{false} {}
   ~YGNode() = default; // cleanup of owner/children relationships in YGNodeFree
-  explicit YGNode(const YGConfigRef newConfig) : config_(newConfig){};
+  explicit YGNode(const YGConfigRef newConfig)
+      : isArenaAllocated_{false},
+        hasPlainStackSummary_{false},
+        isPlainStack_{false},
+        hasSubtreeHash_{false},
+        isVirtualized_{false},
+        hasStackLayoutState_{false},
+        config_(newConfig){};
 
   YGNode(YGNode&&);
 
@@ -99,6 +143,16 @@ public:
     return nodeType_;
   }
 
+  // Whether the node lives in a YGNodeArena rather than on the heap.
+  bool isArenaAllocated() const {
+    return isArenaAllocated_;
+  }
+
+  // Whether the rarely used data has been allocated.
+  bool hasColdData() const {
+    return cold_.get() != nullptr;
+  }
+
   bool hasMeasureFunc() const noexcept {
     return measure_.noContext != nullptr;
   }
@@ -106,21 +160,53 @@ public:
   YGSize measure(float, YGMeasureMode, float, YGMeasureMode, void*);
 
   bool hasBaselineFunc() const noexcept {
-    return baseline_.noContext != nullptr;
+    return cold_.get() != nullptr && cold_.get()->baseline.noContext != nullptr;
   }
 
   float baseline(float width, float height, void* layoutContext);
 
   YGDirtiedFunc getDirtied() const {
-    return dirtied_;
+    return cold_.get() != nullptr ? cold_.get()->dirtied : nullptr;
   }
 
-  // For Performance reasons passing as reference.
-  YGStyle& getStyle() {
-    return style_;
+  uint64_t getMeasureContentKey() const {
+    return cold_.get() != nullptr ? cold_.get()->measureContentKey : 0;
+  }
+
+  // The window set with YGNodeSetVirtualizedWindow, or nullptr.
+  const YGVirtualizedWindow* getVirtualizedWindow() const {
+    return isVirtualized_ ? &cold_.get()->virtualizedWindow : nullptr;
+  }
+
+  // The state of the last layout by YGLayoutPlainStackChildren, or nullptr.
+  const YGStackLayoutState* getStackLayoutState() const {
+    return hasStackLayoutState_ ? &stackLayoutState_ : nullptr;
   }
 
+  bool hasSubtreeHash() const {
+    return hasSubtreeHash_;
+  }
+
+  // Only valid if hasSubtreeHash().
+  uint64_t getSubtreeHash() const {
+    return cold_.get()->subtreeHash;
+  }
+  uint32_t getSubtreeSize() const {
+    return cold_.get()->subtreeSize;
+  }
+
+  // For Performance reasons passing as reference.
   const YGStyle& getStyle() const {
+    return style_.get();
+  }
+
+  // Returns the style for modification. Only call this for actual changes, as
+  // a style shared with other nodes is copied first.
+  YGStyle& getMutableStyle() {
+    return style_.getMutable();
+  }
+
+  const YGSharedStyle& getSharedStyle() const {
     return style_;
   }
 
@@ -141,6 +227,14 @@ public:
     return isReferenceBaseline_;
   }
 
+  bool hasPlainStackSummary() const {
+    return hasPlainStackSummary_;
+  }
+
+  bool isPlainStack() const {
+    return isPlainStack_;
+  }
+
   // returns the YGNodeRef that owns this YGNode. An owner is used to identify
   // the YogaTree that a YGNode belongs to. This method will return the parent
   // of the YGNode when a YGNode only belongs to one YogaTree or nullptr when
@@ -159,13 +253,19 @@ public:
   }
 
   // Applies a callback to all children, after cloning them if they are not
-  // owned.
+  // owned. Children are cloned with cloneNode if it is set, and with the clone
+  // callback of the config otherwise.
   template <typename T>
-  void iterChildrenAfterCloningIfNeeded(T callback, void* cloneContext) {
+  void iterChildrenAfterCloningIfNeeded(
+      T callback,
+      void* cloneContext,
+      YGCloneNodeFunc cloneNode) {
     int i = 0;
     for (YGNodeRef& child : children_) {
       if (child->getOwner() != this) {
-        child = config_->cloneNode(child, this, i, cloneContext);
+        child = cloneNode != nullptr
+            ? cloneNode(child, this, i)
+            : config_->cloneNode(child, this, i, cloneContext);
         child->setOwner(this);
       }
       i += 1;
@@ -233,11 +333,15 @@ public:
   }
 
   void setPrintFunc(YGPrintFunc printFunc) {
-    print_.noContext = printFunc;
+    if (printFunc != nullptr || cold_.get() != nullptr) {
+      cold_.getOrCreate().print.noContext = printFunc;
+    }
     printUsesContext_ = false;
   }
   void setPrintFunc(PrintWithContextFn printFunc) {
-    print_.withContext = printFunc;
+    if (printFunc != nullptr || cold_.get() != nullptr) {
+      cold_.getOrCreate().print.withContext = printFunc;
+    }
     printUsesContext_ = true;
   }
   void setPrintFunc(std::nullptr_t) {
@@ -248,16 +352,26 @@ public:
     hasNewLayout_ = hasNewLayout;
   }
 
+  void setIsArenaAllocated(bool isArenaAllocated) {
+    isArenaAllocated_ = isArenaAllocated;
+  }
+
+  void setIsPlainStack(bool isPlainStack) {
+    hasPlainStackSummary_ = true;
+    isPlainStack_ = isPlainStack;
+  }
+
   void setNodeType(YGNodeType nodeType) {
     nodeType_ = nodeType;
+    invalidateSubtreeHash();
   }
 
   void setStyleFlexDirection(YGFlexDirection direction) {
-    style_.flexDirection = direction;
+    style_.getMutable().flexDirection = direction;
   }
 
   void setStyleAlignContent(YGAlign alignContent) {
-    style_.alignContent = alignContent;
+    style_.getMutable().alignContent = alignContent;
   }
 
   void setMeasureFunc(YGMeasureFunc measureFunc);
@@ -268,21 +382,68 @@ public:
 
   void setBaselineFunc(YGBaselineFunc baseLineFunc) {
     baselineUsesContext_ = false;
-    baseline_.noContext = baseLineFunc;
+    if (baseLineFunc != nullptr || cold_.get() != nullptr) {
+      cold_.getOrCreate().baseline.noContext = baseLineFunc;
+    }
+    invalidateSubtreeHash();
   }
   void setBaselineFunc(BaselineWithContextFn baseLineFunc) {
     baselineUsesContext_ = true;
-    baseline_.withContext = baseLineFunc;
+    if (baseLineFunc != nullptr || cold_.get() != nullptr) {
+      cold_.getOrCreate().baseline.withContext = baseLineFunc;
+    }
+    invalidateSubtreeHash();
   }
   void setBaselineFunc(std::nullptr_t) {
     return setBaselineFunc(YGBaselineFunc{nullptr});
   }
 
   void setDirtiedFunc(YGDirtiedFunc dirtiedFunc) {
-    dirtied_ = dirtiedFunc;
+    if (dirtiedFunc != nullptr || cold_.get() != nullptr) {
+      cold_.getOrCreate().dirtied = dirtiedFunc;
+    }
+  }
+
+  void setMeasureContentKey(uint64_t key) {
+    if (key != 0 || cold_.get() != nullptr) {
+      cold_.getOrCreate().measureContentKey = key;
+    }
+    invalidateSubtreeHash();
   }
 
+  void setVirtualizedWindow(const YGVirtualizedWindow& window) {
+    cold_.getOrCreate().virtualizedWindow = window;
+    isVirtualized_ = true;
+  }
+  void clearVirtualizedWindow() {
+    isVirtualized_ = false;
+  }
+
+  void setStackLayoutState(const YGStackLayoutState& state) {
+    stackLayoutState_ = state;
+    hasStackLayoutState_ = true;
+  }
+  void clearStackLayoutState() {
+    hasStackLayoutState_ = false;
+  }
+
+  void setSubtreeHash(uint64_t hash, uint32_t size) {
+    ColdData& cold = cold_.getOrCreate();
+    cold.subtreeHash = hash;
+    cold.subtreeSize = size;
+    hasSubtreeHash_ = true;
+  }
+  // Clears the subtree hashes of the node and its ancestors. Called for every
+  // change the hash depends on, which are the changes that mark nodes dirty,
+  // and changes to node types, measure and baseline functions and measure
+  // content keys.
+  void invalidateSubtreeHash();
+
   void setStyle(const YGStyle& style) {
+    style_.getMutable() = style;
+  }
+
+  void setStyle(const YGSharedStyle& style) {
     style_ = style;
   }
 
@@ -306,7 +467,9 @@ public:
     children_ = children;
   }
 
-  // TODO: rvalue override for setChildren
+  void setChildren(YGVector&& children) {
+    children_ = std::move(children);
+  }
 
   void setConfig(YGConfigRef config) {
     config_ = config;
@@ -325,6 +488,9 @@ public:
   void setLayoutBorder(float border, int index);
   void setLayoutPadding(float padding, int index);
   void setLayoutPosition(float position, int index);
+  // Records the current frame as reported, and returns which parts of it
+  // changed since the previous call, as YGLayoutChange flags.
+  int updateReportedFrame();
   void setPosition(
       const YGDirection direction,
       const float mainSize,
@@ -350,8 +516,12 @@ public:
   bool removeChild(YGNodeRef child);
   void removeChild(uint32_t index);
 
-  void cloneChildrenIfNeeded(void*);
+  void cloneChildrenIfNeeded(void*, YGCloneNodeFunc);
   void markDirtyAndPropogate();
+  // Marks the node dirty because child changed or was inserted. Unlike other
+  // changes, changes to children appended since the last layout keep the stack
+  // layout state, as appended children are laid out in full.
+  void markDirtyAndPropogateFromChild(const YGNode* child);
   float resolveFlexGrow();
   float resolveFlexShrink();
   bool isNodeFlexible();
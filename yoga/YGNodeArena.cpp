@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGNodeArena.h"
+
+YGNodeArena::~YGNodeArena() {
+  reset();
+}
+
+YGNodeArena::Slot* YGNodeArena::acquireSlot() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (freeList_ == nullptr) {
+    slabs_.emplace_back(new Slot[kSlotsPerSlab]);
+    Slot* slab = slabs_.back().get();
+    for (size_t i = 0; i < kSlotsPerSlab; i++) {
+      slab[i].arena = nullptr;
+      slab[i].nextFree = i + 1 < kSlotsPerSlab ? &slab[i + 1] : nullptr;
+    }
+    freeList_ = slab;
+  }
+
+  Slot* slot = freeList_;
+  freeList_ = slot->nextFree;
+  slot->arena = this;
+  slot->nextFree = nullptr;
+  liveNodeCount_++;
+  return slot;
+}
+
+void YGNodeArena::releaseSlot(Slot* slot) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  slot->arena = nullptr;
+  slot->nextFree = freeList_;
+  freeList_ = slot;
+  liveNodeCount_--;
+}
+
+void YGNodeArena::deleteNode(YGNodeRef node) {
+  Slot* slot = slotOf(node);
+  node->~YGNode();
+  slot->arena->releaseSlot(slot);
+}
+
+size_t YGNodeArena::reset() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  const size_t destroyed = liveNodeCount_;
+  freeList_ = nullptr;
+  for (auto& slab : slabs_) {
+    for (size_t i = 0; i < kSlotsPerSlab; i++) {
+      Slot& slot = slab[i];
+      if (slot.arena != nullptr) {
+        reinterpret_cast<YGNodeRef>(&slot.node)->~YGNode();
+        slot.arena = nullptr;
+      }
+      slot.nextFree = freeList_;
+      freeList_ = &slot;
+    }
+  }
+  liveNodeCount_ = 0;
+  return destroyed;
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include "YGNode.h"
+
+// Slab allocator for nodes. Nodes are carved out of fixed size slabs and freed
+// slots are recycled through a free list, so building and tearing down large
+// trees does not hit the system allocator once per node. Freeing the arena
+// destroys every node still allocated from it in a single sweep.
+struct YGNodeArena {
+private:
+  struct Slot {
+    // Arena the slot belongs to, nullptr while the slot is free.
+    YGNodeArena* arena;
+    Slot* nextFree;
+    std::aligned_storage<sizeof(YGNode), alignof(YGNode)>::type node;
+  };
+
+  static constexpr size_t kSlotsPerSlab = 128;
+
+  std::vector<std::unique_ptr<Slot[]>> slabs_;
+  Slot* freeList_ = nullptr;
+  size_t liveNodeCount_ = 0;
+  std::mutex mutex_;
+
+  Slot* acquireSlot();
+  void releaseSlot(Slot* slot);
+
+  static Slot* slotOf(YGNodeRef node) {
+    return reinterpret_cast<Slot*>(
+        reinterpret_cast<char*>(node) - offsetof(Slot, node));
+  }
+
+public:
+  YGNodeArena() = default;
+  YGNodeArena(const YGNodeArena&) = delete;
+  YGNodeArena& operator=(const YGNodeArena&) = delete;
+  ~YGNodeArena();
+
+  template <typename... Args>
+  YGNodeRef newNode(Args&&... args) {
+    Slot* slot = acquireSlot();
+    YGNodeRef node = new (&slot->node) YGNode(std::forward<Args>(args)...);
+    node->setIsArenaAllocated(true);
+    return node;
+  }
+
+  // Destroys a node allocated by any arena and returns its slot.
+  static void deleteNode(YGNodeRef node);
+
+  // Destroys all nodes allocated from this arena and keeps the slabs for
+  // reuse. Returns the number of nodes destroyed.
+  size_t reset();
+
+  size_t getLiveNodeCount() const {
+    return liveNodeCount_;
+  }
+};
@@ -0,0 +1,323 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGPixelGrid.h"
+#include <cmath>
+#include "Utils.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define YG_PIXEL_GRID_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define YG_PIXEL_GRID_NEON 1
+#endif
+
+void YGPixelGridFrames::add(
+    const YGNodeRef node,
+    const std::array<float, 4>& frame,
+    const float nodeAbsoluteLeft,
+    const float nodeAbsoluteTop,
+    const bool nodeTextRounding) {
+  nodes.push_back(node);
+  left.push_back(frame[YGEdgeLeft]);
+  top.push_back(frame[YGEdgeTop]);
+  width.push_back(frame[2 + YGDimensionWidth]);
+  height.push_back(frame[2 + YGDimensionHeight]);
+  absoluteLeft.push_back(nodeAbsoluteLeft);
+  absoluteTop.push_back(nodeAbsoluteTop);
+  textRounding.push_back(nodeTextRounding ? 1 : 0);
+}
+
+void YGPixelGridFrames::clear() {
+  nodes.clear();
+  left.clear();
+  top.clear();
+  width.clear();
+  height.clear();
+  absoluteLeft.clear();
+  absoluteTop.clear();
+  textRounding.clear();
+}
+
+namespace {
+
+#if defined(YG_PIXEL_GRID_SSE2) || defined(YG_PIXEL_GRID_NEON)
+
+// Four floats, and the operations the kernel needs on them. Comparisons
+// return masks with all bits of a lane set where they hold.
+#ifdef YG_PIXEL_GRID_SSE2
+
+using Float4 = __m128;
+
+inline Float4 splat(const float value) {
+  return _mm_set1_ps(value);
+}
+inline Float4 load(const float* values) {
+  return _mm_loadu_ps(values);
+}
+inline void store(float* values, const Float4 a) {
+  _mm_storeu_ps(values, a);
+}
+inline Float4 add(const Float4 a, const Float4 b) {
+  return _mm_add_ps(a, b);
+}
+inline Float4 sub(const Float4 a, const Float4 b) {
+  return _mm_sub_ps(a, b);
+}
+inline Float4 mul(const Float4 a, const Float4 b) {
+  return _mm_mul_ps(a, b);
+}
+inline Float4 div(const Float4 a, const Float4 b) {
+  return _mm_div_ps(a, b);
+}
+inline Float4 bitAnd(const Float4 a, const Float4 b) {
+  return _mm_and_ps(a, b);
+}
+inline Float4 bitOr(const Float4 a, const Float4 b) {
+  return _mm_or_ps(a, b);
+}
+// a & ~b
+inline Float4 bitAndNot(const Float4 a, const Float4 b) {
+  return _mm_andnot_ps(b, a);
+}
+inline Float4 lessThan(const Float4 a, const Float4 b) {
+  return _mm_cmplt_ps(a, b);
+}
+inline Float4 isNaN(const Float4 a) {
+  return _mm_cmpunord_ps(a, a);
+}
+// Rounds towards zero. SSE2 can only convert values that fit into an int32,
+// but all floats of at least 2^23 are integers already, as are NaNs as far as
+// the kernel is concerned.
+inline Float4 truncate(const Float4 a) {
+  const Float4 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+  const Float4 isSmall = lessThan(
+      bitAndNot(a, splat(-0.0f)), splat(static_cast<float>(1 << 23)));
+  return bitOr(bitAnd(isSmall, truncated), bitAndNot(a, isSmall));
+}
+// All bits of lane i are set where flags[i] is non-zero.
+inline Float4 laneMask(const uint8_t* flags) {
+  return _mm_castsi128_ps(_mm_set_epi32(
+      -static_cast<int32_t>(flags[3] != 0),
+      -static_cast<int32_t>(flags[2] != 0),
+      -static_cast<int32_t>(flags[1] != 0),
+      -static_cast<int32_t>(flags[0] != 0)));
+}
+
+#else
+
+using Float4 = float32x4_t;
+
+inline Float4 splat(const float value) {
+  return vdupq_n_f32(value);
+}
+inline Float4 load(const float* values) {
+  return vld1q_f32(values);
+}
+inline void store(float* values, const Float4 a) {
+  vst1q_f32(values, a);
+}
+inline Float4 add(const Float4 a, const Float4 b) {
+  return vaddq_f32(a, b);
+}
+inline Float4 sub(const Float4 a, const Float4 b) {
+  return vsubq_f32(a, b);
+}
+inline Float4 mul(const Float4 a, const Float4 b) {
+  return vmulq_f32(a, b);
+}
+inline Float4 div(const Float4 a, const Float4 b) {
+  return vdivq_f32(a, b);
+}
+inline Float4 bitAnd(const Float4 a, const Float4 b) {
+  return vreinterpretq_f32_u32(
+      vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+inline Float4 bitOr(const Float4 a, const Float4 b) {
+  return vreinterpretq_f32_u32(
+      vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+// a & ~b
+inline Float4 bitAndNot(const Float4 a, const Float4 b) {
+  return vreinterpretq_f32_u32(
+      vbicq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+inline Float4 lessThan(const Float4 a, const Float4 b) {
+  return vreinterpretq_f32_u32(vcltq_f32(a, b));
+}
+inline Float4 isNaN(const Float4 a) {
+  return vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(a, a)));
+}
+// Rounds towards zero.
+inline Float4 truncate(const Float4 a) {
+  return vrndq_f32(a);
+}
+// All bits of lane i are set where flags[i] is non-zero.
+inline Float4 laneMask(const uint8_t* flags) {
+  const uint32_t lanes[4] = {
+      flags[0] != 0 ? ~0u : 0u,
+      flags[1] != 0 ? ~0u : 0u,
+      flags[2] != 0 ? ~0u : 0u,
+      flags[3] != 0 ? ~0u : 0u,
+  };
+  return vreinterpretq_f32_u32(vld1q_u32(lanes));
+}
+
+#endif
+
+// Lanes of a where mask is set, lanes of b elsewhere.
+inline Float4 select(const Float4 mask, const Float4 a, const Float4 b) {
+  return bitOr(bitAnd(mask, a), bitAndNot(b, mask));
+}
+
+// fmodf(a, 1.0f), which is exact: a minus its integral part, with the sign of
+// a, also where the result is zero.
+inline Float4 fraction(const Float4 a) {
+  const Float4 signBit = splat(-0.0f);
+  return bitOr(bitAndNot(sub(a, truncate(a)), signBit), bitAnd(a, signBit));
+}
+
+// YGFloatsEqual(a, b) for a defined b.
+inline Float4 floatsEqual(const Float4 a, const float b) {
+  return lessThan(bitAndNot(sub(a, splat(b)), splat(-0.0f)), splat(0.0001f));
+}
+
+// YGRoundValueToPixelGrid for four values at once, with the branches taken
+// for each lane turned into selects. Every lane gets the same operations
+// applied in the same order as in the scalar version, so the results are
+// identical, down to the signs of zeros.
+inline Float4 roundValueToPixelGrid(
+    const Float4 value,
+    const Float4 pointScaleFactor,
+    const Float4 forceCeil,
+    const Float4 forceFloor) {
+  const Float4 one = splat(1.0f);
+  const Float4 scaledValue = mul(value, pointScaleFactor);
+  Float4 fractial = fraction(scaledValue);
+  fractial = select(
+      lessThan(fractial, splat(0.0f)), add(fractial, one), fractial);
+
+  const Float4 floored = sub(scaledValue, fractial);
+  const Float4 ceiled = add(floored, one);
+  const Float4 roundsUp = bitOr(
+      lessThan(splat(0.5f), fractial), floatsEqual(fractial, 0.5f));
+  Float4 rounded = select(roundsUp, ceiled, add(floored, splat(0.0f)));
+  rounded = select(forceFloor, floored, rounded);
+  rounded = select(forceCeil, ceiled, rounded);
+  rounded = select(floatsEqual(fractial, 1.0f), ceiled, rounded);
+  rounded = select(floatsEqual(fractial, 0.0f), floored, rounded);
+  return select(
+      isNaN(rounded), splat(YGUndefined), div(rounded, pointScaleFactor));
+}
+
+// Lanes are set where size * pointScaleFactor is close to a whole number, that
+// is where the scalar version finds no fractional size.
+inline Float4 isWholePixelSize(
+    const Float4 size,
+    const Float4 pointScaleFactor) {
+  const Float4 sizeFraction = fraction(mul(size, pointScaleFactor));
+  return bitOr(
+      floatsEqual(sizeFraction, 0.0f), floatsEqual(sizeFraction, 1.0f));
+}
+
+#endif
+
+void roundFrameToPixelGrid(
+    YGPixelGridFrames& frames,
+    const size_t i,
+    const float pointScaleFactor) {
+  const bool textRounding = frames.textRounding[i] != 0;
+  const float absoluteNodeLeft = frames.absoluteLeft[i];
+  const float absoluteNodeTop = frames.absoluteTop[i];
+  const float absoluteNodeRight = absoluteNodeLeft + frames.width[i];
+  const float absoluteNodeBottom = absoluteNodeTop + frames.height[i];
+
+  // We multiply dimension by scale factor and if the result is close to the
+  // whole number, we don't have any fraction To verify if the result is close
+  // to whole number we want to check both floor and ceil numbers
+  const float widthFraction = fmodf(frames.width[i] * pointScaleFactor, 1.0);
+  const bool hasFractionalWidth =
+      !YGFloatsEqual(widthFraction, 0) && !YGFloatsEqual(widthFraction, 1.0);
+  const float heightFraction = fmodf(frames.height[i] * pointScaleFactor, 1.0);
+  const bool hasFractionalHeight =
+      !YGFloatsEqual(heightFraction, 0) && !YGFloatsEqual(heightFraction, 1.0);
+
+  frames.left[i] = YGRoundValueToPixelGrid(
+      frames.left[i], pointScaleFactor, false, textRounding);
+  frames.top[i] = YGRoundValueToPixelGrid(
+      frames.top[i], pointScaleFactor, false, textRounding);
+  frames.width[i] =
+      YGRoundValueToPixelGrid(
+          absoluteNodeRight,
+          pointScaleFactor,
+          (textRounding && hasFractionalWidth),
+          (textRounding && !hasFractionalWidth)) -
+      YGRoundValueToPixelGrid(
+          absoluteNodeLeft, pointScaleFactor, false, textRounding);
+  frames.height[i] =
+      YGRoundValueToPixelGrid(
+          absoluteNodeBottom,
+          pointScaleFactor,
+          (textRounding && hasFractionalHeight),
+          (textRounding && !hasFractionalHeight)) -
+      YGRoundValueToPixelGrid(
+          absoluteNodeTop, pointScaleFactor, false, textRounding);
+}
+
+} // namespace
+
+void YGRoundFramesToPixelGrid(
+    YGPixelGridFrames& frames,
+    const float pointScaleFactor) {
+  const size_t count = frames.size();
+  size_t i = 0;
+#if defined(YG_PIXEL_GRID_SSE2) || defined(YG_PIXEL_GRID_NEON)
+  const Float4 scale = splat(pointScaleFactor);
+  const Float4 none = splat(0.0f);
+  for (; i + 4 <= count; i += 4) {
+    // If a node has a custom measure function we never want to round down its
+    // size as this could lead to unwanted text truncation.
+    const Float4 textRounding = laneMask(&frames.textRounding[i]);
+    const Float4 absoluteNodeLeft = load(&frames.absoluteLeft[i]);
+    const Float4 absoluteNodeTop = load(&frames.absoluteTop[i]);
+    const Float4 width = load(&frames.width[i]);
+    const Float4 height = load(&frames.height[i]);
+
+    store(
+        &frames.left[i],
+        roundValueToPixelGrid(
+            load(&frames.left[i]), scale, none, textRounding));
+    store(
+        &frames.top[i],
+        roundValueToPixelGrid(load(&frames.top[i]), scale, none, textRounding));
+
+    const Float4 wholeWidth = isWholePixelSize(width, scale);
+    store(
+        &frames.width[i],
+        sub(roundValueToPixelGrid(
+                add(absoluteNodeLeft, width),
+                scale,
+                bitAndNot(textRounding, wholeWidth),
+                bitAnd(textRounding, wholeWidth)),
+            roundValueToPixelGrid(
+                absoluteNodeLeft, scale, none, textRounding)));
+    const Float4 wholeHeight = isWholePixelSize(height, scale);
+    store(
+        &frames.height[i],
+        sub(roundValueToPixelGrid(
+                add(absoluteNodeTop, height),
+                scale,
+                bitAndNot(textRounding, wholeHeight),
+                bitAnd(textRounding, wholeHeight)),
+            roundValueToPixelGrid(absoluteNodeTop, scale, none, textRounding)));
+  }
+#endif
+  for (; i < count; i++) {
+    roundFrameToPixelGrid(frames, i, pointScaleFactor);
+  }
+}
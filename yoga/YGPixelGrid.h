@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Yoga.h"
+
+// Frames of nodes to round to the pixel grid, stored as one array per value
+// so they can be rounded in a single pass once the tree has been walked.
+// Positions are relative to the owner, absolute positions to the root.
+// YGRoundFramesToPixelGrid replaces the unrounded positions and sizes with
+// rounded ones. The arrays keep their capacity when cleared, so the same
+// frames can be reused by later passes without allocating.
+struct YGPixelGridFrames {
+  std::vector<YGNodeRef> nodes;
+  std::vector<float> left;
+  std::vector<float> top;
+  std::vector<float> width;
+  std::vector<float> height;
+  std::vector<float> absoluteLeft;
+  std::vector<float> absoluteTop;
+  // 1 for nodes whose sizes are never rounded down, see
+  // YGRoundFramesToPixelGrid, 0 for all others.
+  std::vector<uint8_t> textRounding;
+
+  size_t size() const {
+    return nodes.size();
+  }
+
+  void add(
+      YGNodeRef node,
+      const std::array<float, 4>& frame,
+      float nodeAbsoluteLeft,
+      float nodeAbsoluteTop,
+      bool nodeTextRounding);
+  void clear();
+};
+
+// Rounds all frames. Produces the same values, bit for bit, as rounding each
+// frame on its own with YGRoundValueToPixelGrid. Four frames at a time are
+// rounded with SSE2 or NEON instructions where available, the others with
+// YGRoundValueToPixelGrid.
+void YGRoundFramesToPixelGrid(
+    YGPixelGridFrames& frames,
+    float pointScaleFactor);
@@ -0,0 +1,560 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGSnapshot.h"
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include "Utils.h"
+#include "YGConfig.h"
+#include "YGNode.h"
+
+namespace {
+
+struct YGStyleValueHash {
+  size_t operator()(const YGStyle* style) const {
+    YGHasher hasher;
+    YGHashStyleValues(hasher, *style);
+    return static_cast<size_t>(hasher.hash);
+  }
+};
+
+struct YGStyleValueEqual {
+  bool operator()(const YGStyle* lhs, const YGStyle* rhs) const {
+    return *lhs == *rhs;
+  }
+};
+
+} // namespace
+
+static void YGSnapshotSaveLayout(
+    const YGLayout& layout,
+    YGSnapshotLayout& record) {
+  std::copy(layout.position.begin(), layout.position.end(), record.position);
+  std::copy(
+      layout.dimensions.begin(), layout.dimensions.end(), record.dimensions);
+  std::copy(layout.margin.begin(), layout.margin.end(), record.margin);
+  std::copy(layout.border.begin(), layout.border.end(), record.border);
+  std::copy(layout.padding.begin(), layout.padding.end(), record.padding);
+  record.direction = static_cast<uint8_t>(layout.direction);
+  record.hadOverflow = layout.hadOverflow;
+  record.didUseLegacyFlag = layout.didUseLegacyFlag;
+  record.doesLegacyStretchFlagAffectsLayout =
+      layout.doesLegacyStretchFlagAffectsLayout;
+}
+
+static YGLayout YGSnapshotLoadLayout(const YGSnapshotLayout& record) {
+  YGLayout layout;
+  std::copy(record.position, record.position + 4, layout.position.begin());
+  std::copy(
+      record.dimensions, record.dimensions + 2, layout.dimensions.begin());
+  std::copy(record.margin, record.margin + 6, layout.margin.begin());
+  std::copy(record.border, record.border + 6, layout.border.begin());
+  std::copy(record.padding, record.padding + 6, layout.padding.begin());
+  layout.direction = static_cast<YGDirection>(record.direction);
+  layout.hadOverflow = record.hadOverflow != 0;
+  layout.didUseLegacyFlag = record.didUseLegacyFlag != 0;
+  layout.doesLegacyStretchFlagAffectsLayout =
+      record.doesLegacyStretchFlagAffectsLayout != 0;
+  return layout;
+}
+
+// Fingerprint of everything the layout of a node is computed from, besides
+// its descendants, which have fingerprints of their own, and the constraints,
+// which the layout caches record.
+static uint64_t YGNodeLayoutFingerprint(const YGNodeRef node) {
+  YGHasher hasher;
+  YGHashStyle(hasher, node->getStyle());
+  hasher.add(node->getNodeType());
+  hasher.add(node->getMeasureContentKey());
+  hasher.add(node->hasMeasureFunc());
+  hasher.add(node->hasBaselineFunc());
+  hasher.add(node->isReferenceBaseline());
+  hasher.add(static_cast<uint32_t>(node->getChildren().size()));
+  if (const YGVirtualizedWindow* window = node->getVirtualizedWindow()) {
+    hasher.add(window->offset);
+    hasher.add(window->extent);
+    hasher.add(window->estimatedItemSize);
+    hasher.add(window->overscan);
+  }
+
+  YGHashLayoutConfig(hasher, *node->getConfig());
+  return hasher.hash;
+}
+
+static YGSnapshotMeasurement YGSnapshotSaveMeasurement(
+    const YGCachedMeasurement& measurement) {
+  return {
+      measurement.availableWidth,
+      measurement.availableHeight,
+      measurement.widthMeasureMode,
+      measurement.heightMeasureMode,
+      measurement.computedWidth,
+      measurement.computedHeight,
+  };
+}
+
+static YGCachedMeasurement YGSnapshotLoadMeasurement(
+    const YGSnapshotMeasurement& record) {
+  YGCachedMeasurement measurement;
+  measurement.availableWidth = record.availableWidth;
+  measurement.availableHeight = record.availableHeight;
+  measurement.widthMeasureMode =
+      static_cast<YGMeasureMode>(record.widthMeasureMode);
+  measurement.heightMeasureMode =
+      static_cast<YGMeasureMode>(record.heightMeasureMode);
+  measurement.computedWidth = record.computedWidth;
+  measurement.computedHeight = record.computedHeight;
+  return measurement;
+}
+
+static bool YGSnapshotIsValidMeasurement(const YGSnapshotMeasurement& record) {
+  // Unused cache entries have a measure mode of -1.
+  return record.widthMeasureMode >= -1 &&
+      record.widthMeasureMode < facebook::yoga::enums::count<YGMeasureMode>() &&
+      record.heightMeasureMode >= -1 &&
+      record.heightMeasureMode < facebook::yoga::enums::count<YGMeasureMode>();
+}
+
+static char* YGSnapshotSaveLayoutCache(const YGNodeRef node, char* out) {
+  const YGLayout& layout = node->getLayout();
+  YGSnapshotLayoutCache record = {};
+  record.fingerprint = YGNodeLayoutFingerprint(node);
+  record.cachedLayout = YGSnapshotSaveMeasurement(layout.cachedLayout);
+  std::copy(
+      layout.measuredDimensions.begin(),
+      layout.measuredDimensions.end(),
+      record.measuredDimensions);
+  std::copy(
+      layout.unroundedFrame.begin(),
+      layout.unroundedFrame.end(),
+      record.unroundedFrame);
+  std::copy(
+      layout.roundedAbsolutePosition.begin(),
+      layout.roundedAbsolutePosition.end(),
+      record.roundedAbsolutePosition);
+  record.roundedPointScaleFactor = layout.roundedPointScaleFactor;
+  record.measurementCount =
+      static_cast<uint32_t>(layout.cachedMeasurements.size());
+  record.lastOwnerDirection = static_cast<int8_t>(layout.lastOwnerDirection);
+  record.flags =
+      (layout.needsRounding ? YGSnapshotLayoutCacheNeedsRounding : 0) |
+      (node->isDirty() ? YGSnapshotLayoutCacheIsDirty : 0);
+  std::memcpy(out, &record, sizeof(record));
+  out += sizeof(record);
+
+  for (size_t i = 0; i < layout.cachedMeasurements.size(); i++) {
+    const YGSnapshotMeasurement measurement =
+        YGSnapshotSaveMeasurement(layout.cachedMeasurements[i]);
+    std::memcpy(out, &measurement, sizeof(measurement));
+    out += sizeof(measurement);
+  }
+  return out;
+}
+
+size_t YGNodeSnapshotSave(
+    const YGNodeRef root,
+    const YGSnapshotOptions options,
+    void* buffer,
+    const size_t bufferSize) {
+  const bool includeLayoutCache = (options & YGSnapshotOptionsLayoutCache) != 0;
+  const bool includeLayout =
+      includeLayoutCache || (options & YGSnapshotOptionsLayout) != 0;
+
+  // Equal styles are saved once, whether or not the nodes share them.
+  std::unordered_map<
+      const YGStyle*,
+      uint32_t,
+      YGStyleValueHash,
+      YGStyleValueEqual>
+      styleIndices;
+  std::vector<const YGStyle*> styles;
+  std::vector<YGNodeRef> nodes;
+  size_t measurementCount = 0;
+  std::vector<YGNodeRef> stack = {root};
+  while (!stack.empty()) {
+    const YGNodeRef node = stack.back();
+    stack.pop_back();
+    nodes.push_back(node);
+    const YGStyle* style = &node->getStyle();
+    if (styleIndices.emplace(style, styles.size()).second) {
+      styles.push_back(style);
+    }
+    measurementCount += node->getLayout().cachedMeasurements.size();
+    const auto& children = node->getChildren();
+    for (size_t i = children.size(); i > 0; i--) {
+      stack.push_back(children[i - 1]);
+    }
+  }
+
+  const size_t size = sizeof(YGSnapshotHeader) +
+      styles.size() * sizeof(YGStyle) +
+      nodes.size() *
+          (sizeof(YGSnapshotNode) +
+           (includeLayout ? sizeof(YGSnapshotLayout) : 0) +
+           (includeLayoutCache ? sizeof(YGSnapshotLayoutCache) : 0)) +
+      (includeLayoutCache ? measurementCount * sizeof(YGSnapshotMeasurement)
+                          : 0);
+  if (buffer == nullptr || bufferSize < size) {
+    return size;
+  }
+
+  char* out = static_cast<char*>(buffer);
+  YGSnapshotHeader header = {};
+  header.magic = kYGSnapshotMagic;
+  header.version = kYGSnapshotVersion;
+  header.flags = (includeLayout ? YGSnapshotHasLayout : 0) |
+      (includeLayoutCache ? YGSnapshotHasLayoutCache : 0);
+  header.styleSize = sizeof(YGStyle);
+  header.nodeSize = sizeof(YGSnapshotNode);
+  header.layoutSize = sizeof(YGSnapshotLayout);
+  header.layoutCacheSize = sizeof(YGSnapshotLayoutCache);
+  header.styleCount = static_cast<uint32_t>(styles.size());
+  header.nodeCount = static_cast<uint32_t>(nodes.size());
+  std::memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+
+  for (const YGStyle* style : styles) {
+    std::memcpy(out, style, sizeof(YGStyle));
+    out += sizeof(YGStyle);
+  }
+
+  for (const YGNodeRef node : nodes) {
+    YGSnapshotNode record = {};
+    record.styleIndex = styleIndices[&node->getStyle()];
+    record.childCount = static_cast<uint32_t>(node->getChildren().size());
+    record.nodeType = static_cast<uint8_t>(node->getNodeType());
+    record.flags =
+        (node->isReferenceBaseline() ? YGSnapshotNodeIsReferenceBaseline : 0) |
+        (node->getHasNewLayout() ? YGSnapshotNodeHasNewLayout : 0);
+    record.measureContentKey = node->getMeasureContentKey();
+    std::memcpy(out, &record, sizeof(record));
+    out += sizeof(record);
+  }
+
+  if (includeLayout) {
+    for (const YGNodeRef node : nodes) {
+      YGSnapshotLayout record = {};
+      YGSnapshotSaveLayout(node->getLayout(), record);
+      std::memcpy(out, &record, sizeof(record));
+      out += sizeof(record);
+    }
+  }
+
+  if (includeLayoutCache) {
+    for (const YGNodeRef node : nodes) {
+      out = YGSnapshotSaveLayoutCache(node, out);
+    }
+  }
+  return size;
+}
+
+// Checks that the node records describe a single tree in pre-order, and refer
+// to existing styles, so that loading cannot fail half way.
+static bool YGSnapshotIsValidTree(
+    const char* nodeRecords,
+    const YGSnapshotHeader& header) {
+  uint64_t pendingNodes = 1;
+  for (uint32_t i = 0; i < header.nodeCount; i++) {
+    YGSnapshotNode record;
+    std::memcpy(&record, nodeRecords + i * sizeof(record), sizeof(record));
+    if (pendingNodes == 0 || record.styleIndex >= header.styleCount ||
+        record.nodeType >= facebook::yoga::enums::count<YGNodeType>()) {
+      return false;
+    }
+    pendingNodes += record.childCount;
+    pendingNodes--;
+  }
+  return pendingNodes == 0;
+}
+
+namespace {
+
+// Sections of a validated snapshot.
+struct YGSnapshotView {
+  YGSnapshotHeader header;
+  const char* styleRecords;
+  const char* nodeRecords;
+  // Null without YGSnapshotHasLayout.
+  const char* layoutRecords;
+  // Layout cache record of each node, empty without YGSnapshotHasLayoutCache.
+  std::vector<const char*> layoutCacheRecords;
+
+  YGSnapshotNode node(uint32_t i) const {
+    YGSnapshotNode record;
+    std::memcpy(&record, nodeRecords + i * sizeof(record), sizeof(record));
+    return record;
+  }
+
+  YGSnapshotLayout layout(uint32_t i) const {
+    YGSnapshotLayout record;
+    std::memcpy(&record, layoutRecords + i * sizeof(record), sizeof(record));
+    return record;
+  }
+
+  YGSnapshotLayoutCache layoutCache(uint32_t i) const {
+    YGSnapshotLayoutCache record;
+    std::memcpy(&record, layoutCacheRecords[i], sizeof(record));
+    return record;
+  }
+
+  YGSnapshotMeasurement measurement(uint32_t i, uint32_t j) const {
+    YGSnapshotMeasurement record;
+    std::memcpy(
+        &record,
+        layoutCacheRecords[i] + sizeof(YGSnapshotLayoutCache) +
+            j * sizeof(record),
+        sizeof(record));
+    return record;
+  }
+};
+
+} // namespace
+
+// Layout cache records have variable sizes, so their offsets are computed
+// while checking them.
+static bool YGSnapshotParseLayoutCaches(
+    const char* in,
+    const char* end,
+    YGSnapshotView& view) {
+  view.layoutCacheRecords.reserve(view.header.nodeCount);
+  for (uint32_t i = 0; i < view.header.nodeCount; i++) {
+    YGSnapshotLayoutCache record;
+    if (static_cast<size_t>(end - in) < sizeof(record)) {
+      return false;
+    }
+    std::memcpy(&record, in, sizeof(record));
+    if (record.lastOwnerDirection < -1 ||
+        record.lastOwnerDirection >=
+            facebook::yoga::enums::count<YGDirection>() ||
+        (end - in - sizeof(record)) / sizeof(YGSnapshotMeasurement) <
+            record.measurementCount) {
+      return false;
+    }
+    view.layoutCacheRecords.push_back(in);
+    in += sizeof(record);
+    YGSnapshotMeasurement cachedLayout = record.cachedLayout;
+    if (!YGSnapshotIsValidMeasurement(cachedLayout)) {
+      return false;
+    }
+    for (uint32_t j = 0; j < record.measurementCount; j++) {
+      YGSnapshotMeasurement measurement;
+      std::memcpy(&measurement, in, sizeof(measurement));
+      if (!YGSnapshotIsValidMeasurement(measurement)) {
+        return false;
+      }
+      in += sizeof(measurement);
+    }
+  }
+  return true;
+}
+
+static bool YGSnapshotParse(
+    const void* data,
+    const size_t size,
+    YGSnapshotView& view) {
+  const char* in = static_cast<const char*>(data);
+  YGSnapshotHeader& header = view.header;
+  if (size < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, in, sizeof(header));
+  const bool hasLayout = (header.flags & YGSnapshotHasLayout) != 0;
+  const bool hasLayoutCache = (header.flags & YGSnapshotHasLayoutCache) != 0;
+  if (header.magic != kYGSnapshotMagic ||
+      header.version != kYGSnapshotVersion ||
+      header.styleSize != sizeof(YGStyle) ||
+      header.nodeSize != sizeof(YGSnapshotNode) ||
+      header.layoutSize != sizeof(YGSnapshotLayout) ||
+      (hasLayoutCache &&
+       (!hasLayout ||
+        header.layoutCacheSize != sizeof(YGSnapshotLayoutCache))) ||
+      header.nodeCount == 0) {
+    return false;
+  }
+  const uint64_t expectedSize = sizeof(header) +
+      uint64_t{header.styleCount} * sizeof(YGStyle) +
+      uint64_t{header.nodeCount} *
+          (sizeof(YGSnapshotNode) + (hasLayout ? sizeof(YGSnapshotLayout) : 0));
+  if (size < expectedSize) {
+    return false;
+  }
+  view.styleRecords = in + sizeof(header);
+  view.nodeRecords =
+      view.styleRecords + size_t{header.styleCount} * sizeof(YGStyle);
+  view.layoutRecords = hasLayout
+      ? view.nodeRecords + size_t{header.nodeCount} * sizeof(YGSnapshotNode)
+      : nullptr;
+  if (!YGSnapshotIsValidTree(view.nodeRecords, header)) {
+    return false;
+  }
+  return !hasLayoutCache ||
+      YGSnapshotParseLayoutCaches(in + expectedSize, in + size, view);
+}
+
+YGNodeRef YGNodeSnapshotLoad(
+    const void* data,
+    const size_t size,
+    const YGConfigRef config) {
+  YGSnapshotView view;
+  if (!YGSnapshotParse(data, size, view)) {
+    return nullptr;
+  }
+  const YGSnapshotHeader& header = view.header;
+
+  // Each style is copied once, by the first node using it, and shared with the
+  // others.
+  std::vector<YGSharedStyle> styles(header.styleCount);
+  std::vector<bool> isStyleLoaded(header.styleCount);
+
+  struct Parent {
+    YGNodeRef node;
+    uint32_t pendingChildren;
+    YGVector children;
+  };
+  std::vector<Parent> parents;
+  YGNodeRef root = nullptr;
+  for (uint32_t i = 0; i < header.nodeCount; i++) {
+    const YGSnapshotNode record = view.node(i);
+
+    const YGNodeRef node = YGNodeNewWithConfig(config);
+    if (!isStyleLoaded[record.styleIndex]) {
+      YGStyle style;
+      std::memcpy(
+          &style,
+          view.styleRecords + size_t{record.styleIndex} * sizeof(YGStyle),
+          sizeof(YGStyle));
+      node->setStyle(style);
+      styles[record.styleIndex] = node->getSharedStyle();
+      isStyleLoaded[record.styleIndex] = true;
+    } else {
+      node->setStyle(styles[record.styleIndex]);
+    }
+    node->setNodeType(static_cast<YGNodeType>(record.nodeType));
+    node->setIsReferenceBaseline(
+        (record.flags & YGSnapshotNodeIsReferenceBaseline) != 0);
+    node->setMeasureContentKey(record.measureContentKey);
+    if (view.layoutRecords != nullptr) {
+      node->setLayout(YGSnapshotLoadLayout(view.layout(i)));
+    }
+    node->setHasNewLayout((record.flags & YGSnapshotNodeHasNewLayout) != 0);
+
+    if (parents.empty()) {
+      root = node;
+    } else {
+      Parent& parent = parents.back();
+      parent.children.push_back(node);
+      node->setOwner(parent.node);
+      parent.pendingChildren--;
+    }
+    if (record.childCount > 0) {
+      parents.push_back({node, record.childCount, {}});
+      parents.back().children.reserve(record.childCount);
+    }
+    while (!parents.empty() && parents.back().pendingChildren == 0) {
+      parents.back().node->setChildren(std::move(parents.back().children));
+      parents.pop_back();
+    }
+  }
+  return root;
+}
+
+// Returns the index of the record following the subtree saved at `index`.
+static uint32_t YGSnapshotSkipSubtree(
+    const YGSnapshotView& view,
+    uint32_t index) {
+  uint64_t pendingNodes = 1;
+  while (pendingNodes > 0) {
+    pendingNodes += view.node(index).childCount;
+    pendingNodes--;
+    index++;
+  }
+  return index;
+}
+
+static void YGSnapshotRestoreLayout(
+    const YGSnapshotView& view,
+    const uint32_t index,
+    const YGSnapshotLayoutCache& record,
+    const YGNodeRef node) {
+  YGLayout layout = YGSnapshotLoadLayout(view.layout(index));
+  layout.cachedLayout = YGSnapshotLoadMeasurement(record.cachedLayout);
+  std::copy(
+      record.measuredDimensions,
+      record.measuredDimensions + 2,
+      layout.measuredDimensions.begin());
+  std::copy(
+      record.unroundedFrame,
+      record.unroundedFrame + 4,
+      layout.unroundedFrame.begin());
+  std::copy(
+      record.roundedAbsolutePosition,
+      record.roundedAbsolutePosition + 2,
+      layout.roundedAbsolutePosition.begin());
+  layout.roundedPointScaleFactor = record.roundedPointScaleFactor;
+  layout.needsRounding =
+      (record.flags & YGSnapshotLayoutCacheNeedsRounding) != 0;
+  layout.lastOwnerDirection =
+      static_cast<YGDirection>(record.lastOwnerDirection);
+
+  // Caches grow to hold all saved measurements, even if the config limits
+  // their capacity further than the one they were saved from.
+  const YGConfigRef config = node->getConfig();
+  const YGMeasurementCache::Limits limits = {
+      std::max(config->measureCacheCapacity, record.measurementCount),
+      std::max(config->maxMeasureCacheCapacity, record.measurementCount)};
+  for (uint32_t i = 0; i < record.measurementCount; i++) {
+    bool evicted;
+    layout.cachedMeasurements.add(
+        YGSnapshotLoadMeasurement(view.measurement(index, i)),
+        limits,
+        config->pointScaleFactor,
+        &evicted);
+  }
+  node->setLayout(layout);
+  node->clearStackLayoutState();
+}
+
+// Restores the caches of `node` and its descendants from the records of the
+// subtree saved at `index`, and advances `index` past them. Returns whether
+// the caches of all nodes were restored.
+static bool YGSnapshotRestoreLayoutCache(
+    const YGSnapshotView& view,
+    const YGNodeRef node,
+    uint32_t& index) {
+  const YGSnapshotLayoutCache record = view.layoutCache(index);
+  if (record.fingerprint != YGNodeLayoutFingerprint(node)) {
+    index = YGSnapshotSkipSubtree(view, index);
+    node->setDirty(true);
+    return false;
+  }
+  YGSnapshotRestoreLayout(view, index, record, node);
+  index++;
+
+  // Matching fingerprints imply matching child counts.
+  bool didRestoreChildren = true;
+  for (const YGNodeRef child : node->getChildren()) {
+    didRestoreChildren =
+        YGSnapshotRestoreLayoutCache(view, child, index) && didRestoreChildren;
+  }
+  node->setDirty(
+      !didRestoreChildren ||
+      (record.flags & YGSnapshotLayoutCacheIsDirty) != 0);
+  return didRestoreChildren;
+}
+
+bool YGNodeSnapshotRestoreLayoutCache(
+    const YGNodeRef root,
+    const void* data,
+    const size_t size) {
+  YGSnapshotView view;
+  if (!YGSnapshotParse(data, size, view) ||
+      view.layoutCacheRecords.empty()) {
+    return false;
+  }
+  uint32_t index = 0;
+  return YGSnapshotRestoreLayoutCache(view, root, index);
+}
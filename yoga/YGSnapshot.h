@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "YGStyle.h"
+
+// Binary snapshot of a node tree, as written by YGNodeSnapshotSave. A snapshot
+// is laid out as
+//
+//   YGSnapshotHeader
+//   YGStyle[styleCount]            styles, each shared by one or more nodes
+//   YGSnapshotNode[nodeCount]      nodes in pre-order
+//   YGSnapshotLayout[nodeCount]    only with YGSnapshotHasLayout
+//   for each node, in pre-order,   only with YGSnapshotHasLayoutCache
+//     YGSnapshotLayoutCache
+//     YGSnapshotMeasurement[measurementCount]
+//
+// Records are stored in their in-memory representation, so that a snapshot can
+// be mapped from a file and loaded without parsing. Snapshots are only meant to
+// be loaded by the build of Yoga that saved them: loading fails if the version
+// or any record size differs.
+
+constexpr uint32_t kYGSnapshotMagic = 0x5947534e; // "YGSN"
+constexpr uint16_t kYGSnapshotVersion = 1;
+
+enum YGSnapshotFlags : uint16_t {
+  YGSnapshotHasLayout = 1,
+  // Always set together with YGSnapshotHasLayout.
+  YGSnapshotHasLayoutCache = 2,
+};
+
+struct YGSnapshotHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t flags;
+  uint16_t styleSize;
+  uint16_t nodeSize;
+  uint16_t layoutSize;
+  uint16_t layoutCacheSize;
+  uint32_t styleCount;
+  uint32_t nodeCount;
+};
+
+enum YGSnapshotNodeFlags : uint8_t {
+  YGSnapshotNodeIsReferenceBaseline = 1,
+  YGSnapshotNodeHasNewLayout = 2,
+};
+
+struct YGSnapshotNode {
+  uint32_t styleIndex;
+  uint32_t childCount;
+  uint8_t nodeType;
+  uint8_t flags;
+  uint8_t reserved[6];
+  uint64_t measureContentKey;
+};
+
+struct YGSnapshotLayout {
+  float position[4];
+  float dimensions[2];
+  float margin[6];
+  float border[6];
+  float padding[6];
+  uint8_t direction;
+  uint8_t hadOverflow;
+  uint8_t didUseLegacyFlag;
+  uint8_t doesLegacyStretchFlagAffectsLayout;
+};
+
+struct YGSnapshotMeasurement {
+  float availableWidth;
+  float availableHeight;
+  int32_t widthMeasureMode;
+  int32_t heightMeasureMode;
+  float computedWidth;
+  float computedHeight;
+};
+
+enum YGSnapshotLayoutCacheFlags : uint8_t {
+  YGSnapshotLayoutCacheNeedsRounding = 1,
+  YGSnapshotLayoutCacheIsDirty = 2,
+};
+
+// Layout cache of a node, and the fingerprint of what it was computed from.
+// Caches are only restored onto nodes with the same fingerprint.
+struct YGSnapshotLayoutCache {
+  uint64_t fingerprint;
+  YGSnapshotMeasurement cachedLayout;
+  float measuredDimensions[2];
+  float unroundedFrame[4];
+  float roundedAbsolutePosition[2];
+  float roundedPointScaleFactor;
+  uint32_t measurementCount;
+  int8_t lastOwnerDirection;
+  uint8_t flags;
+  uint8_t reserved[6];
+};
+
+static_assert(
+    std::is_trivially_copyable<YGStyle>::value,
+    "Snapshots store styles as they are laid out in memory");
+static_assert(sizeof(YGStyle) % 4 == 0, "Snapshot records must stay aligned");
+static_assert(sizeof(YGSnapshotHeader) == 24, "Unexpected header size");
+static_assert(sizeof(YGSnapshotNode) == 24, "Unexpected node record size");
+static_assert(sizeof(YGSnapshotLayout) == 100, "Unexpected layout size");
+static_assert(sizeof(YGSnapshotMeasurement) == 24, "Unexpected record size");
+static_assert(sizeof(YGSnapshotLayoutCache) == 80, "Unexpected record size");
@@ -50,3 +50,39 @@ bool operator==(const YGStyle& lhs, const YGStyle& rhs) {
 
   return areNonFloatValuesEqual;
 }
+
+YGSharedStyle::Storage* YGSharedStyle::defaultStorage() {
+  static Storage storage{true, YGStyle{}};
+  return &storage;
+}
+
+static YGStyle YGWebDefaultStyle() {
+  YGStyle style;
+  style.flexDirection = YGFlexDirectionRow;
+  style.alignContent = YGAlignStretch;
+  return style;
+}
+
+YGSharedStyle YGSharedStyle::webDefaults() {
+  static Storage storage{true, YGWebDefaultStyle()};
+  return YGSharedStyle{&storage};
+}
+
+void YGSharedStyle::release() noexcept {
+  if (!storage_->isStatic &&
+      storage_->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete storage_;
+  }
+}
+
+YGStyle& YGSharedStyle::getMutable() {
+  // A reference count of one can only be raised through this handle, so the
+  // storage can be changed in place.
+  if (storage_->isStatic ||
+      storage_->refCount.load(std::memory_order_acquire) != 1) {
+    Storage* storage = new Storage{false, storage_->style};
+    release();
+    storage_ = storage;
+  }
+  return storage_->style;
+}
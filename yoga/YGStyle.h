@@ -7,6 +7,7 @@
 #pragma once
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <initializer_list>
 #include "CompactValue.h"
 #include "YGEnums.h"
@@ -73,3 +74,60 @@ bool operator==(const YGStyle& lhs, const YGStyle& rhs);
 inline bool operator!=(const YGStyle& lhs, const YGStyle& rhs) {
   return !(lhs == rhs);
 }
+
+// Reference counted style, shared by nodes until one of them changes it. All
+// nodes start out sharing the same default style, and clones share the style
+// of the node they were cloned from.
+class YGSharedStyle {
+private:
+  struct Storage {
+    // Static storages are never freed, and not reference counted.
+    bool isStatic;
+    std::atomic<uint32_t> refCount;
+    YGStyle style;
+
+    Storage(bool isStatic, const YGStyle& style)
+        : isStatic(isStatic), refCount(1), style(style) {}
+  };
+  Storage* storage_;
+
+  explicit YGSharedStyle(Storage* storage) noexcept : storage_(storage) {}
+  static Storage* defaultStorage();
+  void retain() const noexcept {
+    if (!storage_->isStatic) {
+      storage_->refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  void release() noexcept;
+
+public:
+  YGSharedStyle() noexcept : storage_(defaultStorage()) {}
+  YGSharedStyle(const YGSharedStyle& other) noexcept
+      : storage_(other.storage_) {
+    retain();
+  }
+  YGSharedStyle& operator=(const YGSharedStyle& other) noexcept {
+    other.retain();
+    release();
+    storage_ = other.storage_;
+    return *this;
+  }
+  ~YGSharedStyle() {
+    release();
+  }
+
+  // The default style with flex direction row and stretched content, as used
+  // for nodes of configs with web defaults.
+  static YGSharedStyle webDefaults();
+
+  const YGStyle& get() const noexcept {
+    return storage_->style;
+  }
+
+  // Returns the style for modification, after copying it if it is shared.
+  YGStyle& getMutable();
+
+  bool isSharedWith(const YGSharedStyle& other) const noexcept {
+    return storage_ == other.storage_;
+  }
+};
@@ -7,12 +7,15 @@
 #pragma once
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <memory>
 #include <vector>
 #include "CompactValue.h"
+#include "SmallVector.h"
 #include "Yoga.h"
 
-using YGVector = std::vector<YGNodeRef>;
+using YGVector = facebook::yoga::detail::SmallVector<YGNodeRef, 4>;
 
 YG_EXTERN_C_BEGIN
 
@@ -29,6 +32,20 @@ void YGNodeCalculateLayoutWithContext(
     YGDirection ownerDirection,
     void* layoutContext);
 
+void YGNodeCalculateLayoutBatchWithContext(
+    const YGNodeRef roots[],
+    const YGLayoutConstraints constraints[],
+    uint32_t count,
+    YGMarkerLayoutData layoutData[],
+    void* layoutContext);
+
+YGLayoutJobRef YGLayoutBeginWithContext(
+    YGNodeRef node,
+    float availableWidth,
+    float availableHeight,
+    YGDirection ownerDirection,
+    void* layoutContext);
+
 void YGSetUsedCachedEntries(size_t);
 
 YG_EXTERN_C_END
@@ -95,8 +112,87 @@ struct YGCachedMeasurement {
 
 // This value was chosen based on empiracle data. Even the most complicated
 // layouts should not require more than 16 entries to fit within the cache.
+// It is the default capacity of measurement caches, which can grow for nodes
+// that keep missing.
 #define YG_MAX_CACHED_RESULT_COUNT 16
 
+// Part of a container's content which is laid out in full, see
+// YGNodeSetVirtualizedWindow. Offsets are along the main axis, relative to the
+// container's leading edge.
+struct YGVirtualizedWindow {
+  float offset;
+  float extent;
+  float estimatedItemSize;
+  float overscan;
+};
+
+// Constraints and running sums of the last layout of a container by
+// YGLayoutPlainStackChildren. Children appended to the container afterwards
+// are stacked from these sums, without visiting the children before them.
+// Kept inline in every node, so it is packed into 40 bytes.
+struct YGStackLayoutState {
+  float availableWidth;
+  float availableHeight;
+  float ownerWidth;
+  float ownerHeight;
+  float sizeConsumed;
+  float availableInnerMainDim;
+  // Main axis offset after the last child, and maximum cross dimension of the
+  // children.
+  float mainDim;
+  float crossDim;
+  uint32_t childCount;
+  YGMeasureMode widthMeasureMode : 2;
+  YGMeasureMode heightMeasureMode : 2;
+  YGDirection direction : 2;
+  bool childrenHadOverflow : 1;
+  // Whether the children use the main size of the container for percentages
+  // or flex bases, and whether they were laid out without being limited by it.
+  bool childrenUseMainSize : 1;
+  bool childrenFitMainSize : 1;
+};
+
+// State of a single layout invocation (YGNodeCalculateLayout and friends).
+// It is created on the stack by the entry point and threaded through the
+// recursive layout functions, so that independent invocations never share
+// mutable state and disjoint trees can be laid out from different threads.
+struct YGLayoutPass {
+  // Generation of this pass. Nodes that were visited during this pass carry
+  // the same value in YGLayout::generationCount.
+  uint32_t generationCount;
+  // Capacity measurement caches are allocated with, and can grow to.
+  uint32_t usedMeasureCacheEntries;
+  uint32_t maxMeasureCacheEntries;
+  // Current recursion depth, only used for debug output.
+  uint32_t depth = 0;
+  bool printChanges = false;
+  bool printSkips = false;
+  // Set while running a task handed to the config's layout executor. Child
+  // layouts are never fanned out again from inside such a task.
+  bool isExecutorTask = false;
+  // When set, every node laid out with performLayout is appended, so changed
+  // frames can be found without walking the whole tree.
+  std::vector<YGNodeRef>* laidOutNodes = nullptr;
+  // Clones children shared with other trees in place of the clone callbacks
+  // of the configs of their owners, see YGLayoutStep.
+  YGCloneNodeFunc cloneNode = nullptr;
+  // Results of the last call to the batch measure function, sorted by node.
+  const std::vector<YGMeasureRequest>* batchedMeasures = nullptr;
+  // Set for steps of time-sliced layouts, see YGLayoutStep. Once the deadline
+  // has passed, and at least minCompletedLayouts nodes were laid out or
+  // measured, the pass is aborted: remaining calls return without doing work,
+  // and nodes whose layout was cut short keep no results.
+  bool hasDeadline = false;
+  bool isAborted = false;
+  uint32_t minCompletedLayouts = 0;
+  uint32_t completedLayouts = 0;
+  std::chrono::steady_clock::time_point deadline;
+
+  // Starts a new generation.
+  YGLayoutPass(YGConfigRef config);
+  YGLayoutPass(YGConfigRef config, uint32_t generationCount);
+};
+
 namespace facebook {
 namespace yoga {
 namespace detail {
@@ -146,6 +242,37 @@ public:
   Values& operator=(const Values& other) = default;
 };
 
+// Owning pointer to a value that is only created when first needed. Copies
+// are deep, so it can be a member of copyable types.
+template <typename T>
+class LazyValue {
+private:
+  std::unique_ptr<T> value_;
+
+public:
+  LazyValue() = default;
+  LazyValue(const LazyValue& other)
+      : value_(other.value_ ? new T(*other.value_) : nullptr) {}
+  LazyValue(LazyValue&&) noexcept = default;
+
+  LazyValue& operator=(const LazyValue& other) {
+    value_.reset(other.value_ ? new T(*other.value_) : nullptr);
+    return *this;
+  }
+  LazyValue& operator=(LazyValue&&) noexcept = default;
+
+  const T* get() const noexcept {
+    return value_.get();
+  }
+
+  T& getOrCreate() {
+    if (!value_) {
+      value_.reset(new T());
+    }
+    return *value_;
+  }
+};
+
 } // namespace detail
 } // namespace yoga
 } // namespace facebook
@@ -9,9 +9,12 @@
 #include <float.h>
 #include <string.h>
 #include <algorithm>
+#include <atomic>
 #include "Utils.h"
 #include "YGNode.h"
+#include "YGNodeArena.h"
 #include "YGNodePrint.h"
+#include "YGPixelGrid.h"
 #include "Yoga-internal.h"
 #include "instrumentation.h"
 #ifdef _MSC_VER
@@ -29,12 +32,13 @@ using namespace facebook::yoga;
 using detail::Log;
 
 namespace {
-size_t usedMeasureCacheEntries = YG_MAX_CACHED_RESULT_COUNT;
-}
+// Limits the initial capacity of measurement caches of all configs, 0 if
+// unlimited.
+std::atomic<size_t> usedMeasureCacheEntries{0};
+} // namespace
 
 void YGSetUsedCachedEntries(size_t n) {
-  usedMeasureCacheEntries =
-      n == 0 || n > YG_MAX_CACHED_RESULT_COUNT ? YG_MAX_CACHED_RESULT_COUNT : n;
+  usedMeasureCacheEntries = n > YG_MAX_CACHED_RESULT_COUNT ? 0 : n;
 }
 
 #ifdef ANDROID
@@ -178,6 +182,38 @@ void YGNodeSetDirtiedFunc(YGNodeRef node, YGDirtiedFunc dirtiedFunc) {
   node->setDirtiedFunc(dirtiedFunc);
 }
 
+void YGNodeSetMeasureContentKey(YGNodeRef node, uint64_t key) {
+  node->setMeasureContentKey(key);
+}
+
+uint64_t YGNodeGetMeasureContentKey(YGNodeRef node) {
+  return node->getMeasureContentKey();
+}
+
+void YGNodeSetVirtualizedWindow(
+    YGNodeRef node,
+    float offset,
+    float extent,
+    float estimatedItemSize,
+    float overscan) {
+  const YGVirtualizedWindow* current = node->getVirtualizedWindow();
+  if (current != nullptr && current->offset == offset &&
+      current->extent == extent &&
+      current->estimatedItemSize == estimatedItemSize &&
+      current->overscan == overscan) {
+    return;
+  }
+  node->setVirtualizedWindow({offset, extent, estimatedItemSize, overscan});
+  node->markDirtyAndPropogate();
+}
+
+void YGNodeClearVirtualizedWindow(YGNodeRef node) {
+  if (node->getVirtualizedWindow() != nullptr) {
+    node->clearVirtualizedWindow();
+    node->markDirtyAndPropogate();
+  }
+}
+
 void YGNodeSetPrintFunc(YGNodeRef node, YGPrintFunc printFunc) {
   node->setPrintFunc(printFunc);
 }
@@ -214,18 +250,18 @@ void YGNodeMarkDirtyAndPropogateToDescendants(const YGNodeRef node) {
   return node->markDirtyAndPropogateDownwards();
 }
 
-int32_t gNodeInstanceCount = 0;
-int32_t gConfigInstanceCount = 0;
+std::atomic<int32_t> gNodeInstanceCount{0};
+std::atomic<int32_t> gConfigInstanceCount{0};
 
 WIN_EXPORT YGNodeRef YGNodeNewWithConfig(const YGConfigRef config) {
-  const YGNodeRef node = new YGNode();
+  const YGNodeRef node =
+      config->nodeArena ? config->nodeArena->newNode() : new YGNode();
   YGAssertWithConfig(
       config, node != nullptr, "Could not allocate memory for node");
   gNodeInstanceCount++;
 
   if (config->useWebDefaults) {
-    node->setStyleFlexDirection(YGFlexDirectionRow);
-    node->setStyleAlignContent(YGAlignStretch);
+    node->setStyle(YGSharedStyle::webDefaults());
   }
   node->setConfig(config);
   return node;
@@ -241,12 +277,15 @@ YGNodeRef YGNodeNew(void) {
 }
 
 YGNodeRef YGNodeClone(YGNodeRef oldNode) {
-  YGNodeRef node = new YGNode(*oldNode);
+  YGNodeArena* arena =
+      oldNode->getConfig() ? oldNode->getConfig()->nodeArena : nullptr;
+  YGNodeRef node = arena ? arena->newNode(*oldNode) : new YGNode(*oldNode);
   YGAssertWithConfig(
       oldNode->getConfig(),
       node != nullptr,
       "Could not allocate memory for node");
   gNodeInstanceCount++;
+  node->setIsArenaAllocated(arena != nullptr);
   node->setOwner(nullptr);
   return node;
 }
@@ -271,7 +310,7 @@ static YGNodeRef YGNodeDeepClone(YGNodeRef oldNode) {
     childNode->setOwner(node);
     vec.push_back(childNode);
   }
-  node->setChildren(vec);
+  node->setChildren(std::move(vec));
 
   if (oldNode->getConfig() != nullptr) {
     node->setConfig(YGConfigClone(*(oldNode->getConfig())));
@@ -293,7 +332,11 @@ void YGNodeFree(const YGNodeRef node) {
   }
 
   node->clearChildren();
-  delete node;
+  if (node->isArenaAllocated()) {
+    YGNodeArena::deleteNode(node);
+  } else {
+    delete node;
+  }
   gNodeInstanceCount--;
 }
 
@@ -359,8 +402,27 @@ void YGConfigFree(const YGConfigRef config) {
   gConfigInstanceCount--;
 }
 
+void YGConfigSetNodeArena(
+    const YGConfigRef config,
+    const YGNodeArenaRef arena) {
+  config->nodeArena = arena;
+}
+
+YGNodeArenaRef YGNodeArenaNew(void) {
+  return new YGNodeArena();
+}
+
+void YGNodeArenaFree(const YGNodeArenaRef arena) {
+  YGNodeArenaReset(arena);
+  delete arena;
+}
+
+void YGNodeArenaReset(const YGNodeArenaRef arena) {
+  gNodeInstanceCount -= static_cast<int32_t>(arena->reset());
+}
+
 void YGConfigCopy(const YGConfigRef dest, const YGConfigRef src) {
-  memcpy(dest, src, sizeof(YGConfig));
+  *dest = *src;
 }
 
 void YGNodeSetIsReferenceBaseline(YGNodeRef node, bool isReferenceBaseline) {
@@ -390,7 +452,7 @@ void YGNodeInsertChild(
 
   owner->insertChild(child, index);
   child->setOwner(owner);
-  owner->markDirtyAndPropogate();
+  owner->markDirtyAndPropogateFromChild(child);
 }
 
 void YGNodeRemoveChild(const YGNodeRef owner, const YGNodeRef excludedChild) {
@@ -439,7 +501,7 @@ void YGNodeRemoveAllChildren(const YGNodeRef owner) {
 
 static void YGNodeSetChildrenInternal(
     YGNodeRef const owner,
-    const std::vector<YGNodeRef>& children) {
+    YGVector&& children) {
   if (!owner) {
     return;
   }
@@ -464,8 +526,8 @@ static void YGNodeSetChildrenInternal(
         }
       }
     }
-    owner->setChildren(children);
-    for (YGNodeRef child : children) {
+    owner->setChildren(std::move(children));
+    for (YGNodeRef child : owner->getChildren()) {
       child->setOwner(owner);
     }
     owner->markDirtyAndPropogate();
@@ -476,14 +538,14 @@ void YGNodeSetChildren(
     YGNodeRef const owner,
     const YGNodeRef c[],
     const uint32_t count) {
-  const YGVector children = {c, c + count};
-  YGNodeSetChildrenInternal(owner, children);
+  YGNodeSetChildrenInternal(owner, YGVector(c, c + count));
 }
 
 void YGNodeSetChildren(
     YGNodeRef const owner,
     const std::vector<YGNodeRef>& children) {
-  YGNodeSetChildrenInternal(owner, children);
+  YGNodeSetChildrenInternal(
+      owner, YGVector(children.data(), children.data() + children.size()));
 }
 
 YGNodeRef YGNodeGetChild(const YGNodeRef node, const uint32_t index) {
@@ -516,8 +578,15 @@ void YGNodeMarkDirty(const YGNodeRef node) {
 }
 
 void YGNodeCopyStyle(const YGNodeRef dstNode, const YGNodeRef srcNode) {
-  if (!(dstNode->getStyle() == srcNode->getStyle())) {
-    dstNode->setStyle(srcNode->getStyle());
+  const YGSharedStyle& style = srcNode->getSharedStyle();
+  if (dstNode->getSharedStyle().isSharedWith(style)) {
+    return;
+  }
+  // Equal styles are shared as well, so copying them again is a pointer
+  // comparison.
+  const bool isDirty = dstNode->getStyle() != style.get();
+  dstNode->setStyle(style);
+  if (isDirty) {
     dstNode->markDirtyAndPropogate();
   }
 }
@@ -569,7 +638,7 @@ struct DimensionProp {
   static void set(YGNodeRef node, float newValue) {
     auto value = Value::create<U>(newValue);
     if ((node->getStyle().*P)[idx] != value) {
-      (node->getStyle().*P)[idx] = value;
+      (node->getMutableStyle().*P)[idx] = value;
       node->markDirtyAndPropogate();
     }
   }
@@ -577,30 +646,30 @@ struct DimensionProp {
 
 } // namespace
 
-#define YG_NODE_STYLE_PROPERTY_SETTER_UNIT_AUTO_IMPL(                      \
-    type, name, paramName, instanceName)                                   \
-  void YGNodeStyleSet##name(const YGNodeRef node, const type paramName) {  \
-    auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(paramName);    \
-    if (node->getStyle().instanceName != value) {                          \
-      node->getStyle().instanceName = value;                               \
-      node->markDirtyAndPropogate();                                       \
-    }                                                                      \
-  }                                                                        \
-                                                                           \
-  void YGNodeStyleSet##name##Percent(                                      \
-      const YGNodeRef node, const type paramName) {                        \
-    auto value = detail::CompactValue::ofMaybe<YGUnitPercent>(paramName);  \
-    if (node->getStyle().instanceName != value) {                          \
-      node->getStyle().instanceName = value;                               \
-      node->markDirtyAndPropogate();                                       \
-    }                                                                      \
-  }                                                                        \
-                                                                           \
-  void YGNodeStyleSet##name##Auto(const YGNodeRef node) {                  \
-    if (node->getStyle().instanceName != detail::CompactValue::ofAuto()) { \
-      node->getStyle().instanceName = detail::CompactValue::ofAuto();      \
-      node->markDirtyAndPropogate();                                       \
-    }                                                                      \
+#define YG_NODE_STYLE_PROPERTY_SETTER_UNIT_AUTO_IMPL(                        \
+    type, name, paramName, instanceName)                                     \
+  void YGNodeStyleSet##name(const YGNodeRef node, const type paramName) {    \
+    auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(paramName);      \
+    if (node->getStyle().instanceName != value) {                            \
+      node->getMutableStyle().instanceName = value;                          \
+      node->markDirtyAndPropogate();                                         \
+    }                                                                        \
+  }                                                                          \
+                                                                             \
+  void YGNodeStyleSet##name##Percent(                                        \
+      const YGNodeRef node, const type paramName) {                          \
+    auto value = detail::CompactValue::ofMaybe<YGUnitPercent>(paramName);    \
+    if (node->getStyle().instanceName != value) {                            \
+      node->getMutableStyle().instanceName = value;                          \
+      node->markDirtyAndPropogate();                                         \
+    }                                                                        \
+  }                                                                          \
+                                                                             \
+  void YGNodeStyleSet##name##Auto(const YGNodeRef node) {                    \
+    if (node->getStyle().instanceName != detail::CompactValue::ofAuto()) {   \
+      node->getMutableStyle().instanceName = detail::CompactValue::ofAuto(); \
+      node->markDirtyAndPropogate();                                         \
+    }                                                                        \
   }
 
 #define YG_NODE_STYLE_PROPERTY_UNIT_AUTO_IMPL(                       \
@@ -620,7 +689,8 @@ struct DimensionProp {
   void YGNodeStyleSet##name##Auto(const YGNodeRef node, const YGEdge edge) { \
     if (node->getStyle().instanceName[edge] !=                               \
         detail::CompactValue::ofAuto()) {                                    \
-      node->getStyle().instanceName[edge] = detail::CompactValue::ofAuto();  \
+      node->getMutableStyle().instanceName[edge] =                           \
+          detail::CompactValue::ofAuto();                                    \
       node->markDirtyAndPropogate();                                         \
     }                                                                        \
   }
@@ -631,7 +701,7 @@ struct DimensionProp {
       const YGNodeRef node, const YGEdge edge, const float paramName) {   \
     auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(paramName);   \
     if (node->getStyle().instanceName[edge] != value) {                   \
-      node->getStyle().instanceName[edge] = value;                        \
+      node->getMutableStyle().instanceName[edge] = value;                 \
       node->markDirtyAndPropogate();                                      \
     }                                                                     \
   }                                                                       \
@@ -640,7 +710,7 @@ struct DimensionProp {
       const YGNodeRef node, const YGEdge edge, const float paramName) {   \
     auto value = detail::CompactValue::ofMaybe<YGUnitPercent>(paramName); \
     if (node->getStyle().instanceName[edge] != value) {                   \
-      node->getStyle().instanceName[edge] = value;                        \
+      node->getMutableStyle().instanceName[edge] = value;                 \
       node->markDirtyAndPropogate();                                      \
     }                                                                     \
   }                                                                       \
@@ -686,7 +756,7 @@ struct DimensionProp {
 
 #define YG_NODE_STYLE_SET(node, property, value) \
   if (node->getStyle().property != value) {      \
-    node->getStyle().property = value;           \
+    node->getMutableStyle().property = value;    \
     node->markDirtyAndPropogate();               \
   }
 
@@ -771,7 +841,7 @@ YGDisplay YGNodeStyleGetDisplay(const YGNodeRef node) {
 // TODO(T26792433): Change the API to accept YGFloatOptional.
 void YGNodeStyleSetFlex(const YGNodeRef node, const float flex) {
   if (node->getStyle().flex != flex) {
-    node->getStyle().flex =
+    node->getMutableStyle().flex =
         YGFloatIsUndefined(flex) ? YGFloatOptional() : YGFloatOptional(flex);
     node->markDirtyAndPropogate();
   }
@@ -786,7 +856,7 @@ float YGNodeStyleGetFlex(const YGNodeRef node) {
 // TODO(T26792433): Change the API to accept YGFloatOptional.
 void YGNodeStyleSetFlexGrow(const YGNodeRef node, const float flexGrow) {
   if (node->getStyle().flexGrow != flexGrow) {
-    node->getStyle().flexGrow = YGFloatIsUndefined(flexGrow)
+    node->getMutableStyle().flexGrow = YGFloatIsUndefined(flexGrow)
         ? YGFloatOptional()
         : YGFloatOptional(flexGrow);
     node->markDirtyAndPropogate();
@@ -796,7 +866,7 @@ void YGNodeStyleSetFlexGrow(const YGNodeRef node, const float flexGrow) {
 // TODO(T26792433): Change the API to accept YGFloatOptional.
 void YGNodeStyleSetFlexShrink(const YGNodeRef node, const float flexShrink) {
   if (node->getStyle().flexShrink != flexShrink) {
-    node->getStyle().flexShrink = YGFloatIsUndefined(flexShrink)
+    node->getMutableStyle().flexShrink = YGFloatIsUndefined(flexShrink)
         ? YGFloatOptional()
         : YGFloatOptional(flexShrink);
     node->markDirtyAndPropogate();
@@ -815,7 +885,7 @@ YGValue YGNodeStyleGetFlexBasis(const YGNodeRef node) {
 void YGNodeStyleSetFlexBasis(const YGNodeRef node, const float flexBasis) {
   auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(flexBasis);
   if (node->getStyle().flexBasis != value) {
-    node->getStyle().flexBasis = value;
+    node->getMutableStyle().flexBasis = value;
     node->markDirtyAndPropogate();
   }
 }
@@ -825,14 +895,14 @@ void YGNodeStyleSetFlexBasisPercent(
     const float flexBasisPercent) {
   auto value = detail::CompactValue::ofMaybe<YGUnitPercent>(flexBasisPercent);
   if (node->getStyle().flexBasis != value) {
-    node->getStyle().flexBasis = value;
+    node->getMutableStyle().flexBasis = value;
     node->markDirtyAndPropogate();
   }
 }
 
 void YGNodeStyleSetFlexBasisAuto(const YGNodeRef node) {
   if (node->getStyle().flexBasis != detail::CompactValue::ofAuto()) {
-    node->getStyle().flexBasis = detail::CompactValue::ofAuto();
+    node->getMutableStyle().flexBasis = detail::CompactValue::ofAuto();
     node->markDirtyAndPropogate();
   }
 }
@@ -849,7 +919,7 @@ void YGNodeStyleSetBorder(
     const float border) {
   auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(border);
   if (node->getStyle().border[edge] != value) {
-    node->getStyle().border[edge] = value;
+    node->getMutableStyle().border[edge] = value;
     node->markDirtyAndPropogate();
   }
 }
@@ -877,7 +947,7 @@ float YGNodeStyleGetAspectRatio(const YGNodeRef node) {
 // TODO(T26792433): Change the API to accept YGFloatOptional.
 void YGNodeStyleSetAspectRatio(const YGNodeRef node, const float aspectRatio) {
   if (node->getStyle().aspectRatio != aspectRatio) {
-    node->getStyle().aspectRatio = YGFloatOptional(aspectRatio);
+    node->getMutableStyle().aspectRatio = YGFloatOptional(aspectRatio);
     node->markDirtyAndPropogate();
   }
 }
@@ -962,7 +1032,23 @@ bool YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(const YGNodeRef node) {
   return node->getLayout().doesLegacyStretchFlagAffectsLayout;
 }
 
-uint32_t gCurrentGenerationCount = 0;
+std::atomic<uint32_t> gCurrentGenerationCount{0};
+
+YGLayoutPass::YGLayoutPass(YGConfigRef config)
+    : YGLayoutPass(config, ++gCurrentGenerationCount) {}
+
+YGLayoutPass::YGLayoutPass(YGConfigRef config, uint32_t generationCount)
+    : generationCount(generationCount),
+      usedMeasureCacheEntries(
+          ::usedMeasureCacheEntries == 0
+              ? config->measureCacheCapacity
+              : std::min(
+                    config->measureCacheCapacity,
+                    static_cast<uint32_t>(::usedMeasureCacheEntries))),
+      maxMeasureCacheEntries(std::max(
+          config->maxMeasureCacheCapacity, usedMeasureCacheEntries)),
+      printChanges(config->printChanges),
+      printSkips(config->printSkips) {}
 
 bool YGLayoutNodeInternal(
     const YGNodeRef node,
@@ -977,7 +1063,17 @@ bool YGLayoutNodeInternal(
     const char* reason,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
-    void* const layoutContext);
+    void* const layoutContext,
+    YGLayoutPass& layoutPass);
+
+static YGCachedMeasurement* YGNodeFindCachedMeasurement(
+    const YGNodeRef node,
+    const float availableWidth,
+    const float availableHeight,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const YGConfigRef config);
 
 #ifdef DEBUG
 static void YGNodePrintInternal(
@@ -1210,6 +1306,171 @@ static void YGConstrainMaxSizeForMode(
   }
 }
 
+// Whether the flex basis of `child` is found by measuring it, rather than
+// taken from its style.
+static bool YGNodeFlexBasisNeedsMeasure(
+    const YGNodeRef node,
+    const YGNodeRef child,
+    const float width,
+    const float height,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection direction) {
+  const YGFlexDirection mainAxis =
+      YGResolveFlexDirection(node->getStyle().flexDirection, direction);
+  const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
+  const float mainAxisSize = isMainAxisRow ? width : height;
+  const float mainAxisownerSize = isMainAxisRow ? ownerWidth : ownerHeight;
+
+  if (!YGResolveValue(child->resolveFlexBasisPtr(), mainAxisownerSize)
+           .isUndefined() &&
+      !YGFloatIsUndefined(mainAxisSize)) {
+    return false;
+  }
+  return isMainAxisRow
+      ? !YGNodeIsStyleDimDefined(child, YGFlexDirectionRow, ownerWidth)
+      : !YGNodeIsStyleDimDefined(child, YGFlexDirectionColumn, ownerHeight);
+}
+
+// Computes the constraints under which `child` is measured to find its flex
+// basis.
+static void YGNodeFlexBasisMeasureConstraints(
+    const YGNodeRef node,
+    const YGNodeRef child,
+    const float width,
+    const YGMeasureMode widthMode,
+    const float height,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGMeasureMode heightMode,
+    const YGDirection direction,
+    float* outWidth,
+    float* outHeight,
+    YGMeasureMode* outWidthMeasureMode,
+    YGMeasureMode* outHeightMeasureMode) {
+  const YGFlexDirection mainAxis =
+      YGResolveFlexDirection(node->getStyle().flexDirection, direction);
+  const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
+  const bool isRowStyleDimDefined =
+      YGNodeIsStyleDimDefined(child, YGFlexDirectionRow, ownerWidth);
+  const bool isColumnStyleDimDefined =
+      YGNodeIsStyleDimDefined(child, YGFlexDirectionColumn, ownerHeight);
+
+  float childWidth = YGUndefined;
+  float childHeight = YGUndefined;
+  YGMeasureMode childWidthMeasureMode = YGMeasureModeUndefined;
+  YGMeasureMode childHeightMeasureMode = YGMeasureModeUndefined;
+
+  auto marginRow =
+      child->getMarginForAxis(YGFlexDirectionRow, ownerWidth).unwrap();
+  auto marginColumn =
+      child->getMarginForAxis(YGFlexDirectionColumn, ownerWidth).unwrap();
+
+  if (isRowStyleDimDefined) {
+    childWidth =
+        YGResolveValue(
+            child->getResolvedDimension(YGDimensionWidth), ownerWidth)
+            .unwrap() +
+        marginRow;
+    childWidthMeasureMode = YGMeasureModeExactly;
+  }
+  if (isColumnStyleDimDefined) {
+    childHeight =
+        YGResolveValue(
+            child->getResolvedDimension(YGDimensionHeight), ownerHeight)
+            .unwrap() +
+        marginColumn;
+    childHeightMeasureMode = YGMeasureModeExactly;
+  }
+
+  // The W3C spec doesn't say anything about the 'overflow' property, but all
+  // major browsers appear to implement the following logic.
+  if ((!isMainAxisRow && node->getStyle().overflow == YGOverflowScroll) ||
+      node->getStyle().overflow != YGOverflowScroll) {
+    if (YGFloatIsUndefined(childWidth) && !YGFloatIsUndefined(width)) {
+      childWidth = width;
+      childWidthMeasureMode = YGMeasureModeAtMost;
+    }
+  }
+
+  if ((isMainAxisRow && node->getStyle().overflow == YGOverflowScroll) ||
+      node->getStyle().overflow != YGOverflowScroll) {
+    if (YGFloatIsUndefined(childHeight) && !YGFloatIsUndefined(height)) {
+      childHeight = height;
+      childHeightMeasureMode = YGMeasureModeAtMost;
+    }
+  }
+
+  if (!child->getStyle().aspectRatio.isUndefined()) {
+    if (!isMainAxisRow && childWidthMeasureMode == YGMeasureModeExactly) {
+      childHeight = marginColumn +
+          (childWidth - marginRow) / child->getStyle().aspectRatio.unwrap();
+      childHeightMeasureMode = YGMeasureModeExactly;
+    } else if (
+        isMainAxisRow && childHeightMeasureMode == YGMeasureModeExactly) {
+      childWidth = marginRow +
+          (childHeight - marginColumn) * child->getStyle().aspectRatio.unwrap();
+      childWidthMeasureMode = YGMeasureModeExactly;
+    }
+  }
+
+  // If child has no defined size in the cross axis and is set to stretch, set
+  // the cross axis to be measured exactly with the available inner width
+
+  const bool hasExactWidth =
+      !YGFloatIsUndefined(width) && widthMode == YGMeasureModeExactly;
+  const bool childWidthStretch =
+      YGNodeAlignItem(node, child) == YGAlignStretch &&
+      childWidthMeasureMode != YGMeasureModeExactly;
+  if (!isMainAxisRow && !isRowStyleDimDefined && hasExactWidth &&
+      childWidthStretch) {
+    childWidth = width;
+    childWidthMeasureMode = YGMeasureModeExactly;
+    if (!child->getStyle().aspectRatio.isUndefined()) {
+      childHeight =
+          (childWidth - marginRow) / child->getStyle().aspectRatio.unwrap();
+      childHeightMeasureMode = YGMeasureModeExactly;
+    }
+  }
+
+  const bool hasExactHeight =
+      !YGFloatIsUndefined(height) && heightMode == YGMeasureModeExactly;
+  const bool childHeightStretch =
+      YGNodeAlignItem(node, child) == YGAlignStretch &&
+      childHeightMeasureMode != YGMeasureModeExactly;
+  if (isMainAxisRow && !isColumnStyleDimDefined && hasExactHeight &&
+      childHeightStretch) {
+    childHeight = height;
+    childHeightMeasureMode = YGMeasureModeExactly;
+
+    if (!child->getStyle().aspectRatio.isUndefined()) {
+      childWidth = (childHeight - marginColumn) *
+          child->getStyle().aspectRatio.unwrap();
+      childWidthMeasureMode = YGMeasureModeExactly;
+    }
+  }
+
+  YGConstrainMaxSizeForMode(
+      child,
+      YGFlexDirectionRow,
+      ownerWidth,
+      ownerWidth,
+      &childWidthMeasureMode,
+      &childWidth);
+  YGConstrainMaxSizeForMode(
+      child,
+      YGFlexDirectionColumn,
+      ownerHeight,
+      ownerWidth,
+      &childHeightMeasureMode,
+      &childHeight);
+
+  *outWidth = childWidth;
+  *outHeight = childHeight;
+  *outWidthMeasureMode = childWidthMeasureMode;
+  *outHeightMeasureMode = childHeightMeasureMode;
+}
+
 static void YGNodeComputeFlexBasisForChild(
     const YGNodeRef node,
     const YGNodeRef child,
@@ -1222,7 +1483,8 @@ static void YGNodeComputeFlexBasisForChild(
     const YGDirection direction,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
-    void* const layoutContext) {
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
   const YGFlexDirection mainAxis =
       YGResolveFlexDirection(node->getStyle().flexDirection, direction);
   const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
@@ -1246,7 +1508,7 @@ static void YGNodeComputeFlexBasisForChild(
         (YGConfigIsExperimentalFeatureEnabled(
              child->getConfig(), YGExperimentalFeatureWebFlexBasis) &&
          child->getLayout().computedFlexBasisGeneration !=
-             gCurrentGenerationCount)) {
+             layoutPass.generationCount)) {
       const YGFloatOptional paddingAndBorder = YGFloatOptional(
           YGNodePaddingAndBorderForAxis(child, mainAxis, ownerWidth));
       child->setLayoutComputedFlexBasis(
@@ -1273,115 +1535,20 @@ static void YGNodeComputeFlexBasisForChild(
   } else {
     // Compute the flex basis and hypothetical main size (i.e. the clamped flex
     // basis).
-    childWidth = YGUndefined;
-    childHeight = YGUndefined;
-    childWidthMeasureMode = YGMeasureModeUndefined;
-    childHeightMeasureMode = YGMeasureModeUndefined;
-
-    auto marginRow =
-        child->getMarginForAxis(YGFlexDirectionRow, ownerWidth).unwrap();
-    auto marginColumn =
-        child->getMarginForAxis(YGFlexDirectionColumn, ownerWidth).unwrap();
-
-    if (isRowStyleDimDefined) {
-      childWidth =
-          YGResolveValue(
-              child->getResolvedDimension(YGDimensionWidth), ownerWidth)
-              .unwrap() +
-          marginRow;
-      childWidthMeasureMode = YGMeasureModeExactly;
-    }
-    if (isColumnStyleDimDefined) {
-      childHeight =
-          YGResolveValue(
-              child->getResolvedDimension(YGDimensionHeight), ownerHeight)
-              .unwrap() +
-          marginColumn;
-      childHeightMeasureMode = YGMeasureModeExactly;
-    }
-
-    // The W3C spec doesn't say anything about the 'overflow' property, but all
-    // major browsers appear to implement the following logic.
-    if ((!isMainAxisRow && node->getStyle().overflow == YGOverflowScroll) ||
-        node->getStyle().overflow != YGOverflowScroll) {
-      if (YGFloatIsUndefined(childWidth) && !YGFloatIsUndefined(width)) {
-        childWidth = width;
-        childWidthMeasureMode = YGMeasureModeAtMost;
-      }
-    }
-
-    if ((isMainAxisRow && node->getStyle().overflow == YGOverflowScroll) ||
-        node->getStyle().overflow != YGOverflowScroll) {
-      if (YGFloatIsUndefined(childHeight) && !YGFloatIsUndefined(height)) {
-        childHeight = height;
-        childHeightMeasureMode = YGMeasureModeAtMost;
-      }
-    }
-
-    if (!child->getStyle().aspectRatio.isUndefined()) {
-      if (!isMainAxisRow && childWidthMeasureMode == YGMeasureModeExactly) {
-        childHeight = marginColumn +
-            (childWidth - marginRow) / child->getStyle().aspectRatio.unwrap();
-        childHeightMeasureMode = YGMeasureModeExactly;
-      } else if (
-          isMainAxisRow && childHeightMeasureMode == YGMeasureModeExactly) {
-        childWidth = marginRow +
-            (childHeight - marginColumn) *
-                child->getStyle().aspectRatio.unwrap();
-        childWidthMeasureMode = YGMeasureModeExactly;
-      }
-    }
-
-    // If child has no defined size in the cross axis and is set to stretch, set
-    // the cross axis to be measured exactly with the available inner width
-
-    const bool hasExactWidth =
-        !YGFloatIsUndefined(width) && widthMode == YGMeasureModeExactly;
-    const bool childWidthStretch =
-        YGNodeAlignItem(node, child) == YGAlignStretch &&
-        childWidthMeasureMode != YGMeasureModeExactly;
-    if (!isMainAxisRow && !isRowStyleDimDefined && hasExactWidth &&
-        childWidthStretch) {
-      childWidth = width;
-      childWidthMeasureMode = YGMeasureModeExactly;
-      if (!child->getStyle().aspectRatio.isUndefined()) {
-        childHeight =
-            (childWidth - marginRow) / child->getStyle().aspectRatio.unwrap();
-        childHeightMeasureMode = YGMeasureModeExactly;
-      }
-    }
-
-    const bool hasExactHeight =
-        !YGFloatIsUndefined(height) && heightMode == YGMeasureModeExactly;
-    const bool childHeightStretch =
-        YGNodeAlignItem(node, child) == YGAlignStretch &&
-        childHeightMeasureMode != YGMeasureModeExactly;
-    if (isMainAxisRow && !isColumnStyleDimDefined && hasExactHeight &&
-        childHeightStretch) {
-      childHeight = height;
-      childHeightMeasureMode = YGMeasureModeExactly;
-
-      if (!child->getStyle().aspectRatio.isUndefined()) {
-        childWidth = (childHeight - marginColumn) *
-            child->getStyle().aspectRatio.unwrap();
-        childWidthMeasureMode = YGMeasureModeExactly;
-      }
-    }
-
-    YGConstrainMaxSizeForMode(
+    YGNodeFlexBasisMeasureConstraints(
+        node,
         child,
-        YGFlexDirectionRow,
+        width,
+        widthMode,
+        height,
         ownerWidth,
-        ownerWidth,
-        &childWidthMeasureMode,
-        &childWidth);
-    YGConstrainMaxSizeForMode(
-        child,
-        YGFlexDirectionColumn,
         ownerHeight,
-        ownerWidth,
-        &childHeightMeasureMode,
-        &childHeight);
+        heightMode,
+        direction,
+        &childWidth,
+        &childHeight,
+        &childWidthMeasureMode,
+        &childHeightMeasureMode);
 
     // Measure the child
     YGLayoutNodeInternal(
@@ -1397,13 +1564,14 @@ static void YGNodeComputeFlexBasisForChild(
         "measure",
         config,
         layoutMarkerData,
-        layoutContext);
+        layoutContext,
+        layoutPass);
 
     child->setLayoutComputedFlexBasis(YGFloatOptional(YGFloatMax(
         child->getLayout().measuredDimensions[dim[mainAxis]],
         YGNodePaddingAndBorderForAxis(child, mainAxis, ownerWidth))));
   }
-  child->setLayoutComputedFlexBasisGeneration(gCurrentGenerationCount);
+  child->setLayoutComputedFlexBasisGeneration(layoutPass.generationCount);
 }
 
 static void YGNodeAbsoluteLayoutChild(
@@ -1415,7 +1583,8 @@ static void YGNodeAbsoluteLayoutChild(
     const YGDirection direction,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
-    void* const layoutContext) {
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
   const YGFlexDirection mainAxis =
       YGResolveFlexDirection(node->getStyle().flexDirection, direction);
   const YGFlexDirection crossAxis = YGFlexDirectionCross(mainAxis, direction);
@@ -1521,7 +1690,8 @@ static void YGNodeAbsoluteLayoutChild(
         "abs-measure",
         config,
         layoutMarkerData,
-        layoutContext);
+        layoutContext,
+        layoutPass);
     childWidth = child->getLayout().measuredDimensions[YGDimensionWidth] +
         child->getMarginForAxis(YGFlexDirectionRow, width).unwrap();
     childHeight = child->getLayout().measuredDimensions[YGDimensionHeight] +
@@ -1541,7 +1711,8 @@ static void YGNodeAbsoluteLayoutChild(
       "abs-layout",
       config,
       layoutMarkerData,
-      layoutContext);
+      layoutContext,
+      layoutPass);
 
   if (child->isTrailingPosDefined(mainAxis) &&
       !child->isLeadingPositionDefined(mainAxis)) {
@@ -1601,6 +1772,194 @@ static void YGNodeAbsoluteLayoutChild(
   }
 }
 
+// Returns the size passed to the measure function of a node along an axis. We
+// want to make sure we don't call measure with negative size.
+static float YGNodeMeasureInnerSize(
+    const YGNodeRef node,
+    const YGFlexDirection axis,
+    const float availableSize,
+    const float availableWidth) {
+  if (YGFloatIsUndefined(availableSize)) {
+    return availableSize;
+  }
+  const float margin = node->getMarginForAxis(axis, availableWidth).unwrap();
+  const float paddingAndBorder =
+      YGNodePaddingAndBorderForAxis(node, axis, availableWidth);
+  return YGFloatMax(0, availableSize - margin - paddingAndBorder);
+}
+
+// Adds the measurement which YGLayoutNodeInternal would request from the
+// measure function of `node` under the given constraints, unless the node has
+// no measure function, or the result would be taken from its cache.
+static void YGAddMeasureRequest(
+    std::vector<YGMeasureRequest>& requests,
+    const YGNodeRef node,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection ownerDirection,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const YGConfigRef config,
+    const YGLayoutPass& layoutPass) {
+  if (!node->hasMeasureFunc() ||
+      (widthMeasureMode == YGMeasureModeExactly &&
+       heightMeasureMode == YGMeasureModeExactly)) {
+    return;
+  }
+
+  const YGLayout& layout = node->getLayout();
+  const bool needToVisitNode =
+      (node->isDirty() &&
+       layout.generationCount != layoutPass.generationCount) ||
+      layout.lastOwnerDirection != ownerDirection;
+  if (!needToVisitNode &&
+      YGNodeFindCachedMeasurement(
+          node,
+          availableWidth,
+          availableHeight,
+          widthMeasureMode,
+          heightMeasureMode,
+          ownerWidth,
+          config) != nullptr) {
+    return;
+  }
+
+  YGMeasureRequest request;
+  request.node = node;
+  request.width = YGNodeMeasureInnerSize(
+      node, YGFlexDirectionRow, availableWidth, availableWidth);
+  request.widthMode = widthMeasureMode;
+  request.height = YGNodeMeasureInnerSize(
+      node, YGFlexDirectionColumn, availableHeight, availableWidth);
+  request.heightMode = heightMeasureMode;
+  request.size = {YGUndefined, YGUndefined};
+
+  YGMeasureMemo* const memo = node->getConfig()->measureMemo.get();
+  const uint64_t contentKey = node->getMeasureContentKey();
+  if (memo != nullptr && contentKey != 0 &&
+      memo->get(
+          {contentKey,
+           request.width,
+           request.widthMode,
+           request.height,
+           request.heightMode},
+          &request.size)) {
+    return;
+  }
+  requests.push_back(request);
+}
+
+// Measures all requests with a single call of the batch measure function. The
+// results are used by the layouts that follow, until the caller restores the
+// previous value of `layoutPass.batchedMeasures`.
+static void YGBatchMeasure(
+    std::vector<YGMeasureRequest>& requests,
+    const YGConfigRef config,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  if (requests.empty()) {
+    return;
+  }
+  std::sort(
+      requests.begin(),
+      requests.end(),
+      [](const YGMeasureRequest& a, const YGMeasureRequest& b) {
+        return std::less<YGNodeRef>{}(a.node, b.node);
+      });
+  config->batchMeasure(
+      requests.data(), static_cast<uint32_t>(requests.size()), layoutContext);
+  layoutPass.batchedMeasures = &requests;
+
+  for (const YGMeasureRequest& request : requests) {
+    YGMeasureMemo* const memo = request.node->getConfig()->measureMemo.get();
+    const uint64_t contentKey = request.node->getMeasureContentKey();
+    if (memo != nullptr && contentKey != 0) {
+      memo->put(
+          {contentKey,
+           request.width,
+           request.widthMode,
+           request.height,
+           request.heightMode},
+          request.size);
+    }
+  }
+}
+
+static const YGMeasureRequest* YGFindBatchedMeasurement(
+    const YGLayoutPass& layoutPass,
+    const YGNodeRef node,
+    const float width,
+    const YGMeasureMode widthMode,
+    const float height,
+    const YGMeasureMode heightMode) {
+  if (layoutPass.batchedMeasures == nullptr) {
+    return nullptr;
+  }
+  const auto& requests = *layoutPass.batchedMeasures;
+  const auto request = std::lower_bound(
+      requests.begin(),
+      requests.end(),
+      node,
+      [](const YGMeasureRequest& r, const YGNodeRef n) {
+        return std::less<YGNodeRef>{}(r.node, n);
+      });
+  if (request != requests.end() && request->node == node &&
+      request->widthMode == widthMode && request->heightMode == heightMode &&
+      YGFloatsEqual(request->width, width) &&
+      YGFloatsEqual(request->height, height)) {
+    return &*request;
+  }
+  return nullptr;
+}
+
+// Measures the content of a node, unless it was already measured together
+// with its siblings, or a node with the same content key was measured under
+// the same constraints.
+static YGSize YGNodeMeasureContent(
+    const YGNodeRef node,
+    const float width,
+    const YGMeasureMode widthMode,
+    const float height,
+    const YGMeasureMode heightMode,
+    void* const layoutContext,
+    const YGLayoutPass& layoutPass) {
+  const YGMeasureRequest* batchedMeasurement = YGFindBatchedMeasurement(
+      layoutPass, node, width, widthMode, height, heightMode);
+  if (batchedMeasurement != nullptr) {
+    return batchedMeasurement->size;
+  }
+
+  YGMeasureMemo* const memo = node->getConfig()->measureMemo.get();
+  const uint64_t contentKey = node->getMeasureContentKey();
+  if (memo == nullptr || contentKey == 0) {
+    return marker::MarkerSection<YGMarkerMeasure>::wrap(
+        node,
+        &YGNode::measure,
+        width,
+        widthMode,
+        height,
+        heightMode,
+        layoutContext);
+  }
+
+  const YGMeasureMemo::Key key{
+      contentKey, width, widthMode, height, heightMode};
+  YGSize size;
+  if (!memo->get(key, &size)) {
+    size = marker::MarkerSection<YGMarkerMeasure>::wrap(
+        node,
+        &YGNode::measure,
+        width,
+        widthMode,
+        height,
+        heightMode,
+        layoutContext);
+    memo->put(key, size);
+  }
+  return size;
+}
+
 static void YGNodeWithMeasureFuncSetMeasuredDimensions(
     const YGNodeRef node,
     const float availableWidth,
@@ -1609,7 +1968,8 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
     const YGMeasureMode heightMeasureMode,
     const float ownerWidth,
     const float ownerHeight,
-    void* const layoutContext) {
+    void* const layoutContext,
+    const YGLayoutPass& layoutPass) {
   YGAssertWithNode(
       node,
       node->hasMeasureFunc(),
@@ -1624,14 +1984,10 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
   const float marginAxisColumn =
       node->getMarginForAxis(YGFlexDirectionColumn, availableWidth).unwrap();
 
-  // We want to make sure we don't call measure with negative size
-  const float innerWidth = YGFloatIsUndefined(availableWidth)
-      ? availableWidth
-      : YGFloatMax(0, availableWidth - marginAxisRow - paddingAndBorderAxisRow);
-  const float innerHeight = YGFloatIsUndefined(availableHeight)
-      ? availableHeight
-      : YGFloatMax(
-            0, availableHeight - marginAxisColumn - paddingAndBorderAxisColumn);
+  const float innerWidth = YGNodeMeasureInnerSize(
+      node, YGFlexDirectionRow, availableWidth, availableWidth);
+  const float innerHeight = YGNodeMeasureInnerSize(
+      node, YGFlexDirectionColumn, availableHeight, availableWidth);
 
   if (widthMeasureMode == YGMeasureModeExactly &&
       heightMeasureMode == YGMeasureModeExactly) {
@@ -1654,14 +2010,14 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
         YGDimensionHeight);
   } else {
     // Measure the text under the current constraints.
-    const YGSize measuredSize = marker::MarkerSection<YGMarkerMeasure>::wrap(
+    const YGSize measuredSize = YGNodeMeasureContent(
         node,
-        &YGNode::measure,
         innerWidth,
         widthMeasureMode,
         innerHeight,
         heightMeasureMode,
-        layoutContext);
+        layoutContext,
+        layoutPass);
 
     node->setLayoutMeasuredDimension(
         YGNodeBoundAxis(
@@ -1785,19 +2141,34 @@ static bool YGNodeFixedSizeSetMeasuredDimensions(
 
 static void YGZeroOutLayoutRecursivly(
     const YGNodeRef node,
-    void* layoutContext) {
+    void* layoutContext,
+    const YGLayoutPass& layoutPass) {
   node->getLayout() = {};
   node->setLayoutDimension(0, 0);
   node->setLayoutDimension(0, 1);
   node->setHasNewLayout(true);
+  node->clearStackLayoutState();
 
   node->iterChildrenAfterCloningIfNeeded(
-      YGZeroOutLayoutRecursivly, layoutContext);
+      [&layoutPass](YGNodeRef child, void* layoutContext) {
+        YGZeroOutLayoutRecursivly(child, layoutContext, layoutPass);
+      },
+      layoutContext,
+      layoutPass.cloneNode);
 }
 
-static float YGNodeCalculateAvailableInnerDim(
+static void YGAppendSubtree(
     const YGNodeRef node,
-    YGFlexDirection axis,
+    std::vector<YGNodeRef>& nodes) {
+  nodes.push_back(node);
+  for (const YGNodeRef child : node->getChildren()) {
+    YGAppendSubtree(child, nodes);
+  }
+}
+
+static float YGNodeCalculateAvailableInnerDim(
+    const YGNodeRef node,
+    YGFlexDirection axis,
     float availableDim,
     float ownerDim) {
   YGFlexDirection direction =
@@ -1845,10 +2216,11 @@ static float YGNodeComputeFlexBasisForChildren(
     const YGConfigRef config,
     bool performLayout,
     YGMarkerLayoutData& layoutMarkerData,
-    void* const layoutContext) {
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
   float totalOuterFlexBasis = 0.0f;
   YGNodeRef singleFlexChild = nullptr;
-  YGVector children = node->getChildren();
+  const YGVector& children = node->getChildren();
   YGMeasureMode measureModeMainDim =
       YGFlexDirectionIsRow(mainAxis) ? widthMeasureMode : heightMeasureMode;
   // If there is only one child with flexGrow + flexShrink it means we can set
@@ -1871,12 +2243,68 @@ static float YGNodeComputeFlexBasisForChildren(
     }
   }
 
+  // Children with measure functions whose flex basis is found by measuring can
+  // all be measured at once.
+  std::vector<YGMeasureRequest> measureRequests;
+  const auto previousBatchedMeasures = layoutPass.batchedMeasures;
+  if (config->batchMeasure != nullptr) {
+    for (auto child : children) {
+      child->resolveDimension();
+      if (child->getStyle().display == YGDisplayNone ||
+          child->getStyle().positionType == YGPositionTypeAbsolute ||
+          child == singleFlexChild || !child->hasMeasureFunc() ||
+          !YGNodeFlexBasisNeedsMeasure(
+              node,
+              child,
+              availableInnerWidth,
+              availableInnerHeight,
+              availableInnerWidth,
+              availableInnerHeight,
+              direction)) {
+        continue;
+      }
+      float childWidth;
+      float childHeight;
+      YGMeasureMode childWidthMeasureMode;
+      YGMeasureMode childHeightMeasureMode;
+      YGNodeFlexBasisMeasureConstraints(
+          node,
+          child,
+          availableInnerWidth,
+          widthMeasureMode,
+          availableInnerHeight,
+          availableInnerWidth,
+          availableInnerHeight,
+          heightMeasureMode,
+          direction,
+          &childWidth,
+          &childHeight,
+          &childWidthMeasureMode,
+          &childHeightMeasureMode);
+      YGAddMeasureRequest(
+          measureRequests,
+          child,
+          childWidth,
+          childHeight,
+          direction,
+          childWidthMeasureMode,
+          childHeightMeasureMode,
+          availableInnerWidth,
+          config,
+          layoutPass);
+    }
+    YGBatchMeasure(measureRequests, config, layoutContext, layoutPass);
+  }
+
   for (auto child : children) {
     child->resolveDimension();
     if (child->getStyle().display == YGDisplayNone) {
-      YGZeroOutLayoutRecursivly(child, layoutContext);
+      YGZeroOutLayoutRecursivly(child, layoutContext, layoutPass);
       child->setHasNewLayout(true);
       child->setDirty(false);
+      if (layoutPass.laidOutNodes != nullptr) {
+        YGAppendSubtree(child, *layoutPass.laidOutNodes);
+      }
       continue;
     }
     if (performLayout) {
@@ -1896,7 +2324,7 @@ static float YGNodeComputeFlexBasisForChildren(
       continue;
     }
     if (child == singleFlexChild) {
-      child->setLayoutComputedFlexBasisGeneration(gCurrentGenerationCount);
+      child->setLayoutComputedFlexBasisGeneration(layoutPass.generationCount);
       child->setLayoutComputedFlexBasis(YGFloatOptional(0));
     } else {
       YGNodeComputeFlexBasisForChild(
@@ -1911,7 +2339,8 @@ static float YGNodeComputeFlexBasisForChildren(
           direction,
           config,
           layoutMarkerData,
-          layoutContext);
+          layoutContext,
+          layoutPass);
     }
 
     totalOuterFlexBasis +=
@@ -1919,6 +2348,7 @@ static float YGNodeComputeFlexBasisForChildren(
          child->getMarginForAxis(mainAxis, availableInnerWidth))
             .unwrap();
   }
+  layoutPass.batchedMeasures = previousBatchedMeasures;
 
   return totalOuterFlexBasis;
 }
@@ -1929,7 +2359,7 @@ static float YGNodeComputeFlexBasisForChildren(
 // YGCollectFlexItemsRowMeasurement
 static YGCollectFlexItemsRowValues YGCalculateCollectFlexItemsRowValues(
     const YGNodeRef& node,
-    const YGDirection ownerDirection,
+    const YGFlexDirection mainAxis,
     const float mainAxisownerSize,
     const float availableInnerWidth,
     const float availableInnerMainDim,
@@ -1939,8 +2369,6 @@ static YGCollectFlexItemsRowValues YGCalculateCollectFlexItemsRowValues(
   flexAlgoRowMeasurement.relativeChildren.reserve(node->getChildren().size());
 
   float sizeConsumedOnCurrentLineIncludingMinConstraint = 0;
-  const YGFlexDirection mainAxis = YGResolveFlexDirection(
-      node->getStyle().flexDirection, node->resolveDirection(ownerDirection));
   const bool isNodeFlexWrap = node->getStyle().flexWrap != YGWrapNoWrap;
 
   // Add items to the current line until it's full or we run out of items.
@@ -2006,6 +2434,216 @@ static YGCollectFlexItemsRowValues YGCalculateCollectFlexItemsRowValues(
   return flexAlgoRowMeasurement;
 }
 
+// Adds the counts of a layout that was run separately to `total`.
+static void YGAccumulateMarkerLayoutData(
+    YGMarkerLayoutData& total,
+    const YGMarkerLayoutData& data) {
+  total.layouts += data.layouts;
+  total.measures += data.measures;
+  total.maxMeasureCache = std::max(total.maxMeasureCache, data.maxMeasureCache);
+  total.cachedLayouts += data.cachedLayouts;
+  total.cachedMeasures += data.cachedMeasures;
+  total.measureCacheMisses += data.measureCacheMisses;
+  total.measureCacheEvictions += data.measureCacheEvictions;
+  total.memoizedLayouts += data.memoizedLayouts;
+}
+
+// A child layout whose result is only read once all of its siblings have been
+// laid out as well. These are collected so that they can be fanned out to the
+// config's layout executor.
+struct YGDeferredChildLayout {
+  YGNodeRef child;
+  float availableWidth;
+  float availableHeight;
+  YGDirection ownerDirection;
+  YGMeasureMode widthMeasureMode;
+  YGMeasureMode heightMeasureMode;
+  float ownerWidth;
+  float ownerHeight;
+  bool performLayout;
+  const char* reason;
+};
+
+struct YGExecutorTasks {
+  std::vector<const YGDeferredChildLayout*> layouts;
+  std::vector<YGLayoutPass> layoutPasses;
+  std::vector<YGMarkerLayoutData> layoutMarkerData;
+  std::vector<std::vector<YGNodeRef>> laidOutNodes;
+  YGConfigRef config;
+  void* layoutContext;
+};
+
+static bool YGCanUseLayoutExecutor(
+    const YGConfigRef config,
+    const YGLayoutPass& layoutPass) {
+  return config->layoutExecutor != nullptr && !layoutPass.isExecutorTask;
+}
+
+static bool YGShouldDeferChildLayouts(
+    const YGConfigRef config,
+    const YGLayoutPass& layoutPass) {
+  return YGCanUseLayoutExecutor(config, layoutPass) ||
+      config->batchMeasure != nullptr;
+}
+
+static void YGLayoutDeferredChild(
+    const YGDeferredChildLayout& deferred,
+    const YGConfigRef config,
+    YGMarkerLayoutData& layoutMarkerData,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  YGLayoutNodeInternal(
+      deferred.child,
+      deferred.availableWidth,
+      deferred.availableHeight,
+      deferred.ownerDirection,
+      deferred.widthMeasureMode,
+      deferred.heightMeasureMode,
+      deferred.ownerWidth,
+      deferred.ownerHeight,
+      deferred.performLayout,
+      deferred.reason,
+      config,
+      layoutMarkerData,
+      layoutContext,
+      layoutPass);
+}
+
+static void YGRunExecutorTask(void* tasks, uint32_t taskIndex) {
+  auto executorTasks = static_cast<YGExecutorTasks*>(tasks);
+  YGLayoutDeferredChild(
+      *executorTasks->layouts[taskIndex],
+      executorTasks->config,
+      executorTasks->layoutMarkerData[taskIndex],
+      executorTasks->layoutContext,
+      executorTasks->layoutPasses[taskIndex]);
+}
+
+// Counts the nodes of the subtree rooted at `node`, stopping at `limit`.
+static uint32_t YGNodeSubtreeSize(const YGNodeRef node, const uint32_t limit) {
+  uint32_t size = 1;
+  for (const YGNodeRef child : node->getChildren()) {
+    if (size >= limit) {
+      break;
+    }
+    size += YGNodeSubtreeSize(child, limit - size);
+  }
+  return size;
+}
+
+// Whether a deferred layout is expensive enough to be worth running on the
+// executor. Layouts which will most likely be served from the layout cache
+// are cheap regardless of the size of the subtree.
+static bool YGIsWorthExecuting(
+    const YGDeferredChildLayout& deferred,
+    const uint32_t minSubtreeSize) {
+  const YGNodeRef child = deferred.child;
+  const YGCachedMeasurement& cachedLayout = child->getLayout().cachedLayout;
+  const bool isLikelyCached = !child->isDirty() && deferred.performLayout &&
+      YGFloatsEqual(cachedLayout.availableWidth, deferred.availableWidth) &&
+      YGFloatsEqual(cachedLayout.availableHeight, deferred.availableHeight) &&
+      cachedLayout.widthMeasureMode == deferred.widthMeasureMode &&
+      cachedLayout.heightMeasureMode == deferred.heightMeasureMode;
+  return !isLikelyCached &&
+      YGNodeSubtreeSize(child, minSubtreeSize) >= minSubtreeSize;
+}
+
+// Large subtrees are handed to the layout executor, each with its own copy of
+// the pass state and marker data, which are merged back once the executor
+// returns.
+static void YGExecuteDeferredChildren(
+    const std::vector<YGDeferredChildLayout>& deferredLayouts,
+    const YGConfigRef config,
+    YGMarkerLayoutData& layoutMarkerData,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  YGExecutorTasks tasks;
+  for (const auto& deferred : deferredLayouts) {
+    if (YGIsWorthExecuting(deferred, config->layoutExecutorMinSubtreeSize)) {
+      tasks.layouts.push_back(&deferred);
+    } else {
+      YGLayoutDeferredChild(
+          deferred, config, layoutMarkerData, layoutContext, layoutPass);
+    }
+  }
+
+  if (tasks.layouts.size() < 2) {
+    for (const auto deferred : tasks.layouts) {
+      YGLayoutDeferredChild(
+          *deferred, config, layoutMarkerData, layoutContext, layoutPass);
+    }
+    return;
+  }
+
+  YGLayoutPass taskLayoutPass = layoutPass;
+  taskLayoutPass.isExecutorTask = true;
+  tasks.layoutPasses.assign(tasks.layouts.size(), taskLayoutPass);
+  tasks.layoutMarkerData.assign(tasks.layouts.size(), YGMarkerLayoutData{});
+  if (layoutPass.laidOutNodes != nullptr) {
+    tasks.laidOutNodes.resize(tasks.layouts.size());
+    for (size_t i = 0; i < tasks.layouts.size(); i++) {
+      tasks.layoutPasses[i].laidOutNodes = &tasks.laidOutNodes[i];
+    }
+  }
+  tasks.config = config;
+  tasks.layoutContext = layoutContext;
+
+  config->layoutExecutor(
+      config,
+      &YGRunExecutorTask,
+      &tasks,
+      static_cast<uint32_t>(tasks.layouts.size()));
+
+  for (const auto& taskMarkerData : tasks.layoutMarkerData) {
+    YGAccumulateMarkerLayoutData(layoutMarkerData, taskMarkerData);
+  }
+  for (const auto& taskLaidOutNodes : tasks.laidOutNodes) {
+    layoutPass.laidOutNodes->insert(
+        layoutPass.laidOutNodes->end(),
+        taskLaidOutNodes.begin(),
+        taskLaidOutNodes.end());
+  }
+}
+
+// Lays out all deferred children, after measuring all children with measure
+// functions at once if the config has a batch measure function.
+static void YGLayoutDeferredChildren(
+    const std::vector<YGDeferredChildLayout>& deferredLayouts,
+    const YGConfigRef config,
+    YGMarkerLayoutData& layoutMarkerData,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  std::vector<YGMeasureRequest> measureRequests;
+  const auto previousBatchedMeasures = layoutPass.batchedMeasures;
+  if (config->batchMeasure != nullptr) {
+    for (const auto& deferred : deferredLayouts) {
+      YGAddMeasureRequest(
+          measureRequests,
+          deferred.child,
+          deferred.availableWidth,
+          deferred.availableHeight,
+          deferred.ownerDirection,
+          deferred.widthMeasureMode,
+          deferred.heightMeasureMode,
+          deferred.ownerWidth,
+          config,
+          layoutPass);
+    }
+    YGBatchMeasure(measureRequests, config, layoutContext, layoutPass);
+  }
+
+  if (YGCanUseLayoutExecutor(config, layoutPass)) {
+    YGExecuteDeferredChildren(
+        deferredLayouts, config, layoutMarkerData, layoutContext, layoutPass);
+  } else {
+    for (const auto& deferred : deferredLayouts) {
+      YGLayoutDeferredChild(
+          deferred, config, layoutMarkerData, layoutContext, layoutPass);
+    }
+  }
+  layoutPass.batchedMeasures = previousBatchedMeasures;
+}
+
 // It distributes the free space to the flexible items and ensures that the size
 // of the flex items abide the min and max constraints. At the end of this
 // function the child nodes would have proper size. Prior using this function
@@ -2025,13 +2663,18 @@ static float YGDistributeFreeSpaceSecondPass(
     const bool performLayout,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
-    void* const layoutContext) {
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
   float childFlexBasis = 0;
   float flexShrinkScaledFactor = 0;
   float flexGrowFactor = 0;
   float deltaFreeSpace = 0;
   const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
   const bool isNodeFlexWrap = node->getStyle().flexWrap != YGWrapNoWrap;
+  const YGDimension crossAxisDim =
+      isMainAxisRow ? YGDimensionHeight : YGDimensionWidth;
+  const bool deferChildLayouts = YGShouldDeferChildLayouts(config, layoutPass);
+  std::vector<YGDeferredChildLayout> deferredLayouts;
 
   for (auto currentRelativeChild : collectedFlexItemsValues.relativeChildren) {
     childFlexBasis = YGNodeBoundAxisWithinMinAndMax(
@@ -2131,12 +2774,12 @@ static float YGDistributeFreeSpaceSecondPass(
     } else {
       childCrossSize =
           YGResolveValue(
-              currentRelativeChild->getResolvedDimension(dim[crossAxis]),
+              currentRelativeChild->getResolvedDimension(crossAxisDim),
               availableInnerCrossDim)
               .unwrap() +
           marginCross;
       const bool isLoosePercentageMeasurement =
-          currentRelativeChild->getResolvedDimension(dim[crossAxis]).unit ==
+          currentRelativeChild->getResolvedDimension(crossAxisDim).unit ==
               YGUnitPercent &&
           measureModeCrossDim != YGMeasureModeExactly;
       childCrossMeasureMode =
@@ -2178,7 +2821,7 @@ static float YGDistributeFreeSpaceSecondPass(
 
     // Recursively call the layout algorithm for this child with the updated
     // main size.
-    YGLayoutNodeInternal(
+    const YGDeferredChildLayout childLayout = {
         currentRelativeChild,
         childWidth,
         childHeight,
@@ -2188,14 +2831,27 @@ static float YGDistributeFreeSpaceSecondPass(
         availableInnerWidth,
         availableInnerHeight,
         performLayout && !requiresStretchLayout,
-        "flex",
-        config,
-        layoutMarkerData,
-        layoutContext);
+        "flex"};
+    if (deferChildLayouts) {
+      deferredLayouts.push_back(childLayout);
+      continue;
+    }
+    YGLayoutDeferredChild(
+        childLayout, config, layoutMarkerData, layoutContext, layoutPass);
     node->setLayoutHadOverflow(
         node->getLayout().hadOverflow |
         currentRelativeChild->getLayout().hadOverflow);
   }
+
+  if (deferChildLayouts) {
+    YGLayoutDeferredChildren(
+        deferredLayouts, config, layoutMarkerData, layoutContext, layoutPass);
+    for (const auto& childLayout : deferredLayouts) {
+      node->setLayoutHadOverflow(
+          node->getLayout().hadOverflow |
+          childLayout.child->getLayout().hadOverflow);
+    }
+  }
   return deltaFreeSpace;
 }
 
@@ -2322,7 +2978,8 @@ static void YGResolveFlexibleLength(
     const bool performLayout,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
-    void* const layoutContext) {
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
   const float originalFreeSpace = collectedFlexItemsValues.remainingFreeSpace;
   // First pass: detect the flex items whose min/max constraints trigger
   YGDistributeFreeSpaceFirstPass(
@@ -2348,7 +3005,8 @@ static void YGResolveFlexibleLength(
       performLayout,
       config,
       layoutMarkerData,
-      layoutContext);
+      layoutContext,
+      layoutPass);
 
   collectedFlexItemsValues.remainingFreeSpace =
       originalFreeSpace - distributedFreeSpace;
@@ -2370,6 +3028,8 @@ static void YGJustifyMainAxis(
     const bool performLayout,
     void* const layoutContext) {
   const YGStyle& style = node->getStyle();
+  const YGDimension mainAxisDim =
+      YGFlexDirectionIsRow(mainAxis) ? YGDimensionWidth : YGDimensionHeight;
   const float leadingPaddingAndBorderMain =
       node->getLeadingPaddingAndBorder(mainAxis, ownerWidth).unwrap();
   const float trailingPaddingAndBorderMain =
@@ -2378,8 +3038,8 @@ static void YGJustifyMainAxis(
   // remainingFreeSpace is 0 when min main dimension is not given
   if (measureModeMainDim == YGMeasureModeAtMost &&
       collectedFlexItemsValues.remainingFreeSpace > 0) {
-    if (!style.minDimensions[dim[mainAxis]].isUndefined() &&
-        !YGResolveValue(style.minDimensions[dim[mainAxis]], mainAxisownerSize)
+    if (!style.minDimensions[mainAxisDim].isUndefined() &&
+        !YGResolveValue(style.minDimensions[mainAxisDim], mainAxisownerSize)
              .isUndefined()) {
       // This condition makes sure that if the size of main dimension(after
       // considering child nodes main dim, leading and trailing padding etc)
@@ -2389,7 +3049,7 @@ static void YGJustifyMainAxis(
       // `minAvailableMainDim` denotes minimum available space in which child
       // can be laid out, it will exclude space consumed by padding and border.
       const float minAvailableMainDim =
-          YGResolveValue(style.minDimensions[dim[mainAxis]], mainAxisownerSize)
+          YGResolveValue(style.minDimensions[mainAxisDim], mainAxisownerSize)
               .unwrap() -
           leadingPaddingAndBorderMain - trailingPaddingAndBorderMain;
       const float occupiedSpaceByChildNodes =
@@ -2570,187 +3230,600 @@ static void YGJustifyMainAxis(
   }
 }
 
+// Calculates the remaining available space that needs to be allocated. If the
+// main dimension size isn't known, it is computed based on the line length, so
+// there's no more space left to distribute.
+static void YGCalculateRemainingFreeSpace(
+    const YGNodeRef node,
+    YGCollectFlexItemsRowValues& collectedFlexItemsValues,
+    const YGMeasureMode measureModeMainDim,
+    const float minInnerMainDim,
+    const float maxInnerMainDim,
+    float* availableInnerMainDim) {
+  bool sizeBasedOnContent = false;
+  // If we don't measure with exact main dimension we want to ensure we don't
+  // violate min and max
+  if (measureModeMainDim != YGMeasureModeExactly) {
+    if (!YGFloatIsUndefined(minInnerMainDim) &&
+        collectedFlexItemsValues.sizeConsumedOnCurrentLine < minInnerMainDim) {
+      *availableInnerMainDim = minInnerMainDim;
+    } else if (
+        !YGFloatIsUndefined(maxInnerMainDim) &&
+        collectedFlexItemsValues.sizeConsumedOnCurrentLine > maxInnerMainDim) {
+      *availableInnerMainDim = maxInnerMainDim;
+    } else {
+      if (!node->getConfig()->useLegacyStretchBehaviour &&
+          ((YGFloatIsUndefined(collectedFlexItemsValues.totalFlexGrowFactors) &&
+            collectedFlexItemsValues.totalFlexGrowFactors == 0) ||
+           (YGFloatIsUndefined(node->resolveFlexGrow()) &&
+            node->resolveFlexGrow() == 0))) {
+        // If we don't have any children to flex or we can't flex the node
+        // itself, space we've used is all space we need. Root node also
+        // should be shrunk to minimum
+        *availableInnerMainDim =
+            collectedFlexItemsValues.sizeConsumedOnCurrentLine;
+      }
+
+      if (node->getConfig()->useLegacyStretchBehaviour) {
+        node->setLayoutDidUseLegacyFlag(true);
+      }
+      sizeBasedOnContent = !node->getConfig()->useLegacyStretchBehaviour;
+    }
+  }
+
+  if (!sizeBasedOnContent && !YGFloatIsUndefined(*availableInnerMainDim)) {
+    collectedFlexItemsValues.remainingFreeSpace = *availableInnerMainDim -
+        collectedFlexItemsValues.sizeConsumedOnCurrentLine;
+  } else if (collectedFlexItemsValues.sizeConsumedOnCurrentLine < 0) {
+    // availableInnerMainDim is indefinite which means the node is being sized
+    // based on its content. sizeConsumedOnCurrentLine is negative which means
+    // the node will allocate 0 points for its content. Consequently,
+    // remainingFreeSpace is 0 - sizeConsumedOnCurrentLine.
+    collectedFlexItemsValues.remainingFreeSpace =
+        -collectedFlexItemsValues.sizeConsumedOnCurrentLine;
+  }
+}
+
+static bool YGNodeComputeIsPlainStack(const YGNodeRef node) {
+  const YGStyle& style = node->getStyle();
+  if (!YGFlexDirectionIsColumn(style.flexDirection) ||
+      style.flexWrap != YGWrapNoWrap ||
+      style.justifyContent != YGJustifyFlexStart) {
+    return false;
+  }
+  for (const YGNodeRef child : node->getChildren()) {
+    const YGStyle& childStyle = child->getStyle();
+    if (childStyle.display == YGDisplayNone ||
+        childStyle.positionType != YGPositionTypeRelative ||
+        !childStyle.aspectRatio.isUndefined() || child->isNodeFlexible()) {
+      return false;
+    }
+    for (size_t edge = YGEdgeLeft; edge <= YGEdgeAll; edge++) {
+      if (childStyle.margin[edge].isAuto()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Whether the children of node are stacked in a single column without being
+// flexed, justified or positioned absolutely. Such containers are laid out by
+// YGLayoutPlainStackChildren. The result is kept on the node until it is
+// marked dirty, which happens whenever its style or one of its children
+// changes.
+static bool YGNodeIsPlainStack(const YGNodeRef node) {
+  if (!node->hasPlainStackSummary()) {
+    node->setIsPlainStack(YGNodeComputeIsPlainStack(node));
+  }
+  return node->isPlainStack();
+}
+
+// Main size a child of a virtualized container is stacked with while it is
+// outside the window: the size it was last laid out with, if any.
+static float YGNodeVirtualizedItemSize(
+    const YGNodeRef child,
+    const YGFlexDirection mainAxis,
+    const YGVirtualizedWindow& window) {
+  const float measuredSize =
+      child->getLayout().measuredDimensions[dim[mainAxis]];
+  return YGFloatIsUndefined(measuredSize) ? window.estimatedItemSize
+                                          : measuredSize;
+}
+
+// Positions a child of a virtualized container, which is outside the window,
+// at mainPosition without laying it out. Children that were laid out before
+// keep the rest of their layout, the others get their estimated size.
+static void YGNodePlaceVirtualizedChild(
+    const YGNodeRef child,
+    const YGFlexDirection mainAxis,
+    const YGFlexDirection crossAxis,
+    const YGDirection direction,
+    const YGVirtualizedWindow& window,
+    const float mainPosition,
+    const float leadingPaddingAndBorderCross,
+    const float availableInnerCrossDim,
+    const float availableInnerWidth,
+    const float availableInnerHeight,
+    YGLayoutPass& layoutPass) {
+  const YGLayout& layout = child->getLayout();
+  const bool wasLaidOut =
+      !YGFloatIsUndefined(layout.measuredDimensions[dim[mainAxis]]);
+  const float previousMainPosition = layout.position[pos[mainAxis]];
+  const float previousCrossPosition = layout.position[pos[crossAxis]];
+
+  child->setPosition(
+      child->resolveDirection(direction),
+      availableInnerHeight,
+      availableInnerWidth,
+      availableInnerWidth);
+  child->setLayoutPosition(
+      layout.position[pos[mainAxis]] + mainPosition, pos[mainAxis]);
+  if (wasLaidOut) {
+    child->setLayoutPosition(previousCrossPosition, pos[crossAxis]);
+  } else {
+    child->setLayoutPosition(
+        layout.position[pos[crossAxis]] + leadingPaddingAndBorderCross,
+        pos[crossAxis]);
+    child->setLayoutDimension(window.estimatedItemSize, dim[mainAxis]);
+    child->setLayoutDimension(
+        YGFloatIsUndefined(availableInnerCrossDim) ? 0
+                                                   : availableInnerCrossDim,
+        dim[crossAxis]);
+  }
+
+  if (!wasLaidOut || layout.position[pos[mainAxis]] != previousMainPosition) {
+    child->setHasNewLayout(true);
+    if (layoutPass.laidOutNodes != nullptr) {
+      layoutPass.laidOutNodes->push_back(child);
+    }
+  }
+}
+
+// Whether the layout of a child of a plain stack depends on the main size of
+// the stack, other than by being limited by it.
+static bool YGNodeUsesOwnerMainSize(const YGNodeRef child) {
+  const YGStyle& style = child->getStyle();
+  const auto isPercent = [](const YGValue value) {
+    return value.unit == YGUnitPercent;
+  };
+  return !style.flexBasis.isAuto() ||
+      isPercent(style.dimensions[YGDimensionHeight]) ||
+      isPercent(style.minDimensions[YGDimensionHeight]) ||
+      isPercent(style.maxDimensions[YGDimensionHeight]) ||
+      isPercent(style.position[YGEdgeTop]) ||
+      isPercent(style.position[YGEdgeBottom]) ||
+      isPercent(style.position[YGEdgeVertical]) ||
+      isPercent(style.position[YGEdgeAll]);
+}
+
+// Whether the children of a stack that were laid out with the constraints in
+// previous are laid out the same with those in current. The main size of the
+// stack may differ if it neither limits the children nor is used by them.
+static bool YGStackLayoutIsReusable(
+    const YGNodeRef node,
+    const YGStackLayoutState& previous,
+    const YGStackLayoutState& current,
+    const float availableInnerMainDim) {
+  if (!YGFloatsEqual(previous.availableWidth, current.availableWidth) ||
+      !YGFloatsEqual(previous.ownerWidth, current.ownerWidth) ||
+      previous.widthMeasureMode != current.widthMeasureMode ||
+      previous.direction != current.direction) {
+    return false;
+  }
+  if (YGFloatsEqual(previous.availableHeight, current.availableHeight) &&
+      YGFloatsEqual(previous.ownerHeight, current.ownerHeight) &&
+      previous.heightMeasureMode == current.heightMeasureMode) {
+    return true;
+  }
+  return !previous.childrenUseMainSize && previous.childrenFitMainSize &&
+      (node->getStyle().overflow == YGOverflowScroll ||
+       YGFloatIsUndefined(availableInnerMainDim) ||
+       availableInnerMainDim >= previous.sizeConsumed);
+}
+
+// Steps 4 to 7 for a container for which YGNodeIsPlainStack holds. All of its
+// children are on one line and none of them flex, so this only stacks them,
+// without collecting lines or distributing free space. The results are the
+// same as those of the general algorithm. Returns false, without laying out
+// any child, if the children cannot be stacked this way.
 //
-// This is the main routine that implements a subset of the flexbox layout
-// algorithm described in the W3C CSS documentation:
-// https://www.w3.org/TR/CSS3-flexbox/.
-//
-// Limitations of this algorithm, compared to the full standard:
-//  * Display property is always assumed to be 'flex' except for Text nodes,
-//    which are assumed to be 'inline-flex'.
-//  * The 'zIndex' property (or any form of z ordering) is not supported. Nodes
-//    are stacked in document order.
-//  * The 'order' property is not supported. The order of flex items is always
-//    defined by document order.
-//  * The 'visibility' property is always assumed to be 'visible'. Values of
-//    'collapse' and 'hidden' are not supported.
-//  * There is no support for forced breaks.
-//  * It does not support vertical inline directions (top-to-bottom or
-//    bottom-to-top text).
-//
-// Deviations from standard:
-//  * Section 4.5 of the spec indicates that all flex items have a default
-//    minimum main size. For text blocks, for example, this is the width of the
-//    widest word. Calculating the minimum width is expensive, so we forego it
-//    and assume a default minimum main size of 0.
-//  * Min/Max sizes in the main axis are not honored when resolving flexible
-//    lengths.
-//  * The spec indicates that the default value for 'flexDirection' is 'row',
-//    but the algorithm below assumes a default of 'column'.
-//
-// Input parameters:
-//    - node: current node to be sized and layed out
-//    - availableWidth & availableHeight: available size to be used for sizing
-//      the node or YGUndefined if the size is not available; interpretation
-//      depends on layout flags
-//    - ownerDirection: the inline (text) direction within the owner
-//      (left-to-right or right-to-left)
-//    - widthMeasureMode: indicates the sizing rules for the width (see below
-//      for explanation)
-//    - heightMeasureMode: indicates the sizing rules for the height (see below
-//      for explanation)
-//    - performLayout: specifies whether the caller is interested in just the
-//      dimensions of the node or it requires the entire node and its subtree to
-//      be layed out (with final positions)
-//
-// Details:
-//    This routine is called recursively to lay out subtrees of flexbox
-//    elements. It uses the information in node.style, which is treated as a
-//    read-only input. It is responsible for setting the layout.direction and
-//    layout.measuredDimensions fields for the input node as well as the
-//    layout.position and layout.lineIndex fields for its child nodes. The
-//    layout.measuredDimensions field includes any border or padding for the
-//    node but does not include margins.
-//
-//    The spec describes four different layout modes: "fill available", "max
-//    content", "min content", and "fit content". Of these, we don't use "min
-//    content" because we don't support default minimum main sizes (see above
-//    for details). Each of our measure modes maps to a layout mode from the
-//    spec (https://www.w3.org/TR/CSS3-sizing/#terms):
-//      - YGMeasureModeUndefined: max content
-//      - YGMeasureModeExactly: fill available
-//      - YGMeasureModeAtMost: fit content
+// With a virtualized window, the flex bases of the children have not been
+// computed in step 3. They are only computed for the children intersecting the
+// window, and only those are laid out; the others are stacked with the size
+// returned by YGNodeVirtualizedItemSize.
 //
-//    When calling YGNodelayoutImpl and YGLayoutNodeInternal, if the caller
-//    passes an available size of undefined then it must also pass a measure
-//    mode of YGMeasureModeUndefined in that dimension.
+// With a non-zero firstChild, the children before it were laid out before with
+// the same constraints, and stack continues from the sums in stack. Only the
+// flex bases of the children from firstChild on are computed, and only those
+// are laid out. This returns false if the container's available main size or
+// cross size would change, which the earlier children depend on, possibly
+// after laying out some of the later children.
 //
-static void YGNodelayoutImpl(
+// Leaves the sums over all children in stack.
+static bool YGLayoutPlainStackChildren(
     const YGNodeRef node,
-    const float availableWidth,
-    const float availableHeight,
-    const YGDirection ownerDirection,
-    const YGMeasureMode widthMeasureMode,
-    const YGMeasureMode heightMeasureMode,
+    const YGVirtualizedWindow* window,
+    const uint32_t firstChild,
+    YGStackLayoutState& stack,
+    YGCollectFlexItemsRowValues& collectedFlexItemsValues,
+    const YGFlexDirection mainAxis,
+    const YGFlexDirection crossAxis,
+    const YGDirection direction,
+    const YGMeasureMode measureModeMainDim,
+    const YGMeasureMode measureModeCrossDim,
+    const float mainAxisownerSize,
+    const float crossAxisownerSize,
     const float ownerWidth,
-    const float ownerHeight,
+    const float minInnerMainDim,
+    const float maxInnerMainDim,
+    float* availableInnerMainDim,
+    const float availableInnerCrossDim,
+    const float availableInnerWidth,
+    const float availableInnerHeight,
+    const float leadingPaddingAndBorderCross,
+    const float paddingAndBorderAxisCross,
     const bool performLayout,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
-    void* const layoutContext) {
-  YGAssertWithNode(
-      node,
-      YGFloatIsUndefined(availableWidth)
-          ? widthMeasureMode == YGMeasureModeUndefined
-          : true,
-      "availableWidth is indefinite so widthMeasureMode must be "
-      "YGMeasureModeUndefined");
-  YGAssertWithNode(
-      node,
-      YGFloatIsUndefined(availableHeight)
-          ? heightMeasureMode == YGMeasureModeUndefined
-          : true,
-      "availableHeight is indefinite so heightMeasureMode must be "
-      "YGMeasureModeUndefined");
-
-  (performLayout ? layoutMarkerData.layouts : layoutMarkerData.measures) += 1;
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  const uint32_t childCount = YGNodeGetChildCount(node);
 
-  // Set the resolved resolution in the node's layout.
-  const YGDirection direction = node->resolveDirection(ownerDirection);
-  node->setLayoutDirection(direction);
+  std::vector<bool> isInWindow;
+  float windowStart = 0;
+  float windowEnd = 0;
+  if (window != nullptr) {
+    isInWindow.resize(childCount);
+    windowStart = window->offset - window->overscan;
+    windowEnd = window->offset + window->extent + window->overscan;
+  }
+  float childStart =
+      node->getLeadingPaddingAndBorder(mainAxis, ownerWidth).unwrap();
 
-  const YGFlexDirection flexRowDirection =
-      YGResolveFlexDirection(YGFlexDirectionRow, direction);
-  const YGFlexDirection flexColumnDirection =
-      YGResolveFlexDirection(YGFlexDirectionColumn, direction);
+  const float initialAvailableInnerMainDim = *availableInnerMainDim;
+  collectedFlexItemsValues = {};
+  if (firstChild > 0) {
+    collectedFlexItemsValues.sizeConsumedOnCurrentLine = stack.sizeConsumed;
+  } else {
+    stack.childrenUseMainSize = false;
+  }
+  for (uint32_t i = firstChild; i < childCount; i++) {
+    const YGNodeRef child = node->getChild(i);
+    const float marginMain =
+        child->getMarginForAxis(mainAxis, availableInnerWidth).unwrap();
+    child->setLineIndex(0);
+    stack.childrenUseMainSize =
+        stack.childrenUseMainSize || YGNodeUsesOwnerMainSize(child);
+    if (window != nullptr) {
+      const float childEnd = childStart + marginMain +
+          YGNodeVirtualizedItemSize(child, mainAxis, *window);
+      isInWindow[i] = childEnd > windowStart && childStart < windowEnd;
+      if (!isInWindow[i]) {
+        collectedFlexItemsValues.sizeConsumedOnCurrentLine +=
+            childEnd - childStart;
+        childStart = childEnd;
+        continue;
+      }
+    }
+    if (window != nullptr || firstChild > 0) {
+      child->resolveDimension();
+      if (performLayout) {
+        child->setPosition(
+            child->resolveDirection(direction),
+            availableInnerHeight,
+            availableInnerWidth,
+            availableInnerWidth);
+      }
+      YGNodeComputeFlexBasisForChild(
+          node,
+          child,
+          availableInnerWidth,
+          measureModeCrossDim,
+          availableInnerHeight,
+          availableInnerWidth,
+          availableInnerHeight,
+          measureModeMainDim,
+          direction,
+          config,
+          layoutMarkerData,
+          layoutContext,
+          layoutPass);
+    }
+    const float childFlexBasis = YGNodeBoundAxisWithinMinAndMax(
+                                     child,
+                                     mainAxis,
+                                     child->getLayout().computedFlexBasis,
+                                     mainAxisownerSize)
+                                     .unwrap();
+    // Shrinking an infinite flex basis by a zero factor is not a no-op.
+    if (std::isinf(childFlexBasis)) {
+      return false;
+    }
+    collectedFlexItemsValues.sizeConsumedOnCurrentLine +=
+        childFlexBasis + marginMain;
+    childStart += childFlexBasis + marginMain;
+  }
+  collectedFlexItemsValues.itemsOnLine = childCount;
+  collectedFlexItemsValues.endOfLineIndex = childCount;
 
-  node->setLayoutMargin(
-      node->getLeadingMargin(flexRowDirection, ownerWidth).unwrap(),
-      YGEdgeStart);
-  node->setLayoutMargin(
-      node->getTrailingMargin(flexRowDirection, ownerWidth).unwrap(),
-      YGEdgeEnd);
-  node->setLayoutMargin(
-      node->getLeadingMargin(flexColumnDirection, ownerWidth).unwrap(),
-      YGEdgeTop);
-  node->setLayoutMargin(
-      node->getTrailingMargin(flexColumnDirection, ownerWidth).unwrap(),
-      YGEdgeBottom);
+  YGCalculateRemainingFreeSpace(
+      node,
+      collectedFlexItemsValues,
+      measureModeMainDim,
+      minInnerMainDim,
+      maxInnerMainDim,
+      availableInnerMainDim);
+  if (firstChild > 0 && stack.childrenUseMainSize &&
+      !YGFloatsEqual(*availableInnerMainDim, stack.availableInnerMainDim)) {
+    return false;
+  }
 
-  node->setLayoutBorder(node->getLeadingBorder(flexRowDirection), YGEdgeStart);
-  node->setLayoutBorder(node->getTrailingBorder(flexRowDirection), YGEdgeEnd);
-  node->setLayoutBorder(node->getLeadingBorder(flexColumnDirection), YGEdgeTop);
-  node->setLayoutBorder(
-      node->getTrailingBorder(flexColumnDirection), YGEdgeBottom);
+  // As none of the children flex, each of them is laid out with its flex basis
+  // as main size, and can be positioned right after that.
+  const bool canSkipFlex =
+      !performLayout && measureModeCrossDim == YGMeasureModeExactly;
+  if (firstChild > 0) {
+    collectedFlexItemsValues.mainDim = stack.mainDim;
+    collectedFlexItemsValues.crossDim = stack.crossDim;
+    node->setLayoutHadOverflow(
+        node->getLayout().hadOverflow | stack.childrenHadOverflow);
+  } else {
+    collectedFlexItemsValues.mainDim =
+        node->getLeadingPaddingAndBorder(mainAxis, ownerWidth).unwrap();
+    collectedFlexItemsValues.crossDim = 0;
+  }
+  for (uint32_t i = firstChild; i < childCount; i++) {
+    const YGNodeRef child = node->getChild(i);
+    const float marginMain =
+        child->getMarginForAxis(mainAxis, availableInnerWidth).unwrap();
 
-  node->setLayoutPadding(
-      node->getLeadingPadding(flexRowDirection, ownerWidth).unwrap(),
-      YGEdgeStart);
-  node->setLayoutPadding(
-      node->getTrailingPadding(flexRowDirection, ownerWidth).unwrap(),
-      YGEdgeEnd);
-  node->setLayoutPadding(
-      node->getLeadingPadding(flexColumnDirection, ownerWidth).unwrap(),
-      YGEdgeTop);
-  node->setLayoutPadding(
-      node->getTrailingPadding(flexColumnDirection, ownerWidth).unwrap(),
-      YGEdgeBottom);
+    if (window != nullptr && !isInWindow[i]) {
+      if (performLayout) {
+        YGNodePlaceVirtualizedChild(
+            child,
+            mainAxis,
+            crossAxis,
+            direction,
+            *window,
+            collectedFlexItemsValues.mainDim,
+            leadingPaddingAndBorderCross,
+            availableInnerCrossDim,
+            availableInnerWidth,
+            availableInnerHeight,
+            layoutPass);
+      }
+      collectedFlexItemsValues.mainDim +=
+          marginMain + YGNodeVirtualizedItemSize(child, mainAxis, *window);
+      continue;
+    }
+    if (canSkipFlex) {
+      collectedFlexItemsValues.mainDim +=
+          marginMain + child->getLayout().computedFlexBasis.unwrap();
+      collectedFlexItemsValues.crossDim = availableInnerCrossDim;
+      continue;
+    }
 
-  if (node->hasMeasureFunc()) {
-    YGNodeWithMeasureFuncSetMeasuredDimensions(
-        node,
-        availableWidth,
-        availableHeight,
-        widthMeasureMode,
-        heightMeasureMode,
-        ownerWidth,
-        ownerHeight,
-        layoutContext);
-    return;
-  }
+    const float marginCross =
+        child->getMarginForAxis(crossAxis, availableInnerWidth).unwrap();
+    const bool isCrossDimDefined =
+        YGNodeIsStyleDimDefined(child, crossAxis, availableInnerCrossDim);
+    const bool isStretched = YGNodeAlignItem(node, child) == YGAlignStretch;
+
+    float childMainSize = YGNodeBoundAxisWithinMinAndMax(
+                              child,
+                              mainAxis,
+                              child->getLayout().computedFlexBasis,
+                              mainAxisownerSize)
+                              .unwrap() +
+        marginMain;
+    float childCrossSize;
+    YGMeasureMode childMainMeasureMode = YGMeasureModeExactly;
+    YGMeasureMode childCrossMeasureMode;
 
-  const uint32_t childCount = YGNodeGetChildCount(node);
-  if (childCount == 0) {
-    YGNodeEmptyContainerSetMeasuredDimensions(
-        node,
-        availableWidth,
-        availableHeight,
-        widthMeasureMode,
-        heightMeasureMode,
-        ownerWidth,
-        ownerHeight);
-    return;
+    if (!YGFloatIsUndefined(availableInnerCrossDim) && !isCrossDimDefined &&
+        measureModeCrossDim == YGMeasureModeExactly && isStretched) {
+      childCrossSize = availableInnerCrossDim;
+      childCrossMeasureMode = YGMeasureModeExactly;
+    } else if (!isCrossDimDefined) {
+      childCrossSize = availableInnerCrossDim;
+      childCrossMeasureMode = YGFloatIsUndefined(childCrossSize)
+          ? YGMeasureModeUndefined
+          : YGMeasureModeAtMost;
+    } else {
+      childCrossSize =
+          YGResolveValue(
+              child->getResolvedDimension(YGDimensionWidth),
+              availableInnerCrossDim)
+              .unwrap() +
+          marginCross;
+      const bool isLoosePercentageMeasurement =
+          child->getResolvedDimension(YGDimensionWidth).unit ==
+              YGUnitPercent &&
+          measureModeCrossDim != YGMeasureModeExactly;
+      childCrossMeasureMode =
+          YGFloatIsUndefined(childCrossSize) || isLoosePercentageMeasurement
+          ? YGMeasureModeUndefined
+          : YGMeasureModeExactly;
+    }
+
+    YGConstrainMaxSizeForMode(
+        child,
+        mainAxis,
+        *availableInnerMainDim,
+        availableInnerWidth,
+        &childMainMeasureMode,
+        &childMainSize);
+    YGConstrainMaxSizeForMode(
+        child,
+        crossAxis,
+        availableInnerCrossDim,
+        availableInnerWidth,
+        &childCrossMeasureMode,
+        &childCrossSize);
+
+    YGLayoutNodeInternal(
+        child,
+        childCrossSize,
+        childMainSize,
+        node->getLayout().direction,
+        childCrossMeasureMode,
+        childMainMeasureMode,
+        availableInnerWidth,
+        availableInnerHeight,
+        performLayout && !(isStretched && !isCrossDimDefined),
+        "flex",
+        config,
+        layoutMarkerData,
+        layoutContext,
+        layoutPass);
+    node->setLayoutHadOverflow(
+        node->getLayout().hadOverflow | child->getLayout().hadOverflow);
+
+    if (performLayout) {
+      child->setLayoutPosition(
+          child->getLayout().position[pos[mainAxis]] +
+              collectedFlexItemsValues.mainDim,
+          pos[mainAxis]);
+    }
+    collectedFlexItemsValues.mainDim +=
+        YGNodeDimWithMargin(child, mainAxis, availableInnerWidth);
+    collectedFlexItemsValues.crossDim = YGFloatMax(
+        collectedFlexItemsValues.crossDim,
+        YGNodeDimWithMargin(child, crossAxis, availableInnerWidth));
+  }
+  if (firstChild > 0 && performLayout &&
+      measureModeCrossDim != YGMeasureModeExactly &&
+      collectedFlexItemsValues.crossDim != stack.crossDim) {
+    return false;
   }
+  stack.childCount = childCount;
+  stack.sizeConsumed = collectedFlexItemsValues.sizeConsumedOnCurrentLine;
+  stack.availableInnerMainDim = *availableInnerMainDim;
+  stack.mainDim = collectedFlexItemsValues.mainDim;
+  stack.crossDim = collectedFlexItemsValues.crossDim;
+  stack.childrenHadOverflow = node->getLayout().hadOverflow;
+  stack.childrenFitMainSize = node->getStyle().overflow == YGOverflowScroll ||
+      YGFloatIsUndefined(initialAvailableInnerMainDim) ||
+      initialAvailableInnerMainDim >= stack.sizeConsumed;
+  collectedFlexItemsValues.mainDim +=
+      node->getTrailingPaddingAndBorder(mainAxis, ownerWidth).unwrap();
 
-  // If we're not being asked to perform a full layout we can skip the algorithm
-  // if we already know the size
-  if (!performLayout &&
-      YGNodeFixedSizeSetMeasuredDimensions(
+  node->setLayoutHadOverflow(
+      node->getLayout().hadOverflow |
+      (collectedFlexItemsValues.remainingFreeSpace < 0));
+
+  float containerCrossAxis = availableInnerCrossDim;
+  if (measureModeCrossDim == YGMeasureModeUndefined ||
+      measureModeCrossDim == YGMeasureModeAtMost) {
+    // Compute the cross axis from the max cross dimension of the children.
+    containerCrossAxis =
+        YGNodeBoundAxis(
+            node,
+            crossAxis,
+            collectedFlexItemsValues.crossDim + paddingAndBorderAxisCross,
+            crossAxisownerSize,
+            ownerWidth) -
+        paddingAndBorderAxisCross;
+  }
+  if (measureModeCrossDim == YGMeasureModeExactly) {
+    collectedFlexItemsValues.crossDim = availableInnerCrossDim;
+  }
+  collectedFlexItemsValues.crossDim =
+      YGNodeBoundAxis(
           node,
-          availableWidth,
-          availableHeight,
-          widthMeasureMode,
-          heightMeasureMode,
-          ownerWidth,
-          ownerHeight)) {
-    return;
+          crossAxis,
+          collectedFlexItemsValues.crossDim + paddingAndBorderAxisCross,
+          crossAxisownerSize,
+          ownerWidth) -
+      paddingAndBorderAxisCross;
+
+  if (!performLayout) {
+    return true;
   }
+  for (uint32_t i = firstChild; i < childCount; i++) {
+    const YGNodeRef child = node->getChild(i);
+    if (window != nullptr && !isInWindow[i]) {
+      continue;
+    }
+    float leadingCrossDim = leadingPaddingAndBorderCross;
+    const YGAlign alignItem = YGNodeAlignItem(node, child);
+    if (alignItem == YGAlignStretch) {
+      if (!YGNodeIsStyleDimDefined(child, crossAxis, availableInnerCrossDim)) {
+        float childMainSize =
+            child->getLayout().measuredDimensions[YGDimensionHeight] +
+            child->getMarginForAxis(mainAxis, availableInnerWidth).unwrap();
+        float childCrossSize = collectedFlexItemsValues.crossDim;
+
+        YGMeasureMode childMainMeasureMode = YGMeasureModeExactly;
+        YGMeasureMode childCrossMeasureMode = YGMeasureModeExactly;
+        YGConstrainMaxSizeForMode(
+            child,
+            mainAxis,
+            *availableInnerMainDim,
+            availableInnerWidth,
+            &childMainMeasureMode,
+            &childMainSize);
+        YGConstrainMaxSizeForMode(
+            child,
+            crossAxis,
+            availableInnerCrossDim,
+            availableInnerWidth,
+            &childCrossMeasureMode,
+            &childCrossSize);
 
-  // At this point we know we're going to perform work. Ensure that each child
-  // has a mutable copy.
-  node->cloneChildrenIfNeeded(layoutContext);
-  // Reset layout flags, as they could have changed.
-  node->setLayoutHadOverflow(false);
+        YGLayoutNodeInternal(
+            child,
+            childCrossSize,
+            childMainSize,
+            direction,
+            YGFloatIsUndefined(childCrossSize) ? YGMeasureModeUndefined
+                                               : YGMeasureModeExactly,
+            YGFloatIsUndefined(childMainSize) ? YGMeasureModeUndefined
+                                              : YGMeasureModeExactly,
+            availableInnerWidth,
+            availableInnerHeight,
+            true,
+            "stretch",
+            config,
+            layoutMarkerData,
+            layoutContext,
+            layoutPass);
+      }
+    } else {
+      const float remainingCrossDim = containerCrossAxis -
+          YGNodeDimWithMargin(child, crossAxis, availableInnerWidth);
+      if (alignItem == YGAlignFlexStart) {
+        // No-Op
+      } else if (alignItem == YGAlignCenter) {
+        leadingCrossDim += remainingCrossDim / 2;
+      } else {
+        leadingCrossDim += remainingCrossDim;
+      }
+    }
+    child->setLayoutPosition(
+        child->getLayout().position[pos[crossAxis]] + leadingCrossDim,
+        pos[crossAxis]);
+  }
+  return true;
+}
+
+// Steps 1 to 11 of YGNodelayoutImpl for containers with children.
+static void YGNodelayoutChildren(
+    const YGNodeRef node,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection direction,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const float ownerHeight,
+    const bool performLayout,
+    const YGConfigRef config,
+    YGMarkerLayoutData& layoutMarkerData,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  const uint32_t childCount = YGNodeGetChildCount(node);
 
   // STEP 1: CALCULATE VALUES FOR REMAINDER OF ALGORITHM
   const YGFlexDirection mainAxis =
@@ -2758,6 +3831,10 @@ static void YGNodelayoutImpl(
   const YGFlexDirection crossAxis = YGFlexDirectionCross(mainAxis, direction);
   const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
   const bool isNodeFlexWrap = node->getStyle().flexWrap != YGWrapNoWrap;
+  const YGDimension mainAxisDim =
+      isMainAxisRow ? YGDimensionWidth : YGDimensionHeight;
+  const YGDimension crossAxisDim =
+      isMainAxisRow ? YGDimensionHeight : YGDimensionWidth;
 
   const float mainAxisownerSize = isMainAxisRow ? ownerWidth : ownerHeight;
   const float crossAxisownerSize = isMainAxisRow ? ownerHeight : ownerWidth;
@@ -2820,20 +3897,57 @@ static void YGNodelayoutImpl(
   const float availableInnerCrossDim =
       isMainAxisRow ? availableInnerHeight : availableInnerWidth;
 
+  // Virtualized stacks only compute the flex bases of the children in their
+  // window, in YGLayoutPlainStackChildren. They are stacked that way even when
+  // child layouts would otherwise be deferred, as only few children are laid
+  // out.
+  const bool isPlainStack =
+      !isMainAxisRow && !isNodeFlexWrap && YGNodeIsPlainStack(node);
+  const bool isColumnStack = isPlainStack &&
+      node->getStyle().flexDirection == YGFlexDirectionColumn;
+  const YGVirtualizedWindow* const window =
+      isColumnStack ? node->getVirtualizedWindow() : nullptr;
+  const bool canStack =
+      isPlainStack && !YGShouldDeferChildLayouts(config, layoutPass);
+
+  // Stacks to which children were only appended since they were last laid out
+  // with the same constraints only lay out the new children, continuing from
+  // the sums over the earlier ones. Children of reversed columns would move as
+  // the container grows.
+  const YGStackLayoutState* const previousStack = node->getStackLayoutState();
+  YGStackLayoutState stack =
+      previousStack != nullptr ? *previousStack : YGStackLayoutState{};
+  stack.availableWidth = availableWidth;
+  stack.availableHeight = availableHeight;
+  stack.ownerWidth = ownerWidth;
+  stack.ownerHeight = ownerHeight;
+  stack.widthMeasureMode = widthMeasureMode;
+  stack.heightMeasureMode = heightMeasureMode;
+  stack.direction = direction;
+  const bool isAppend = window == nullptr && isColumnStack && canStack &&
+      previousStack != nullptr && previousStack->childCount <= childCount &&
+      YGStackLayoutIsReusable(
+          node, *previousStack, stack, availableInnerMainDim);
+
   // STEP 3: DETERMINE FLEX BASIS FOR EACH ITEM
 
-  float totalOuterFlexBasis = YGNodeComputeFlexBasisForChildren(
-      node,
-      availableInnerWidth,
-      availableInnerHeight,
-      widthMeasureMode,
-      heightMeasureMode,
-      direction,
-      mainAxis,
-      config,
-      performLayout,
-      layoutMarkerData,
-      layoutContext);
+  const auto computeFlexBasisForChildren = [&]() {
+    return YGNodeComputeFlexBasisForChildren(
+        node,
+        availableInnerWidth,
+        availableInnerHeight,
+        widthMeasureMode,
+        heightMeasureMode,
+        direction,
+        mainAxis,
+        config,
+        performLayout,
+        layoutMarkerData,
+        layoutContext,
+        layoutPass);
+  };
+  float totalOuterFlexBasis =
+      window == nullptr && !isAppend ? computeFlexBasisForChildren() : 0;
 
   const bool flexBasisOverflows = measureModeMainDim == YGMeasureModeUndefined
       ? false
@@ -2857,16 +3971,80 @@ static void YGNodelayoutImpl(
   // Max main dimension of all the lines.
   float maxLineMainDim = 0;
   YGCollectFlexItemsRowValues collectedFlexItemsValues;
-  for (; endOfLineIndex < childCount;
-       lineCount++, startOfLineIndex = endOfLineIndex) {
-    collectedFlexItemsValues = YGCalculateCollectFlexItemsRowValues(
+  const float initialAvailableInnerMainDim = availableInnerMainDim;
+  const auto layoutPlainStackChildren = [&](const uint32_t firstChild) {
+    return YGLayoutPlainStackChildren(
         node,
-        ownerDirection,
+        window,
+        firstChild,
+        stack,
+        collectedFlexItemsValues,
+        mainAxis,
+        crossAxis,
+        direction,
+        measureModeMainDim,
+        measureModeCrossDim,
         mainAxisownerSize,
+        crossAxisownerSize,
+        ownerWidth,
+        minInnerMainDim,
+        maxInnerMainDim,
+        &availableInnerMainDim,
+        availableInnerCrossDim,
         availableInnerWidth,
-        availableInnerMainDim,
-        startOfLineIndex,
-        lineCount);
+        availableInnerHeight,
+        leadingPaddingAndBorderCross,
+        paddingAndBorderAxisCross,
+        performLayout,
+        config,
+        layoutMarkerData,
+        layoutContext,
+        layoutPass);
+  };
+  // Children before this one keep the frames of the previous layout.
+  uint32_t firstLaidOutChild = 0;
+  bool isStacked = false;
+  if (window != nullptr || isAppend) {
+    const uint32_t firstAppendedChild = isAppend ? stack.childCount : 0;
+    isStacked = layoutPlainStackChildren(firstAppendedChild);
+    if (isStacked) {
+      firstLaidOutChild = firstAppendedChild;
+    } else {
+      // All children are laid out from here on, which needs all flex bases.
+      computeFlexBasisForChildren();
+      availableInnerMainDim = initialAvailableInnerMainDim;
+      node->setLayoutHadOverflow(false);
+    }
+  }
+  if (!isStacked && window == nullptr && canStack) {
+    isStacked = layoutPlainStackChildren(0);
+  }
+  if (performLayout) {
+    if (isStacked && window == nullptr) {
+      node->setStackLayoutState(stack);
+    } else {
+      node->clearStackLayoutState();
+    }
+  }
+  if (isStacked) {
+    // The children were laid out as a single line, so the loop below is done.
+    endOfLineIndex = childCount;
+    lineCount = 1;
+    totalLineCrossDim += collectedFlexItemsValues.crossDim;
+    maxLineMainDim =
+        YGFloatMax(maxLineMainDim, collectedFlexItemsValues.mainDim);
+  }
+  for (; endOfLineIndex < childCount;
+       lineCount++, startOfLineIndex = endOfLineIndex) {
+    collectedFlexItemsValues =
+        YGCalculateCollectFlexItemsRowValues(
+            node,
+            mainAxis,
+            mainAxisownerSize,
+            availableInnerWidth,
+            availableInnerMainDim,
+            startOfLineIndex,
+            lineCount);
     endOfLineIndex = collectedFlexItemsValues.endOfLineIndex;
 
     // If we don't need to measure the cross axis, we can skip the entire flex
@@ -2875,55 +4053,13 @@ static void YGNodelayoutImpl(
         !performLayout && measureModeCrossDim == YGMeasureModeExactly;
 
     // STEP 5: RESOLVING FLEXIBLE LENGTHS ON MAIN AXIS
-    // Calculate the remaining available space that needs to be allocated. If
-    // the main dimension size isn't known, it is computed based on the line
-    // length, so there's no more space left to distribute.
-
-    bool sizeBasedOnContent = false;
-    // If we don't measure with exact main dimension we want to ensure we don't
-    // violate min and max
-    if (measureModeMainDim != YGMeasureModeExactly) {
-      if (!YGFloatIsUndefined(minInnerMainDim) &&
-          collectedFlexItemsValues.sizeConsumedOnCurrentLine <
-              minInnerMainDim) {
-        availableInnerMainDim = minInnerMainDim;
-      } else if (
-          !YGFloatIsUndefined(maxInnerMainDim) &&
-          collectedFlexItemsValues.sizeConsumedOnCurrentLine >
-              maxInnerMainDim) {
-        availableInnerMainDim = maxInnerMainDim;
-      } else {
-        if (!node->getConfig()->useLegacyStretchBehaviour &&
-            ((YGFloatIsUndefined(
-                  collectedFlexItemsValues.totalFlexGrowFactors) &&
-              collectedFlexItemsValues.totalFlexGrowFactors == 0) ||
-             (YGFloatIsUndefined(node->resolveFlexGrow()) &&
-              node->resolveFlexGrow() == 0))) {
-          // If we don't have any children to flex or we can't flex the node
-          // itself, space we've used is all space we need. Root node also
-          // should be shrunk to minimum
-          availableInnerMainDim =
-              collectedFlexItemsValues.sizeConsumedOnCurrentLine;
-        }
-
-        if (node->getConfig()->useLegacyStretchBehaviour) {
-          node->setLayoutDidUseLegacyFlag(true);
-        }
-        sizeBasedOnContent = !node->getConfig()->useLegacyStretchBehaviour;
-      }
-    }
-
-    if (!sizeBasedOnContent && !YGFloatIsUndefined(availableInnerMainDim)) {
-      collectedFlexItemsValues.remainingFreeSpace = availableInnerMainDim -
-          collectedFlexItemsValues.sizeConsumedOnCurrentLine;
-    } else if (collectedFlexItemsValues.sizeConsumedOnCurrentLine < 0) {
-      // availableInnerMainDim is indefinite which means the node is being sized
-      // based on its content. sizeConsumedOnCurrentLine is negative which means
-      // the node will allocate 0 points for its content. Consequently,
-      // remainingFreeSpace is 0 - sizeConsumedOnCurrentLine.
-      collectedFlexItemsValues.remainingFreeSpace =
-          -collectedFlexItemsValues.sizeConsumedOnCurrentLine;
-    }
+    YGCalculateRemainingFreeSpace(
+        node,
+        collectedFlexItemsValues,
+        measureModeMainDim,
+        minInnerMainDim,
+        maxInnerMainDim,
+        &availableInnerMainDim);
 
     if (!canSkipFlex) {
       YGResolveFlexibleLength(
@@ -2941,7 +4077,8 @@ static void YGNodelayoutImpl(
           performLayout,
           config,
           layoutMarkerData,
-          layoutContext);
+          layoutContext,
+          layoutPass);
     }
 
     node->setLayoutHadOverflow(
@@ -3003,6 +4140,11 @@ static void YGNodelayoutImpl(
     // STEP 7: CROSS-AXIS ALIGNMENT
     // We can skip child alignment if we're just measuring the container.
     if (performLayout) {
+      // Stretched children are positioned independently of their layout
+      // results, so their layouts can be deferred to the end of the line.
+      const bool deferChildLayouts =
+          YGShouldDeferChildLayouts(config, layoutPass);
+      std::vector<YGDeferredChildLayout> deferredLayouts;
       for (uint32_t i = startOfLineIndex; i < endOfLineIndex; i++) {
         const YGNodeRef child = node->getChild(i);
         if (child->getStyle().display == YGDisplayNone) {
@@ -3052,7 +4194,7 @@ static void YGNodelayoutImpl(
             if (!YGNodeIsStyleDimDefined(
                     child, crossAxis, availableInnerCrossDim)) {
               float childMainSize =
-                  child->getLayout().measuredDimensions[dim[mainAxis]];
+                  child->getLayout().measuredDimensions[mainAxisDim];
               float childCrossSize =
                   !child->getStyle().aspectRatio.isUndefined()
                   ? child->getMarginForAxis(crossAxis, availableInnerWidth)
@@ -3103,7 +4245,7 @@ static void YGNodelayoutImpl(
                   ? YGMeasureModeUndefined
                   : YGMeasureModeExactly;
 
-              YGLayoutNodeInternal(
+              const YGDeferredChildLayout childLayout = {
                   child,
                   childWidth,
                   childHeight,
@@ -3113,10 +4255,17 @@ static void YGNodelayoutImpl(
                   availableInnerWidth,
                   availableInnerHeight,
                   true,
-                  "stretch",
-                  config,
-                  layoutMarkerData,
-                  layoutContext);
+                  "stretch"};
+              if (deferChildLayouts) {
+                deferredLayouts.push_back(childLayout);
+              } else {
+                YGLayoutDeferredChild(
+                    childLayout,
+                    config,
+                    layoutMarkerData,
+                    layoutContext,
+                    layoutPass);
+              }
             }
           } else {
             const float remainingCrossDim = containerCrossAxis -
@@ -3146,6 +4295,14 @@ static void YGNodelayoutImpl(
               pos[crossAxis]);
         }
       }
+      if (deferChildLayouts) {
+        YGLayoutDeferredChildren(
+            deferredLayouts,
+            config,
+            layoutMarkerData,
+            layoutContext,
+            layoutPass);
+      }
     }
 
     totalLineCrossDim += collectedFlexItemsValues.crossDim;
@@ -3215,7 +4372,7 @@ static void YGNodelayoutImpl(
           if (YGNodeIsLayoutDimDefined(child, crossAxis)) {
             lineHeight = YGFloatMax(
                 lineHeight,
-                child->getLayout().measuredDimensions[dim[crossAxis]] +
+                child->getLayout().measuredDimensions[crossAxisDim] +
                     child->getMarginForAxis(crossAxis, availableInnerWidth)
                         .unwrap());
           }
@@ -3265,13 +4422,13 @@ static void YGNodelayoutImpl(
                     currentLead + lineHeight -
                         child->getTrailingMargin(crossAxis, availableInnerWidth)
                             .unwrap() -
-                        child->getLayout().measuredDimensions[dim[crossAxis]],
+                        child->getLayout().measuredDimensions[crossAxisDim],
                     pos[crossAxis]);
                 break;
               }
               case YGAlignCenter: {
                 float childHeight =
-                    child->getLayout().measuredDimensions[dim[crossAxis]];
+                    child->getLayout().measuredDimensions[crossAxisDim];
 
                 child->setLayoutPosition(
                     currentLead + (lineHeight - childHeight) / 2,
@@ -3324,7 +4481,8 @@ static void YGNodelayoutImpl(
                         "multiline-stretch",
                         config,
                         layoutMarkerData,
-                        layoutContext);
+                        layoutContext,
+                        layoutPass);
                   }
                 }
                 break;
@@ -3373,129 +4531,328 @@ static void YGNodelayoutImpl(
           ownerWidth),
       YGDimensionHeight);
 
-  // If the user didn't specify a width or height for the node, set the
-  // dimensions based on the children.
-  if (measureModeMainDim == YGMeasureModeUndefined ||
-      (node->getStyle().overflow != YGOverflowScroll &&
-       measureModeMainDim == YGMeasureModeAtMost)) {
-    // Clamp the size to the min/max size, if specified, and make sure it
-    // doesn't go below the padding and border amount.
-    node->setLayoutMeasuredDimension(
-        YGNodeBoundAxis(
-            node, mainAxis, maxLineMainDim, mainAxisownerSize, ownerWidth),
-        dim[mainAxis]);
+  // If the user didn't specify a width or height for the node, set the
+  // dimensions based on the children.
+  if (measureModeMainDim == YGMeasureModeUndefined ||
+      (node->getStyle().overflow != YGOverflowScroll &&
+       measureModeMainDim == YGMeasureModeAtMost)) {
+    // Clamp the size to the min/max size, if specified, and make sure it
+    // doesn't go below the padding and border amount.
+    node->setLayoutMeasuredDimension(
+        YGNodeBoundAxis(
+            node, mainAxis, maxLineMainDim, mainAxisownerSize, ownerWidth),
+        mainAxisDim);
+
+  } else if (
+      measureModeMainDim == YGMeasureModeAtMost &&
+      node->getStyle().overflow == YGOverflowScroll) {
+    node->setLayoutMeasuredDimension(
+        YGFloatMax(
+            YGFloatMin(
+                availableInnerMainDim + paddingAndBorderAxisMain,
+                YGNodeBoundAxisWithinMinAndMax(
+                    node,
+                    mainAxis,
+                    YGFloatOptional{maxLineMainDim},
+                    mainAxisownerSize)
+                    .unwrap()),
+            paddingAndBorderAxisMain),
+        mainAxisDim);
+  }
+
+  if (measureModeCrossDim == YGMeasureModeUndefined ||
+      (node->getStyle().overflow != YGOverflowScroll &&
+       measureModeCrossDim == YGMeasureModeAtMost)) {
+    // Clamp the size to the min/max size, if specified, and make sure it
+    // doesn't go below the padding and border amount.
+    node->setLayoutMeasuredDimension(
+        YGNodeBoundAxis(
+            node,
+            crossAxis,
+            totalLineCrossDim + paddingAndBorderAxisCross,
+            crossAxisownerSize,
+            ownerWidth),
+        crossAxisDim);
+
+  } else if (
+      measureModeCrossDim == YGMeasureModeAtMost &&
+      node->getStyle().overflow == YGOverflowScroll) {
+    node->setLayoutMeasuredDimension(
+        YGFloatMax(
+            YGFloatMin(
+                availableInnerCrossDim + paddingAndBorderAxisCross,
+                YGNodeBoundAxisWithinMinAndMax(
+                    node,
+                    crossAxis,
+                    YGFloatOptional{totalLineCrossDim +
+                                    paddingAndBorderAxisCross},
+                    crossAxisownerSize)
+                    .unwrap()),
+            paddingAndBorderAxisCross),
+        crossAxisDim);
+  }
+
+  // As we only wrapped in normal direction yet, we need to reverse the
+  // positions on wrap-reverse.
+  if (performLayout && node->getStyle().flexWrap == YGWrapWrapReverse) {
+    for (uint32_t i = 0; i < childCount; i++) {
+      const YGNodeRef child = YGNodeGetChild(node, i);
+      if (child->getStyle().positionType == YGPositionTypeRelative) {
+        child->setLayoutPosition(
+            node->getLayout().measuredDimensions[crossAxisDim] -
+                child->getLayout().position[pos[crossAxis]] -
+                child->getLayout().measuredDimensions[crossAxisDim],
+            pos[crossAxis]);
+      }
+    }
+  }
+
+  if (performLayout) {
+    // STEP 10: SIZING AND POSITIONING ABSOLUTE CHILDREN
+    for (auto child : node->getChildren()) {
+      if (child->getStyle().positionType != YGPositionTypeAbsolute) {
+        continue;
+      }
+      YGNodeAbsoluteLayoutChild(
+          node,
+          child,
+          availableInnerWidth,
+          isMainAxisRow ? measureModeMainDim : measureModeCrossDim,
+          availableInnerHeight,
+          direction,
+          config,
+          layoutMarkerData,
+          layoutContext,
+          layoutPass);
+    }
+
+    // STEP 11: SETTING TRAILING POSITIONS FOR CHILDREN
+    const bool needsMainTrailingPos = mainAxis == YGFlexDirectionRowReverse ||
+        mainAxis == YGFlexDirectionColumnReverse;
+    const bool needsCrossTrailingPos = crossAxis == YGFlexDirectionRowReverse ||
+        crossAxis == YGFlexDirectionColumnReverse;
+
+    // Set trailing position if necessary. The measured dimensions of children
+    // that were not laid out again may since have been overwritten by measure
+    // passes under other constraints, while their positions are still final.
+    if (needsMainTrailingPos || needsCrossTrailingPos) {
+      for (uint32_t i = firstLaidOutChild; i < childCount; i++) {
+        const YGNodeRef child = node->getChild(i);
+        if (child->getStyle().display == YGDisplayNone) {
+          continue;
+        }
+        if (needsMainTrailingPos) {
+          YGNodeSetChildTrailingPosition(node, child, mainAxis);
+        }
+
+        if (needsCrossTrailingPos) {
+          YGNodeSetChildTrailingPosition(node, child, crossAxis);
+        }
+      }
+    }
+  }
+}
+
+//
+// This is the main routine that implements a subset of the flexbox layout
+// algorithm described in the W3C CSS documentation:
+// https://www.w3.org/TR/CSS3-flexbox/.
+//
+// Limitations of this algorithm, compared to the full standard:
+//  * Display property is always assumed to be 'flex' except for Text nodes,
+//    which are assumed to be 'inline-flex'.
+//  * The 'zIndex' property (or any form of z ordering) is not supported. Nodes
+//    are stacked in document order.
+//  * The 'order' property is not supported. The order of flex items is always
+//    defined by document order.
+//  * The 'visibility' property is always assumed to be 'visible'. Values of
+//    'collapse' and 'hidden' are not supported.
+//  * There is no support for forced breaks.
+//  * It does not support vertical inline directions (top-to-bottom or
+//    bottom-to-top text).
+//
+// Deviations from standard:
+//  * Section 4.5 of the spec indicates that all flex items have a default
+//    minimum main size. For text blocks, for example, this is the width of the
+//    widest word. Calculating the minimum width is expensive, so we forego it
+//    and assume a default minimum main size of 0.
+//  * Min/Max sizes in the main axis are not honored when resolving flexible
+//    lengths.
+//  * The spec indicates that the default value for 'flexDirection' is 'row',
+//    but the algorithm below assumes a default of 'column'.
+//
+// Input parameters:
+//    - node: current node to be sized and layed out
+//    - availableWidth & availableHeight: available size to be used for sizing
+//      the node or YGUndefined if the size is not available; interpretation
+//      depends on layout flags
+//    - ownerDirection: the inline (text) direction within the owner
+//      (left-to-right or right-to-left)
+//    - widthMeasureMode: indicates the sizing rules for the width (see below
+//      for explanation)
+//    - heightMeasureMode: indicates the sizing rules for the height (see below
+//      for explanation)
+//    - performLayout: specifies whether the caller is interested in just the
+//      dimensions of the node or it requires the entire node and its subtree to
+//      be layed out (with final positions)
+//
+// Details:
+//    This routine is called recursively to lay out subtrees of flexbox
+//    elements. It uses the information in node.style, which is treated as a
+//    read-only input. It is responsible for setting the layout.direction and
+//    layout.measuredDimensions fields for the input node as well as the
+//    layout.position and layout.lineIndex fields for its child nodes. The
+//    layout.measuredDimensions field includes any border or padding for the
+//    node but does not include margins.
+//
+//    The spec describes four different layout modes: "fill available", "max
+//    content", "min content", and "fit content". Of these, we don't use "min
+//    content" because we don't support default minimum main sizes (see above
+//    for details). Each of our measure modes maps to a layout mode from the
+//    spec (https://www.w3.org/TR/CSS3-sizing/#terms):
+//      - YGMeasureModeUndefined: max content
+//      - YGMeasureModeExactly: fill available
+//      - YGMeasureModeAtMost: fit content
+//
+//    When calling YGNodelayoutImpl and YGLayoutNodeInternal, if the caller
+//    passes an available size of undefined then it must also pass a measure
+//    mode of YGMeasureModeUndefined in that dimension.
+//
+static void YGNodelayoutImpl(
+    const YGNodeRef node,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection ownerDirection,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const float ownerHeight,
+    const bool performLayout,
+    const YGConfigRef config,
+    YGMarkerLayoutData& layoutMarkerData,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  YGAssertWithNode(
+      node,
+      YGFloatIsUndefined(availableWidth)
+          ? widthMeasureMode == YGMeasureModeUndefined
+          : true,
+      "availableWidth is indefinite so widthMeasureMode must be "
+      "YGMeasureModeUndefined");
+  YGAssertWithNode(
+      node,
+      YGFloatIsUndefined(availableHeight)
+          ? heightMeasureMode == YGMeasureModeUndefined
+          : true,
+      "availableHeight is indefinite so heightMeasureMode must be "
+      "YGMeasureModeUndefined");
+
+  (performLayout ? layoutMarkerData.layouts : layoutMarkerData.measures) += 1;
+
+  // Set the resolved resolution in the node's layout.
+  const YGDirection direction = node->resolveDirection(ownerDirection);
+  node->setLayoutDirection(direction);
+
+  const YGFlexDirection flexRowDirection =
+      YGResolveFlexDirection(YGFlexDirectionRow, direction);
+  const YGFlexDirection flexColumnDirection =
+      YGResolveFlexDirection(YGFlexDirectionColumn, direction);
+
+  node->setLayoutMargin(
+      node->getLeadingMargin(flexRowDirection, ownerWidth).unwrap(),
+      YGEdgeStart);
+  node->setLayoutMargin(
+      node->getTrailingMargin(flexRowDirection, ownerWidth).unwrap(),
+      YGEdgeEnd);
+  node->setLayoutMargin(
+      node->getLeadingMargin(flexColumnDirection, ownerWidth).unwrap(),
+      YGEdgeTop);
+  node->setLayoutMargin(
+      node->getTrailingMargin(flexColumnDirection, ownerWidth).unwrap(),
+      YGEdgeBottom);
 
-  } else if (
-      measureModeMainDim == YGMeasureModeAtMost &&
-      node->getStyle().overflow == YGOverflowScroll) {
-    node->setLayoutMeasuredDimension(
-        YGFloatMax(
-            YGFloatMin(
-                availableInnerMainDim + paddingAndBorderAxisMain,
-                YGNodeBoundAxisWithinMinAndMax(
-                    node,
-                    mainAxis,
-                    YGFloatOptional{maxLineMainDim},
-                    mainAxisownerSize)
-                    .unwrap()),
-            paddingAndBorderAxisMain),
-        dim[mainAxis]);
-  }
+  node->setLayoutBorder(node->getLeadingBorder(flexRowDirection), YGEdgeStart);
+  node->setLayoutBorder(node->getTrailingBorder(flexRowDirection), YGEdgeEnd);
+  node->setLayoutBorder(node->getLeadingBorder(flexColumnDirection), YGEdgeTop);
+  node->setLayoutBorder(
+      node->getTrailingBorder(flexColumnDirection), YGEdgeBottom);
 
-  if (measureModeCrossDim == YGMeasureModeUndefined ||
-      (node->getStyle().overflow != YGOverflowScroll &&
-       measureModeCrossDim == YGMeasureModeAtMost)) {
-    // Clamp the size to the min/max size, if specified, and make sure it
-    // doesn't go below the padding and border amount.
-    node->setLayoutMeasuredDimension(
-        YGNodeBoundAxis(
-            node,
-            crossAxis,
-            totalLineCrossDim + paddingAndBorderAxisCross,
-            crossAxisownerSize,
-            ownerWidth),
-        dim[crossAxis]);
+  node->setLayoutPadding(
+      node->getLeadingPadding(flexRowDirection, ownerWidth).unwrap(),
+      YGEdgeStart);
+  node->setLayoutPadding(
+      node->getTrailingPadding(flexRowDirection, ownerWidth).unwrap(),
+      YGEdgeEnd);
+  node->setLayoutPadding(
+      node->getLeadingPadding(flexColumnDirection, ownerWidth).unwrap(),
+      YGEdgeTop);
+  node->setLayoutPadding(
+      node->getTrailingPadding(flexColumnDirection, ownerWidth).unwrap(),
+      YGEdgeBottom);
 
-  } else if (
-      measureModeCrossDim == YGMeasureModeAtMost &&
-      node->getStyle().overflow == YGOverflowScroll) {
-    node->setLayoutMeasuredDimension(
-        YGFloatMax(
-            YGFloatMin(
-                availableInnerCrossDim + paddingAndBorderAxisCross,
-                YGNodeBoundAxisWithinMinAndMax(
-                    node,
-                    crossAxis,
-                    YGFloatOptional{totalLineCrossDim +
-                                    paddingAndBorderAxisCross},
-                    crossAxisownerSize)
-                    .unwrap()),
-            paddingAndBorderAxisCross),
-        dim[crossAxis]);
+  if (node->hasMeasureFunc()) {
+    YGNodeWithMeasureFuncSetMeasuredDimensions(
+        node,
+        availableWidth,
+        availableHeight,
+        widthMeasureMode,
+        heightMeasureMode,
+        ownerWidth,
+        ownerHeight,
+        layoutContext,
+        layoutPass);
+    return;
   }
 
-  // As we only wrapped in normal direction yet, we need to reverse the
-  // positions on wrap-reverse.
-  if (performLayout && node->getStyle().flexWrap == YGWrapWrapReverse) {
-    for (uint32_t i = 0; i < childCount; i++) {
-      const YGNodeRef child = YGNodeGetChild(node, i);
-      if (child->getStyle().positionType == YGPositionTypeRelative) {
-        child->setLayoutPosition(
-            node->getLayout().measuredDimensions[dim[crossAxis]] -
-                child->getLayout().position[pos[crossAxis]] -
-                child->getLayout().measuredDimensions[dim[crossAxis]],
-            pos[crossAxis]);
-      }
-    }
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  if (childCount == 0) {
+    YGNodeEmptyContainerSetMeasuredDimensions(
+        node,
+        availableWidth,
+        availableHeight,
+        widthMeasureMode,
+        heightMeasureMode,
+        ownerWidth,
+        ownerHeight);
+    return;
   }
 
-  if (performLayout) {
-    // STEP 10: SIZING AND POSITIONING ABSOLUTE CHILDREN
-    for (auto child : node->getChildren()) {
-      if (child->getStyle().positionType != YGPositionTypeAbsolute) {
-        continue;
-      }
-      YGNodeAbsoluteLayoutChild(
+  // If we're not being asked to perform a full layout we can skip the algorithm
+  // if we already know the size
+  if (!performLayout &&
+      YGNodeFixedSizeSetMeasuredDimensions(
           node,
-          child,
-          availableInnerWidth,
-          isMainAxisRow ? measureModeMainDim : measureModeCrossDim,
-          availableInnerHeight,
-          direction,
-          config,
-          layoutMarkerData,
-          layoutContext);
-    }
-
-    // STEP 11: SETTING TRAILING POSITIONS FOR CHILDREN
-    const bool needsMainTrailingPos = mainAxis == YGFlexDirectionRowReverse ||
-        mainAxis == YGFlexDirectionColumnReverse;
-    const bool needsCrossTrailingPos = crossAxis == YGFlexDirectionRowReverse ||
-        crossAxis == YGFlexDirectionColumnReverse;
+          availableWidth,
+          availableHeight,
+          widthMeasureMode,
+          heightMeasureMode,
+          ownerWidth,
+          ownerHeight)) {
+    return;
+  }
 
-    // Set trailing position if necessary.
-    if (needsMainTrailingPos || needsCrossTrailingPos) {
-      for (uint32_t i = 0; i < childCount; i++) {
-        const YGNodeRef child = node->getChild(i);
-        if (child->getStyle().display == YGDisplayNone) {
-          continue;
-        }
-        if (needsMainTrailingPos) {
-          YGNodeSetChildTrailingPosition(node, child, mainAxis);
-        }
+  // At this point we know we're going to perform work. Ensure that each child
+  // has a mutable copy.
+  node->cloneChildrenIfNeeded(layoutContext, layoutPass.cloneNode);
+  // Reset layout flags, as they could have changed.
+  node->setLayoutHadOverflow(false);
 
-        if (needsCrossTrailingPos) {
-          YGNodeSetChildTrailingPosition(node, child, crossAxis);
-        }
-      }
-    }
-  }
+  YGNodelayoutChildren(
+      node,
+      availableWidth,
+      availableHeight,
+      direction,
+      widthMeasureMode,
+      heightMeasureMode,
+      ownerWidth,
+      ownerHeight,
+      performLayout,
+      config,
+      layoutMarkerData,
+      layoutContext,
+      layoutPass);
 }
 
-uint32_t gDepth = 0;
-bool gPrintChanges = false;
-bool gPrintSkips = false;
-
 static const char* spacer =
     "                                                            ";
 
@@ -3605,6 +4962,87 @@ float YGRoundValueToPixelGrid(
       : scaledValue / pointScaleFactor;
 }
 
+// Sizes a cached measurement is looked up for. Requested sizes are compared to
+// the sizes of cached measurements after rounding both to the pixel grid, see
+// YGMeasurementCache::effectiveSize.
+struct YGMeasurementQuery {
+  YGMeasureMode widthMode;
+  float width;
+  float effectiveWidth;
+  YGMeasureMode heightMode;
+  float height;
+  float effectiveHeight;
+  float marginRow;
+  float marginColumn;
+
+  YGMeasurementQuery(
+      const YGMeasureMode widthMode,
+      const float width,
+      const YGMeasureMode heightMode,
+      const float height,
+      const float marginRow,
+      const float marginColumn,
+      const float pointScaleFactor)
+      : widthMode(widthMode),
+        width(width),
+        effectiveWidth(
+            YGMeasurementCache::effectiveSize(width, pointScaleFactor)),
+        heightMode(heightMode),
+        height(height),
+        effectiveHeight(
+            YGMeasurementCache::effectiveSize(height, pointScaleFactor)),
+        marginRow(marginRow),
+        marginColumn(marginColumn) {}
+};
+
+static bool YGCanUseCachedMeasurement(
+    const YGMeasurementQuery& query,
+    const YGCachedMeasurement& entry,
+    const float effectiveLastWidth,
+    const float effectiveLastHeight) {
+  const YGMeasureMode lastWidthMode = entry.widthMeasureMode;
+  const float lastWidth = entry.availableWidth;
+  const YGMeasureMode lastHeightMode = entry.heightMeasureMode;
+  const float lastHeight = entry.availableHeight;
+  const float lastComputedWidth = entry.computedWidth;
+  const float lastComputedHeight = entry.computedHeight;
+  if ((!YGFloatIsUndefined(lastComputedHeight) && lastComputedHeight < 0) ||
+      (!YGFloatIsUndefined(lastComputedWidth) && lastComputedWidth < 0)) {
+    return false;
+  }
+
+  const bool hasSameWidthSpec = lastWidthMode == query.widthMode &&
+      YGFloatsEqual(effectiveLastWidth, query.effectiveWidth);
+  const bool hasSameHeightSpec = lastHeightMode == query.heightMode &&
+      YGFloatsEqual(effectiveLastHeight, query.effectiveHeight);
+
+  const float width = query.width - query.marginRow;
+  const bool widthIsCompatible =
+      hasSameWidthSpec ||
+      YGMeasureModeSizeIsExactAndMatchesOldMeasuredSize(
+          query.widthMode, width, lastComputedWidth) ||
+      YGMeasureModeOldSizeIsUnspecifiedAndStillFits(
+          query.widthMode, width, lastWidthMode, lastComputedWidth) ||
+      YGMeasureModeNewMeasureSizeIsStricterAndStillValid(
+          query.widthMode, width, lastWidthMode, lastWidth, lastComputedWidth);
+
+  const float height = query.height - query.marginColumn;
+  const bool heightIsCompatible =
+      hasSameHeightSpec ||
+      YGMeasureModeSizeIsExactAndMatchesOldMeasuredSize(
+          query.heightMode, height, lastComputedHeight) ||
+      YGMeasureModeOldSizeIsUnspecifiedAndStillFits(
+          query.heightMode, height, lastHeightMode, lastComputedHeight) ||
+      YGMeasureModeNewMeasureSizeIsStricterAndStillValid(
+          query.heightMode,
+          height,
+          lastHeightMode,
+          lastHeight,
+          lastComputedHeight);
+
+  return widthIsCompatible && heightIsCompatible;
+}
+
 bool YGNodeCanUseCachedMeasurement(
     const YGMeasureMode widthMode,
     const float width,
@@ -3619,62 +5057,310 @@ bool YGNodeCanUseCachedMeasurement(
     const float marginRow,
     const float marginColumn,
     const YGConfigRef config) {
-  if ((!YGFloatIsUndefined(lastComputedHeight) && lastComputedHeight < 0) ||
-      (!YGFloatIsUndefined(lastComputedWidth) && lastComputedWidth < 0)) {
+  const float pointScaleFactor =
+      config != nullptr ? config->pointScaleFactor : 0;
+  YGCachedMeasurement entry;
+  entry.availableWidth = lastWidth;
+  entry.availableHeight = lastHeight;
+  entry.widthMeasureMode = lastWidthMode;
+  entry.heightMeasureMode = lastHeightMode;
+  entry.computedWidth = lastComputedWidth;
+  entry.computedHeight = lastComputedHeight;
+  return YGCanUseCachedMeasurement(
+      YGMeasurementQuery{widthMode,
+                         width,
+                         heightMode,
+                         height,
+                         marginRow,
+                         marginColumn,
+                         pointScaleFactor},
+      entry,
+      YGMeasurementCache::effectiveSize(lastWidth, pointScaleFactor),
+      YGMeasurementCache::effectiveSize(lastHeight, pointScaleFactor));
+}
+
+// Looks up a cached result of a node with a measure function, which can be used
+// for the given constraints.
+static YGCachedMeasurement* YGNodeFindCachedMeasurement(
+    const YGNodeRef node,
+    const float availableWidth,
+    const float availableHeight,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const YGConfigRef config) {
+  YGLayout* layout = &node->getLayout();
+  const float marginAxisRow =
+      node->getMarginForAxis(YGFlexDirectionRow, ownerWidth).unwrap();
+  const float marginAxisColumn =
+      node->getMarginForAxis(YGFlexDirectionColumn, ownerWidth).unwrap();
+
+  // The requested sizes are only rounded once, instead of once per entry.
+  const float pointScaleFactor = config->pointScaleFactor;
+  const YGMeasurementQuery query{widthMeasureMode,
+                                 availableWidth,
+                                 heightMeasureMode,
+                                 availableHeight,
+                                 marginAxisRow,
+                                 marginAxisColumn,
+                                 pointScaleFactor};
+
+  // First, try to use the layout cache.
+  const YGCachedMeasurement& cachedLayout = layout->cachedLayout;
+  if (YGCanUseCachedMeasurement(
+          query,
+          cachedLayout,
+          YGMeasurementCache::effectiveSize(
+              cachedLayout.availableWidth, pointScaleFactor),
+          YGMeasurementCache::effectiveSize(
+              cachedLayout.availableHeight, pointScaleFactor))) {
+    return &layout->cachedLayout;
+  }
+
+  // Try to use the measurement cache, whose entries keep their sizes rounded.
+  YGMeasurementCache& cache = layout->cachedMeasurements;
+  cache.setPointScaleFactor(pointScaleFactor);
+  for (size_t i = 0; i < cache.size(); i++) {
+    if (YGCanUseCachedMeasurement(
+            query,
+            cache[i],
+            cache.effectiveWidth(i),
+            cache.effectiveHeight(i))) {
+      return &cache[i];
+    }
+  }
+  return nullptr;
+}
+
+// Structural hash of a subtree, combining the styles, node types, measure
+// content keys and shapes of all its nodes. Subtrees with equal hashes lay out
+// the same for the same constraints, except for subtrees of nodes whose layout
+// depends on more than that, for which the hash is 0: nodes with measure
+// functions but no content key, nodes with baseline functions, and nodes of
+// another config. Hashes are cached on nodes, see YGNode::hasSubtreeHash.
+static uint64_t YGNodeSubtreeHash(
+    const YGNodeRef node,
+    const YGConfigRef config) {
+  if (node->hasSubtreeHash()) {
+    return node->getSubtreeHash();
+  }
+  YGHasher hasher;
+  YGHashStyle(hasher, node->getStyle());
+  hasher.add(node->getNodeType());
+  hasher.add(node->hasMeasureFunc());
+  hasher.add(node->getMeasureContentKey());
+  hasher.add(node->isReferenceBaseline());
+  hasher.add(static_cast<uint32_t>(node->getChildren().size()));
+  // Virtualized containers depend on the sizes their children were last laid
+  // out with, which are not part of the hash.
+  bool isMemoizable = node->getConfig() == config &&
+      !node->hasBaselineFunc() && node->getVirtualizedWindow() == nullptr &&
+      (!node->hasMeasureFunc() || node->getMeasureContentKey() != 0);
+  uint32_t size = 1;
+  for (const YGNodeRef child : node->getChildren()) {
+    const uint64_t childHash = YGNodeSubtreeHash(child, config);
+    isMemoizable = isMemoizable && childHash != 0;
+    hasher.add(childHash);
+    size += child->getSubtreeSize();
+  }
+  const uint64_t hash = !isMemoizable ? 0 : hasher.hash != 0 ? hasher.hash : 1;
+  node->setSubtreeHash(hash, size);
+  return hash;
+}
+
+static void YGNodeRecordLayout(
+    const YGNodeRef node,
+    const bool recordDescendants,
+    YGMemoizedLayouts& layouts) {
+  const YGLayout& layout = node->getLayout();
+  YGMemoizedNodeLayout record;
+  record.frame = layout.unroundedFrame;
+  record.trailingPosition = {
+      {layout.position[YGEdgeRight], layout.position[YGEdgeBottom]}};
+  record.measuredDimensions = layout.measuredDimensions;
+  record.margin = layout.margin;
+  record.border = layout.border;
+  record.padding = layout.padding;
+  record.cachedLayout = layout.cachedLayout;
+  record.computedFlexBasis = layout.computedFlexBasis;
+  record.direction = layout.direction;
+  record.lastOwnerDirection = layout.lastOwnerDirection;
+  record.childCount = YGNodeGetChildCount(node);
+  record.hadOverflow = layout.hadOverflow;
+  record.didUseLegacyFlag = layout.didUseLegacyFlag;
+  record.doesLegacyStretchFlagAffectsLayout =
+      layout.doesLegacyStretchFlagAffectsLayout;
+  layouts.nodes.push_back(record);
+
+  if (recordDescendants) {
+    for (const YGNodeRef child : node->getChildren()) {
+      YGNodeRecordLayout(child, true, layouts);
+    }
+  }
+}
+
+// Sets the frame and caches of a descendant of a memoized subtree to what
+// laying it out would.
+static void YGNodeApplyMemoizedFrame(
+    const YGNodeRef node,
+    const YGMemoizedNodeLayout& record,
+    YGLayoutPass& layoutPass) {
+  YGLayout& layout = node->getLayout();
+  node->setLayoutPosition(record.frame[YGEdgeLeft], YGEdgeLeft);
+  node->setLayoutPosition(record.frame[YGEdgeTop], YGEdgeTop);
+  node->setLayoutPosition(record.trailingPosition[0], YGEdgeRight);
+  node->setLayoutPosition(record.trailingPosition[1], YGEdgeBottom);
+  node->setLayoutDimension(
+      record.frame[2 + YGDimensionWidth], YGDimensionWidth);
+  node->setLayoutDimension(
+      record.frame[2 + YGDimensionHeight], YGDimensionHeight);
+  layout.cachedMeasurements.clear();
+  layout.cachedLayout = record.cachedLayout;
+  layout.lastOwnerDirection = record.lastOwnerDirection;
+  layout.computedFlexBasis = record.computedFlexBasis;
+  layout.computedFlexBasisGeneration = layoutPass.generationCount;
+  layout.generationCount = layoutPass.generationCount;
+  node->setHasNewLayout(true);
+  node->setDirty(false);
+  if (layoutPass.laidOutNodes != nullptr) {
+    layoutPass.laidOutNodes->push_back(node);
+  }
+}
+
+// Copies memoized results into a node, and into its descendants if
+// `includeDescendants` is set, starting with the record at `index`. The
+// position of the subtree root is set by its owner, as for any other layout,
+// while its descendants end up as if they were laid out in this pass.
+static void YGNodeApplyMemoizedLayout(
+    const YGNodeRef node,
+    const YGMemoizedLayouts& layouts,
+    size_t& index,
+    const bool isRoot,
+    const bool includeDescendants,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  const YGMemoizedNodeLayout& record = layouts.nodes[index++];
+  YGLayout& layout = node->getLayout();
+  layout.measuredDimensions = record.measuredDimensions;
+  layout.margin = record.margin;
+  layout.border = record.border;
+  layout.padding = record.padding;
+  layout.direction = record.direction;
+  layout.hadOverflow = record.hadOverflow;
+  layout.didUseLegacyFlag = record.didUseLegacyFlag;
+  layout.doesLegacyStretchFlagAffectsLayout =
+      record.doesLegacyStretchFlagAffectsLayout;
+  if (!isRoot) {
+    YGNodeApplyMemoizedFrame(node, record, layoutPass);
+  }
+
+  if (includeDescendants) {
+    node->clearStackLayoutState();
+    // Children shared with other trees are cloned before being written to, as
+    // in YGNodelayoutImpl.
+    node->cloneChildrenIfNeeded(layoutContext, layoutPass.cloneNode);
+    for (const YGNodeRef child : node->getChildren()) {
+      YGNodeApplyMemoizedLayout(
+          child, layouts, index, false, true, layoutContext, layoutPass);
+    }
+  }
+}
+
+// Whether a node, and its descendants if `includeDescendants` is set, have as
+// many children as the records starting at `index`.
+static bool YGNodeMatchesMemoizedChildCounts(
+    const YGNodeRef node,
+    const YGMemoizedLayouts& layouts,
+    size_t& index,
+    const bool includeDescendants) {
+  if (layouts.nodes[index++].childCount != YGNodeGetChildCount(node)) {
+    return false;
+  }
+  if (includeDescendants) {
+    for (const YGNodeRef child : node->getChildren()) {
+      if (!YGNodeMatchesMemoizedChildCounts(child, layouts, index, true)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Looks up the memoized layout of a subtree, and copies it into the subtree if
+// found. Otherwise returns false, and sets `key` to the key to memoize the
+// layout with, or leaves `memo` null if the subtree cannot be memoized.
+static bool YGNodeLayoutFromMemo(
+    const YGNodeRef node,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection ownerDirection,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const float ownerHeight,
+    const bool performLayout,
+    const YGConfigRef config,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass,
+    YGLayoutMemo*& memo,
+    YGLayoutMemo::Key& key) {
+  memo = nullptr;
+  // Leaves are cheap to lay out, and measured ones are memoized by the
+  // measure memo.
+  YGLayoutMemo* const layoutMemo = config->layoutMemo.get();
+  if (layoutMemo == nullptr || node->getChildren().empty()) {
+    return false;
+  }
+  const uint64_t subtreeHash = YGNodeSubtreeHash(node, config);
+  if (subtreeHash == 0 ||
+      node->getSubtreeSize() > kYGLayoutMemoMaxSubtreeSize) {
     return false;
   }
-  bool useRoundedComparison =
-      config != nullptr && config->pointScaleFactor != 0;
-  const float effectiveWidth = useRoundedComparison
-      ? YGRoundValueToPixelGrid(width, config->pointScaleFactor, false, false)
-      : width;
-  const float effectiveHeight = useRoundedComparison
-      ? YGRoundValueToPixelGrid(height, config->pointScaleFactor, false, false)
-      : height;
-  const float effectiveLastWidth = useRoundedComparison
-      ? YGRoundValueToPixelGrid(
-            lastWidth, config->pointScaleFactor, false, false)
-      : lastWidth;
-  const float effectiveLastHeight = useRoundedComparison
-      ? YGRoundValueToPixelGrid(
-            lastHeight, config->pointScaleFactor, false, false)
-      : lastHeight;
-
-  const bool hasSameWidthSpec = lastWidthMode == widthMode &&
-      YGFloatsEqual(effectiveLastWidth, effectiveWidth);
-  const bool hasSameHeightSpec = lastHeightMode == heightMode &&
-      YGFloatsEqual(effectiveLastHeight, effectiveHeight);
 
-  const bool widthIsCompatible =
-      hasSameWidthSpec ||
-      YGMeasureModeSizeIsExactAndMatchesOldMeasuredSize(
-          widthMode, width - marginRow, lastComputedWidth) ||
-      YGMeasureModeOldSizeIsUnspecifiedAndStillFits(
-          widthMode, width - marginRow, lastWidthMode, lastComputedWidth) ||
-      YGMeasureModeNewMeasureSizeIsStricterAndStillValid(
-          widthMode,
-          width - marginRow,
-          lastWidthMode,
-          lastWidth,
-          lastComputedWidth);
+  YGHasher hasher;
+  hasher.add(subtreeHash);
+  YGHashLayoutConfig(hasher, *config);
+  key = {hasher.hash,
+         availableWidth,
+         availableHeight,
+         widthMeasureMode,
+         heightMeasureMode,
+         ownerWidth,
+         ownerHeight,
+         ownerDirection,
+         performLayout};
+  memo = layoutMemo;
+  std::shared_ptr<const YGMemoizedLayouts> layouts;
+  if (!memo->get(key, &layouts) ||
+      layouts->nodes.size() != (performLayout ? node->getSubtreeSize() : 1)) {
+    return false;
+  }
+  // Different subtrees with the same hash must not get each other's results.
+  // Collisions are caught if the subtrees differ in shape or in the style of
+  // their root. Ones differing only in descendant styles, node types or
+  // content keys are not, which the 64-bit hash makes unlikely enough.
+  size_t index = 0;
+  if (!(layouts->rootStyle.isSharedWith(node->getSharedStyle()) ||
+        layouts->rootStyle.get() == node->getStyle()) ||
+      !YGNodeMatchesMemoizedChildCounts(node, *layouts, index, performLayout)) {
+    return false;
+  }
 
-  const bool heightIsCompatible =
-      hasSameHeightSpec ||
-      YGMeasureModeSizeIsExactAndMatchesOldMeasuredSize(
-          heightMode, height - marginColumn, lastComputedHeight) ||
-      YGMeasureModeOldSizeIsUnspecifiedAndStillFits(
-          heightMode,
-          height - marginColumn,
-          lastHeightMode,
-          lastComputedHeight) ||
-      YGMeasureModeNewMeasureSizeIsStricterAndStillValid(
-          heightMode,
-          height - marginColumn,
-          lastHeightMode,
-          lastHeight,
-          lastComputedHeight);
+  index = 0;
+  YGNodeApplyMemoizedLayout(
+      node, *layouts, index, true, performLayout, layoutContext, layoutPass);
+  return true;
+}
 
-  return widthIsCompatible && heightIsCompatible;
+// Aborts a time-sliced layout pass once its deadline has passed, but only
+// after it made the progress required of it.
+static bool YGLayoutPassIsOutOfTime(YGLayoutPass& layoutPass) {
+  if (!layoutPass.isAborted &&
+      layoutPass.completedLayouts >= layoutPass.minCompletedLayouts &&
+      std::chrono::steady_clock::now() >= layoutPass.deadline) {
+    layoutPass.isAborted = true;
+  }
+  return layoutPass.isAborted;
 }
 
 //
@@ -3698,18 +5384,23 @@ bool YGLayoutNodeInternal(
     const char* reason,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
-    void* const layoutContext) {
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  if (layoutPass.hasDeadline && YGLayoutPassIsOutOfTime(layoutPass)) {
+    return true;
+  }
   YGLayout* layout = &node->getLayout();
 
-  gDepth++;
+  layoutPass.depth++;
 
   const bool needToVisitNode =
-      (node->isDirty() && layout->generationCount != gCurrentGenerationCount) ||
+      (node->isDirty() &&
+       layout->generationCount != layoutPass.generationCount) ||
       layout->lastOwnerDirection != ownerDirection;
 
   if (needToVisitNode) {
     // Invalidate the cached results.
-    layout->nextCachedMeasurementsIndex = 0;
+    layout->cachedMeasurements.clear();
     layout->cachedLayout.widthMeasureMode = (YGMeasureMode) -1;
     layout->cachedLayout.heightMeasureMode = (YGMeasureMode) -1;
     layout->cachedLayout.computedWidth = -1;
@@ -3727,49 +5418,14 @@ bool YGLayoutNodeInternal(
   // they are the most expensive to measure, so it's worth avoiding redundant
   // measurements if at all possible.
   if (node->hasMeasureFunc()) {
-    const float marginAxisRow =
-        node->getMarginForAxis(YGFlexDirectionRow, ownerWidth).unwrap();
-    const float marginAxisColumn =
-        node->getMarginForAxis(YGFlexDirectionColumn, ownerWidth).unwrap();
-
-    // First, try to use the layout cache.
-    if (YGNodeCanUseCachedMeasurement(
-            widthMeasureMode,
-            availableWidth,
-            heightMeasureMode,
-            availableHeight,
-            layout->cachedLayout.widthMeasureMode,
-            layout->cachedLayout.availableWidth,
-            layout->cachedLayout.heightMeasureMode,
-            layout->cachedLayout.availableHeight,
-            layout->cachedLayout.computedWidth,
-            layout->cachedLayout.computedHeight,
-            marginAxisRow,
-            marginAxisColumn,
-            config)) {
-      cachedResults = &layout->cachedLayout;
-    } else {
-      // Try to use the measurement cache.
-      for (uint32_t i = 0; i < layout->nextCachedMeasurementsIndex; i++) {
-        if (YGNodeCanUseCachedMeasurement(
-                widthMeasureMode,
-                availableWidth,
-                heightMeasureMode,
-                availableHeight,
-                layout->cachedMeasurements[i].widthMeasureMode,
-                layout->cachedMeasurements[i].availableWidth,
-                layout->cachedMeasurements[i].heightMeasureMode,
-                layout->cachedMeasurements[i].availableHeight,
-                layout->cachedMeasurements[i].computedWidth,
-                layout->cachedMeasurements[i].computedHeight,
-                marginAxisRow,
-                marginAxisColumn,
-                config)) {
-          cachedResults = &layout->cachedMeasurements[i];
-          break;
-        }
-      }
-    }
+    cachedResults = YGNodeFindCachedMeasurement(
+        node,
+        availableWidth,
+        availableHeight,
+        widthMeasureMode,
+        heightMeasureMode,
+        ownerWidth,
+        config);
   } else if (performLayout) {
     if (YGFloatsEqual(layout->cachedLayout.availableWidth, availableWidth) &&
         YGFloatsEqual(layout->cachedLayout.availableHeight, availableHeight) &&
@@ -3778,7 +5434,7 @@ bool YGLayoutNodeInternal(
       cachedResults = &layout->cachedLayout;
     }
   } else {
-    for (uint32_t i = 0; i < layout->nextCachedMeasurementsIndex; i++) {
+    for (size_t i = 0; i < layout->cachedMeasurements.size(); i++) {
       if (YGFloatsEqual(
               layout->cachedMeasurements[i].availableWidth, availableWidth) &&
           YGFloatsEqual(
@@ -3799,15 +5455,18 @@ bool YGLayoutNodeInternal(
 
     (performLayout ? layoutMarkerData.cachedLayouts
                    : layoutMarkerData.cachedMeasures) += 1;
+    if (cachedResults != &layout->cachedLayout) {
+      layout->cachedMeasurements.markUsed(*cachedResults);
+    }
 
-    if (gPrintChanges && gPrintSkips) {
+    if (layoutPass.printChanges && layoutPass.printSkips) {
       Log::log(
           node,
           YGLogLevelVerbose,
           nullptr,
           "%s%d.{[skipped] ",
-          YGSpacer(gDepth),
-          gDepth);
+          YGSpacer(layoutPass.depth),
+          layoutPass.depth);
       node->print(layoutContext);
       Log::log(
           node,
@@ -3823,14 +5482,14 @@ bool YGLayoutNodeInternal(
           reason);
     }
   } else {
-    if (gPrintChanges) {
+    if (layoutPass.printChanges) {
       Log::log(
           node,
           YGLogLevelVerbose,
           nullptr,
           "%s%d.{%s",
-          YGSpacer(gDepth),
-          gDepth,
+          YGSpacer(layoutPass.depth),
+          layoutPass.depth,
           needToVisitNode ? "*" : "");
       node->print(layoutContext);
       Log::log(
@@ -3845,28 +5504,72 @@ bool YGLayoutNodeInternal(
           reason);
     }
 
-    YGNodelayoutImpl(
-        node,
-        availableWidth,
-        availableHeight,
-        ownerDirection,
-        widthMeasureMode,
-        heightMeasureMode,
-        ownerWidth,
-        ownerHeight,
-        performLayout,
-        config,
-        layoutMarkerData,
-        layoutContext);
+    YGLayoutMemo* memo;
+    YGLayoutMemo::Key memoKey;
+    if (YGNodeLayoutFromMemo(
+            node,
+            availableWidth,
+            availableHeight,
+            ownerDirection,
+            widthMeasureMode,
+            heightMeasureMode,
+            ownerWidth,
+            ownerHeight,
+            performLayout,
+            config,
+            layoutContext,
+            layoutPass,
+            memo,
+            memoKey)) {
+      layoutMarkerData.memoizedLayouts += 1;
+    } else {
+      YGNodelayoutImpl(
+          node,
+          availableWidth,
+          availableHeight,
+          ownerDirection,
+          widthMeasureMode,
+          heightMeasureMode,
+          ownerWidth,
+          ownerHeight,
+          performLayout,
+          config,
+          layoutMarkerData,
+          layoutContext,
+          layoutPass);
+      if (memo != nullptr && !layoutPass.isAborted) {
+        auto layouts = std::make_shared<YGMemoizedLayouts>();
+        layouts->rootStyle = node->getSharedStyle();
+        layouts->nodes.reserve(performLayout ? node->getSubtreeSize() : 1);
+        YGNodeRecordLayout(node, performLayout, *layouts);
+        memo->put(memoKey, std::move(layouts));
+      }
+    }
+
+    if (layoutPass.isAborted) {
+      // Children of an interrupted layout may hold some of its results, so the
+      // previous layout of the node is not valid anymore. Interrupted
+      // measurements leave nothing behind that a measurement could not.
+      if (performLayout) {
+        layout->cachedLayout.widthMeasureMode = (YGMeasureMode) -1;
+        layout->cachedLayout.heightMeasureMode = (YGMeasureMode) -1;
+        node->clearStackLayoutState();
+      }
+      layout->lastOwnerDirection = ownerDirection;
+      layout->generationCount = layoutPass.generationCount;
+      layoutPass.depth--;
+      return true;
+    }
+    layoutPass.completedLayouts += 1;
 
-    if (gPrintChanges) {
+    if (layoutPass.printChanges) {
       Log::log(
           node,
           YGLogLevelVerbose,
           nullptr,
           "%s%d.}%s",
-          YGSpacer(gDepth),
-          gDepth,
+          YGSpacer(layoutPass.depth),
+          layoutPass.depth,
           needToVisitNode ? "*" : "");
       node->print(layoutContext);
       Log::log(
@@ -3884,37 +5587,43 @@ bool YGLayoutNodeInternal(
     layout->lastOwnerDirection = ownerDirection;
 
     if (cachedResults == nullptr) {
-      if (layout->nextCachedMeasurementsIndex + 1 >
+      const size_t cachedMeasurementCount = layout->cachedMeasurements.size();
+      if (cachedMeasurementCount + 1 >
           (uint32_t) layoutMarkerData.maxMeasureCache) {
-        layoutMarkerData.maxMeasureCache =
-            layout->nextCachedMeasurementsIndex + 1;
-      }
-      if (layout->nextCachedMeasurementsIndex == usedMeasureCacheEntries) {
-        if (gPrintChanges) {
-          Log::log(node, YGLogLevelVerbose, nullptr, "Out of cache entries!\n");
-        }
-        layout->nextCachedMeasurementsIndex = 0;
+        layoutMarkerData.maxMeasureCache = cachedMeasurementCount + 1;
       }
 
-      YGCachedMeasurement* newCacheEntry;
+      YGCachedMeasurement newCacheEntry;
+      newCacheEntry.availableWidth = availableWidth;
+      newCacheEntry.availableHeight = availableHeight;
+      newCacheEntry.widthMeasureMode = widthMeasureMode;
+      newCacheEntry.heightMeasureMode = heightMeasureMode;
+      newCacheEntry.computedWidth =
+          layout->measuredDimensions[YGDimensionWidth];
+      newCacheEntry.computedHeight =
+          layout->measuredDimensions[YGDimensionHeight];
+
       if (performLayout) {
         // Use the single layout cache entry.
-        newCacheEntry = &layout->cachedLayout;
+        layout->cachedLayout = newCacheEntry;
       } else {
-        // Allocate a new measurement cache entry.
-        newCacheEntry =
-            &layout->cachedMeasurements[layout->nextCachedMeasurementsIndex];
-        layout->nextCachedMeasurementsIndex++;
+        // Record a new measurement cache entry.
+        bool evicted;
+        layout->cachedMeasurements.add(
+            newCacheEntry,
+            {layoutPass.usedMeasureCacheEntries,
+             layoutPass.maxMeasureCacheEntries},
+            config->pointScaleFactor,
+            &evicted);
+        layoutMarkerData.measureCacheMisses += 1;
+        if (evicted) {
+          layoutMarkerData.measureCacheEvictions += 1;
+          if (layoutPass.printChanges) {
+            Log::log(
+                node, YGLogLevelVerbose, nullptr, "Out of cache entries!\n");
+          }
+        }
       }
-
-      newCacheEntry->availableWidth = availableWidth;
-      newCacheEntry->availableHeight = availableHeight;
-      newCacheEntry->widthMeasureMode = widthMeasureMode;
-      newCacheEntry->heightMeasureMode = heightMeasureMode;
-      newCacheEntry->computedWidth =
-          layout->measuredDimensions[YGDimensionWidth];
-      newCacheEntry->computedHeight =
-          layout->measuredDimensions[YGDimensionHeight];
     }
   }
 
@@ -3928,10 +5637,13 @@ bool YGLayoutNodeInternal(
 
     node->setHasNewLayout(true);
     node->setDirty(false);
+    if (layoutPass.laidOutNodes != nullptr) {
+      layoutPass.laidOutNodes->push_back(node);
+    }
   }
 
-  gDepth--;
-  layout->generationCount = gCurrentGenerationCount;
+  layoutPass.depth--;
+  layout->generationCount = layoutPass.generationCount;
   return (needToVisitNode || cachedResults == nullptr);
 }
 
@@ -3952,91 +5664,113 @@ void YGConfigSetPointScaleFactor(
   }
 }
 
-static void YGRoundToPixelGrid(
+static void YGReportLayoutChange(
+    const YGNodeRef node,
+    const YGLayoutChangedFunc layoutChanged,
+    void* const layoutContext) {
+  const int changes = node->updateReportedFrame();
+  if (changes != 0) {
+    layoutChanged(node, static_cast<YGLayoutChange>(changes), layoutContext);
+  }
+}
+
+// Collects the frames of the subtree which need to be rounded to the pixel
+// grid.
+static void YGCollectPixelGridFrames(
     const YGNodeRef node,
     const float pointScaleFactor,
     const float absoluteLeft,
-    const float absoluteTop) {
-  if (pointScaleFactor == 0.0f) {
+    const float absoluteTop,
+    YGPixelGridFrames& frames) {
+  // Rounding always starts from the frame computed by layout, so rounding a
+  // frame again is exact.
+  YGLayout& layout = node->getLayout();
+  const float absoluteNodeLeft =
+      absoluteLeft + layout.unroundedFrame[YGEdgeLeft];
+  const float absoluteNodeTop = absoluteTop + layout.unroundedFrame[YGEdgeTop];
+
+  // Frames only change for nodes which were laid out, and all their ancestors
+  // were laid out as well. So unless its absolute position changed, the whole
+  // subtree of a node whose frame did not change is rounded already.
+  if (!layout.needsRounding &&
+      absoluteNodeLeft == layout.roundedAbsolutePosition[0] &&
+      absoluteNodeTop == layout.roundedAbsolutePosition[1] &&
+      pointScaleFactor == layout.roundedPointScaleFactor) {
     return;
   }
-
-  const float nodeLeft = node->getLayout().position[YGEdgeLeft];
-  const float nodeTop = node->getLayout().position[YGEdgeTop];
-
-  const float nodeWidth = node->getLayout().dimensions[YGDimensionWidth];
-  const float nodeHeight = node->getLayout().dimensions[YGDimensionHeight];
-
-  const float absoluteNodeLeft = absoluteLeft + nodeLeft;
-  const float absoluteNodeTop = absoluteTop + nodeTop;
-
-  const float absoluteNodeRight = absoluteNodeLeft + nodeWidth;
-  const float absoluteNodeBottom = absoluteNodeTop + nodeHeight;
-
+  layout.needsRounding = false;
+  layout.roundedAbsolutePosition = {{absoluteNodeLeft, absoluteNodeTop}};
+  layout.roundedPointScaleFactor = pointScaleFactor;
   // If a node has a custom measure function we never want to round down its
   // size as this could lead to unwanted text truncation.
-  const bool textRounding = node->getNodeType() == YGNodeTypeText;
-
-  node->setLayoutPosition(
-      YGRoundValueToPixelGrid(nodeLeft, pointScaleFactor, false, textRounding),
-      YGEdgeLeft);
-
-  node->setLayoutPosition(
-      YGRoundValueToPixelGrid(nodeTop, pointScaleFactor, false, textRounding),
-      YGEdgeTop);
-
-  // We multiply dimension by scale factor and if the result is close to the
-  // whole number, we don't have any fraction To verify if the result is close
-  // to whole number we want to check both floor and ceil numbers
-  const bool hasFractionalWidth =
-      !YGFloatsEqual(fmodf(nodeWidth * pointScaleFactor, 1.0), 0) &&
-      !YGFloatsEqual(fmodf(nodeWidth * pointScaleFactor, 1.0), 1.0);
-  const bool hasFractionalHeight =
-      !YGFloatsEqual(fmodf(nodeHeight * pointScaleFactor, 1.0), 0) &&
-      !YGFloatsEqual(fmodf(nodeHeight * pointScaleFactor, 1.0), 1.0);
-
-  node->setLayoutDimension(
-      YGRoundValueToPixelGrid(
-          absoluteNodeRight,
-          pointScaleFactor,
-          (textRounding && hasFractionalWidth),
-          (textRounding && !hasFractionalWidth)) -
-          YGRoundValueToPixelGrid(
-              absoluteNodeLeft, pointScaleFactor, false, textRounding),
-      YGDimensionWidth);
+  frames.add(
+      node,
+      layout.unroundedFrame,
+      absoluteNodeLeft,
+      absoluteNodeTop,
+      node->getNodeType() == YGNodeTypeText);
+
+  for (const YGNodeRef child : node->getChildren()) {
+    YGCollectPixelGridFrames(
+        child, pointScaleFactor, absoluteNodeLeft, absoluteNodeTop, frames);
+  }
+}
 
-  node->setLayoutDimension(
-      YGRoundValueToPixelGrid(
-          absoluteNodeBottom,
-          pointScaleFactor,
-          (textRounding && hasFractionalHeight),
-          (textRounding && !hasFractionalHeight)) -
-          YGRoundValueToPixelGrid(
-              absoluteNodeTop, pointScaleFactor, false, textRounding),
-      YGDimensionHeight);
+// Rounds the layout of the subtree to the pixel grid. If layoutChanged is set,
+// it is called for every node whose rounded frame changed.
+static void YGRoundToPixelGrid(
+    const YGNodeRef node,
+    const float pointScaleFactor,
+    const float absoluteLeft,
+    const float absoluteTop,
+    const YGLayoutChangedFunc layoutChanged,
+    void* const layoutContext) {
+  if (pointScaleFactor == 0.0f) {
+    return;
+  }
 
-  const uint32_t childCount = YGNodeGetChildCount(node);
-  for (uint32_t i = 0; i < childCount; i++) {
-    YGRoundToPixelGrid(
-        YGNodeGetChild(node, i),
-        pointScaleFactor,
-        absoluteNodeLeft,
-        absoluteNodeTop);
+  // The frames are kept across passes on each thread, so their arrays are only
+  // allocated while they grow. They are taken for the duration of the pass, as
+  // layoutChanged may lay out another tree, which then gets frames of its own.
+  static thread_local YGPixelGridFrames reusableFrames;
+  YGPixelGridFrames frames = std::move(reusableFrames);
+  frames.clear();
+  YGCollectPixelGridFrames(
+      node, pointScaleFactor, absoluteLeft, absoluteTop, frames);
+  YGRoundFramesToPixelGrid(frames, pointScaleFactor);
+
+  for (size_t i = 0; i < frames.nodes.size(); i++) {
+    // The rounded frame is written directly, as the setters would record it
+    // as a new unrounded frame.
+    YGLayout& layout = frames.nodes[i]->getLayout();
+    layout.position[YGEdgeLeft] = frames.left[i];
+    layout.position[YGEdgeTop] = frames.top[i];
+    layout.dimensions[YGDimensionWidth] = frames.width[i];
+    layout.dimensions[YGDimensionHeight] = frames.height[i];
+  }
+  if (layoutChanged != nullptr) {
+    for (const YGNodeRef changedNode : frames.nodes) {
+      YGReportLayoutChange(changedNode, layoutChanged, layoutContext);
+    }
   }
 }
 
-void YGNodeCalculateLayoutWithContext(
+static void YGNodeCalculateLayoutImpl(
     const YGNodeRef node,
     const float ownerWidth,
     const float ownerHeight,
     const YGDirection ownerDirection,
-    void* layoutContext) {
-  marker::MarkerSection<YGMarkerLayout> marker{node};
-
-  // Increment the generation count. This will force the recursive routine to
-  // visit all dirty nodes at least once. Subsequent visits will be skipped if
-  // the input parameters don't change.
-  gCurrentGenerationCount++;
+    YGMarkerLayoutData& layoutMarkerData,
+    void* const layoutContext,
+    YGLayoutPass& layoutPass) {
+  const YGLayoutChangedFunc layoutChanged = node->getConfig()->layoutChanged;
+  const float pointScaleFactor = node->getConfig()->pointScaleFactor;
+  // Without rounding there is no walk over the whole tree after layout, so
+  // only nodes that were laid out are checked for changes.
+  std::vector<YGNodeRef> laidOutNodes;
+  if (layoutChanged != nullptr && pointScaleFactor == 0.0f) {
+    layoutPass.laidOutNodes = &laidOutNodes;
+  }
   node->resolveDimension();
   float width = YGUndefined;
   YGMeasureMode widthMeasureMode = YGMeasureModeUndefined;
@@ -4094,11 +5828,14 @@ void YGNodeCalculateLayoutWithContext(
           true,
           "initial",
           node->getConfig(),
-          marker.data,
-          layoutContext)) {
+          layoutMarkerData,
+          layoutContext,
+          layoutPass) &&
+      !layoutPass.isAborted) {
     node->setPosition(
         node->getLayout().direction, ownerWidth, ownerHeight, ownerWidth);
-    YGRoundToPixelGrid(node, node->getConfig()->pointScaleFactor, 0.0f, 0.0f);
+    YGRoundToPixelGrid(
+        node, pointScaleFactor, 0.0f, 0.0f, layoutChanged, layoutContext);
 
 #ifdef DEBUG
     if (node->getConfig()->printTree) {
@@ -4110,6 +5847,9 @@ void YGNodeCalculateLayoutWithContext(
     }
 #endif
   }
+  for (const YGNodeRef laidOutNode : laidOutNodes) {
+    YGReportLayoutChange(laidOutNode, layoutChanged, layoutContext);
+  }
 
   // We want to get rid off `useLegacyStretchBehaviour` from YGConfig. But we
   // aren't sure whether client's of yoga have gotten rid off this flag or not.
@@ -4119,15 +5859,15 @@ void YGNodeCalculateLayoutWithContext(
   // `shouldDiffLayoutWithoutLegacyStretchBehaviour` in YGConfig will help to
   // run experiments.
   if (node->getConfig()->shouldDiffLayoutWithoutLegacyStretchBehaviour &&
-      node->didUseLegacyFlag()) {
+      node->didUseLegacyFlag() && !layoutPass.isAborted) {
     const YGNodeRef originalNode = YGNodeDeepClone(node);
     originalNode->resolveDimension();
     // Recursively mark nodes as dirty
     originalNode->markDirtyAndPropogateDownwards();
-    gCurrentGenerationCount++;
     // Rerun the layout, and calculate the diff
     originalNode->setAndPropogateUseLegacyFlag(false);
-    YGMarkerLayoutData layoutMarkerData;
+    YGMarkerLayoutData diffLayoutMarkerData;
+    YGLayoutPass diffLayoutPass{originalNode->getConfig()};
     if (YGLayoutNodeInternal(
             originalNode,
             width,
@@ -4140,8 +5880,9 @@ void YGNodeCalculateLayoutWithContext(
             true,
             "initial",
             originalNode->getConfig(),
-            layoutMarkerData,
-            layoutContext)) {
+            diffLayoutMarkerData,
+            layoutContext,
+            diffLayoutPass)) {
       originalNode->setPosition(
           originalNode->getLayout().direction,
           ownerWidth,
@@ -4151,7 +5892,9 @@ void YGNodeCalculateLayoutWithContext(
           originalNode,
           originalNode->getConfig()->pointScaleFactor,
           0.0f,
-          0.0f);
+          0.0f,
+          nullptr,
+          nullptr);
 
       // Set whether the two layouts are different or not.
       auto neededLegacyStretchBehaviour =
@@ -4173,6 +5916,105 @@ void YGNodeCalculateLayoutWithContext(
   }
 }
 
+void YGNodeCalculateLayoutWithContext(
+    const YGNodeRef node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection ownerDirection,
+    void* layoutContext) {
+  marker::MarkerSection<YGMarkerLayout> marker{node};
+
+  // Each pass gets a new generation count. This will force the recursive
+  // routine to visit all dirty nodes at least once. Subsequent visits will be
+  // skipped if the input parameters don't change.
+  YGLayoutPass layoutPass{node->getConfig()};
+  YGNodeCalculateLayoutImpl(
+      node,
+      ownerWidth,
+      ownerHeight,
+      ownerDirection,
+      marker.data,
+      layoutContext,
+      layoutPass);
+}
+
+struct YGBatchLayoutTasks {
+  const YGNodeRef* roots;
+  const YGLayoutConstraints* constraints;
+  std::vector<YGMarkerLayoutData> layoutMarkerData;
+  uint32_t generationCount;
+  bool isExecutorTask;
+  void* layoutContext;
+};
+
+static void YGRunBatchLayoutTask(void* tasks, uint32_t taskIndex) {
+  auto batchTasks = static_cast<YGBatchLayoutTasks*>(tasks);
+  const YGNodeRef root = batchTasks->roots[taskIndex];
+  const YGLayoutConstraints& constraints = batchTasks->constraints[taskIndex];
+  YGLayoutPass layoutPass{root->getConfig(), batchTasks->generationCount};
+  layoutPass.isExecutorTask = batchTasks->isExecutorTask;
+  YGNodeCalculateLayoutImpl(
+      root,
+      constraints.ownerWidth,
+      constraints.ownerHeight,
+      constraints.ownerDirection,
+      batchTasks->layoutMarkerData[taskIndex],
+      batchTasks->layoutContext,
+      layoutPass);
+}
+
+void YGNodeCalculateLayoutBatchWithContext(
+    const YGNodeRef roots[],
+    const YGLayoutConstraints constraints[],
+    const uint32_t count,
+    YGMarkerLayoutData layoutData[],
+    void* layoutContext) {
+  if (count == 0) {
+    return;
+  }
+  marker::MarkerSection<YGMarkerLayout> marker{roots[0]};
+
+  // The roots are disjoint, so they can all share one generation.
+  YGBatchLayoutTasks tasks;
+  tasks.roots = roots;
+  tasks.constraints = constraints;
+  tasks.layoutMarkerData.assign(count, YGMarkerLayoutData{});
+  tasks.generationCount = ++gCurrentGenerationCount;
+  tasks.layoutContext = layoutContext;
+
+  const YGConfigRef config = roots[0]->getConfig();
+  bool sharesConfig = true;
+  for (uint32_t i = 1; i < count; i++) {
+    sharesConfig = sharesConfig && roots[i]->getConfig() == config;
+  }
+  tasks.isExecutorTask =
+      count > 1 && sharesConfig && config->layoutExecutor != nullptr;
+  if (tasks.isExecutorTask) {
+    config->layoutExecutor(config, &YGRunBatchLayoutTask, &tasks, count);
+  } else {
+    for (uint32_t i = 0; i < count; i++) {
+      YGRunBatchLayoutTask(&tasks, i);
+    }
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    const YGMarkerLayoutData& rootData = tasks.layoutMarkerData[i];
+    YGAccumulateMarkerLayoutData(marker.data, rootData);
+    if (layoutData != nullptr) {
+      layoutData[i] = rootData;
+    }
+  }
+}
+
+void YGNodeCalculateLayoutBatch(
+    const YGNodeRef roots[],
+    const YGLayoutConstraints constraints[],
+    const uint32_t count,
+    YGMarkerLayoutData layoutData[]) {
+  YGNodeCalculateLayoutBatchWithContext(
+      roots, constraints, count, layoutData, nullptr);
+}
+
 void YGNodeCalculateLayout(
     const YGNodeRef node,
     const float ownerWidth,
@@ -4182,6 +6024,178 @@ void YGNodeCalculateLayout(
       node, ownerWidth, ownerHeight, ownerDirection, nullptr);
 }
 
+struct YGLayoutJob {
+  YGNodeRef root;
+  // Private copy of the root, laid out in place of it. Its descendants are
+  // copied when layout first changes them, see YGLayoutJobCloneNode.
+  YGNodeRef copy;
+  // Copy of the config of the root, used by the private copy of the root and
+  // threaded through the layout. Other private copies keep the configs of the
+  // nodes they copy.
+  YGConfigRef config;
+  float ownerWidth;
+  float ownerHeight;
+  YGDirection ownerDirection;
+  void* layoutContext;
+  // All steps share one generation, so that results of nodes completed in
+  // earlier steps are reused from their caches.
+  uint32_t generationCount;
+  uint32_t stepCount;
+};
+
+// Copies nodes of the tree being laid out in place of the clone callbacks of
+// their configs, which are meant for the tree itself.
+static YGNodeRef YGLayoutJobCloneNode(
+    const YGNodeRef node,
+    const YGNodeRef /*owner*/,
+    int /*childIndex*/) {
+  return YGNodeClone(node);
+}
+
+// Frees the private copies of a subtree. Children which were not copied are
+// still owned by the tree being laid out.
+static void YGLayoutJobFreeCopies(const YGNodeRef copy) {
+  const YGVector children = copy->getChildren();
+  copy->clearChildren();
+  for (const YGNodeRef child : children) {
+    if (child->getOwner() == copy) {
+      child->setOwner(nullptr);
+      YGLayoutJobFreeCopies(child);
+    }
+  }
+  YGNodeFree(copy);
+}
+
+// Copies the layout of the private copies into the nodes they copy. Children
+// are matched by index, which only holds if the tree was not changed since the
+// job began.
+static void YGLayoutJobPublish(const YGNodeRef node, const YGNodeRef copy) {
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  YGAssertWithNode(
+      node,
+      childCount == YGNodeGetChildCount(copy),
+      "Cannot publish layout: the tree was changed while it was laid out.");
+  node->setLayout(copy->getLayout());
+  node->setLineIndex(copy->getLineIndex());
+  node->setHasNewLayout(copy->getHasNewLayout());
+  if (const YGStackLayoutState* stack = copy->getStackLayoutState()) {
+    node->setStackLayoutState(*stack);
+  } else {
+    node->clearStackLayoutState();
+  }
+  if (!copy->isDirty()) {
+    node->setDirty(false);
+  }
+
+  for (uint32_t i = 0; i < childCount; i++) {
+    const YGNodeRef child = node->getChild(i);
+    const YGNodeRef childCopy = copy->getChild(i);
+    if (childCopy != child) {
+      YGLayoutJobPublish(child, childCopy);
+    }
+  }
+}
+
+static void YGReportLayoutChanges(
+    const YGNodeRef node,
+    const YGLayoutChangedFunc layoutChanged,
+    void* const layoutContext) {
+  YGReportLayoutChange(node, layoutChanged, layoutContext);
+  for (const YGNodeRef child : node->getChildren()) {
+    YGReportLayoutChanges(child, layoutChanged, layoutContext);
+  }
+}
+
+YGLayoutJobRef YGLayoutBeginWithContext(
+    const YGNodeRef node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection ownerDirection,
+    void* layoutContext) {
+  const YGLayoutJobRef job = new YGLayoutJob();
+  job->root = node;
+  job->config = new YGConfig(*node->getConfig());
+  // Layout changes are reported for the nodes of the tree once the layout is
+  // published, and child layouts are not handed to the executor, as steps
+  // could not be interrupted while they run.
+  job->config->layoutChanged = nullptr;
+  job->config->layoutExecutor = nullptr;
+  job->copy = YGNodeClone(node);
+  job->copy->setConfig(job->config);
+  job->ownerWidth = ownerWidth;
+  job->ownerHeight = ownerHeight;
+  job->ownerDirection = ownerDirection;
+  job->layoutContext = layoutContext;
+  job->generationCount = ++gCurrentGenerationCount;
+  job->stepCount = 0;
+  return job;
+}
+
+YGLayoutJobRef YGLayoutBegin(
+    const YGNodeRef node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection ownerDirection) {
+  return YGLayoutBeginWithContext(
+      node, ownerWidth, ownerHeight, ownerDirection, nullptr);
+}
+
+bool YGLayoutStep(const YGLayoutJobRef job, const uint64_t budgetNs) {
+  if (job->copy == nullptr) {
+    return true;
+  }
+  marker::MarkerSection<YGMarkerLayout> marker{job->root};
+
+  // Every step reruns the pass from the root, skipping all nodes completed in
+  // earlier steps. Requiring more progress of every step guarantees that the
+  // pass completes, even if its deadline passes before any node is done.
+  YGLayoutPass layoutPass{job->config, job->generationCount};
+  const auto now = std::chrono::steady_clock::now();
+  const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::time_point::max() - now);
+  if (budgetNs < static_cast<uint64_t>(remaining.count())) {
+    layoutPass.hasDeadline = true;
+    layoutPass.deadline = now + std::chrono::nanoseconds(budgetNs);
+  }
+  layoutPass.minCompletedLayouts = ++job->stepCount;
+  layoutPass.cloneNode = &YGLayoutJobCloneNode;
+  YGNodeCalculateLayoutImpl(
+      job->copy,
+      job->ownerWidth,
+      job->ownerHeight,
+      job->ownerDirection,
+      marker.data,
+      job->layoutContext,
+      layoutPass);
+  if (layoutPass.isAborted) {
+    return false;
+  }
+
+  YGLayoutJobPublish(job->root, job->copy);
+  YGLayoutJobFreeCopies(job->copy);
+  job->copy = nullptr;
+  // Rounding may have changed nodes which were not copied, so the whole tree
+  // is checked for changes.
+  const YGLayoutChangedFunc layoutChanged =
+      job->root->getConfig()->layoutChanged;
+  if (layoutChanged != nullptr) {
+    YGReportLayoutChanges(job->root, layoutChanged, job->layoutContext);
+  }
+  return true;
+}
+
+bool YGLayoutIsDone(const YGLayoutJobRef job) {
+  return job->copy == nullptr;
+}
+
+void YGLayoutFree(const YGLayoutJobRef job) {
+  if (job->copy != nullptr) {
+    YGLayoutJobFreeCopies(job->copy);
+  }
+  delete job->config;
+  delete job;
+}
+
 void YGConfigSetLogger(const YGConfigRef config, YGLogger logger) {
   if (logger != nullptr) {
     config->setLogger(logger);
@@ -4259,6 +6273,58 @@ void* YGConfigGetContext(const YGConfigRef config) {
   return config->context;
 }
 
+void YGConfigSetBatchMeasureFunc(
+    const YGConfigRef config,
+    const YGBatchMeasureFunc batchMeasure) {
+  config->batchMeasure = batchMeasure;
+}
+
+void YGConfigSetMeasureMemoCapacity(
+    const YGConfigRef config,
+    const uint32_t capacity) {
+  config->measureMemo = capacity > 0
+      ? std::make_shared<YGMeasureMemo>(capacity)
+      : std::shared_ptr<YGMeasureMemo>();
+}
+
+void YGConfigSetLayoutMemoCapacity(
+    const YGConfigRef config,
+    const uint32_t capacity) {
+  config->layoutMemo = capacity > 0
+      ? std::make_shared<YGLayoutMemo>(capacity)
+      : std::shared_ptr<YGLayoutMemo>();
+}
+
+void YGConfigSetLayoutChangedFunc(
+    const YGConfigRef config,
+    const YGLayoutChangedFunc callback) {
+  config->layoutChanged = callback;
+}
+
+void YGConfigSetLayoutExecutor(
+    const YGConfigRef config,
+    const YGLayoutExecutorFunc executor) {
+  config->layoutExecutor = executor;
+}
+
+void YGConfigSetLayoutExecutorMinSubtreeSize(
+    const YGConfigRef config,
+    const uint32_t minSubtreeSize) {
+  config->layoutExecutorMinSubtreeSize = minSubtreeSize;
+}
+
+void YGConfigSetMeasureCacheCapacity(
+    const YGConfigRef config,
+    const uint32_t initialCapacity,
+    const uint32_t maxCapacity) {
+  YGAssertWithConfig(
+      config,
+      initialCapacity > 0 && initialCapacity <= maxCapacity,
+      "Measure cache capacities must satisfy 0 < initial <= max");
+  config->measureCacheCapacity = initialCapacity;
+  config->maxMeasureCacheCapacity = maxCapacity;
+}
+
 void YGConfigSetCloneNodeFunc(
     const YGConfigRef config,
     const YGCloneNodeFunc callback) {
@@ -19,6 +19,7 @@
 
 #include "YGEnums.h"
 #include "YGMacros.h"
+#include "YGMarker.h"
 #include "YGValue.h"
 
 YG_EXTERN_C_BEGIN
@@ -32,6 +33,16 @@ typedef struct YGConfig* YGConfigRef;
 
 typedef struct YGNode* YGNodeRef;
 
+typedef struct YGNodeArena* YGNodeArenaRef;
+
+typedef struct YGLayoutJob* YGLayoutJobRef;
+
+typedef struct YGLayoutConstraints {
+  float ownerWidth;
+  float ownerHeight;
+  YGDirection ownerDirection;
+} YGLayoutConstraints;
+
 typedef YGSize (*YGMeasureFunc)(
     YGNodeRef node,
     float width,
@@ -51,6 +62,29 @@ typedef int (*YGLogger)(
     va_list args);
 typedef YGNodeRef (
     *YGCloneNodeFunc)(YGNodeRef oldNode, YGNodeRef owner, int childIndex);
+typedef void (*YGLayoutChangedFunc)(
+    YGNodeRef node,
+    YGLayoutChange changes,
+    void* layoutContext);
+typedef struct YGMeasureRequest {
+  YGNodeRef node;
+  float width;
+  YGMeasureMode widthMode;
+  float height;
+  YGMeasureMode heightMode;
+  // Set by the batch measure function.
+  YGSize size;
+} YGMeasureRequest;
+typedef void (*YGBatchMeasureFunc)(
+    YGMeasureRequest* requests,
+    uint32_t count,
+    void* layoutContext);
+typedef void (*YGLayoutTaskFunc)(void* tasks, uint32_t taskIndex);
+typedef void (*YGLayoutExecutorFunc)(
+    YGConfigRef config,
+    YGLayoutTaskFunc runTask,
+    void* tasks,
+    uint32_t taskCount);
 
 // YGNode
 WIN_EXPORT YGNodeRef YGNodeNew(void);
@@ -86,12 +120,66 @@ WIN_EXPORT void YGNodeSetIsReferenceBaseline(
 
 WIN_EXPORT bool YGNodeIsReferenceBaseline(YGNodeRef node);
 
+// Calculates the layout of the tree rooted at `node`.
+//
+// All state of a layout pass is local to the call, so layouts of disjoint
+// trees may run concurrently on different threads, provided that:
+//  - no node is reachable from more than one of the trees being laid out,
+//  - configs shared between the trees are not modified while layout runs,
+//  - measure, baseline, clone, dirtied, logger and marker callbacks can be
+//    invoked concurrently.
+// Laying out the same tree from several threads at once is not supported.
 WIN_EXPORT void YGNodeCalculateLayout(
     const YGNodeRef node,
     const float availableWidth,
     const float availableHeight,
     const YGDirection ownerDirection);
 
+// Calculates the layouts of `count` independent trees, laying out `roots[i]`
+// with `constraints[i]`. This is equivalent to calling YGNodeCalculateLayout
+// for every root, but the roots share one generation and one layout marker,
+// which is started with the first root. If `layoutData` is not null, the
+// layout statistics of `roots[i]` are written to `layoutData[i]`.
+//
+// If all roots use the same config and it has a layout executor, every root is
+// laid out as one executor task, and the same requirements as for concurrent
+// YGNodeCalculateLayout calls apply.
+WIN_EXPORT void YGNodeCalculateLayoutBatch(
+    const YGNodeRef roots[],
+    const YGLayoutConstraints constraints[],
+    const uint32_t count,
+    YGMarkerLayoutData layoutData[]);
+
+// Starts a layout of the tree rooted at `node` that is calculated in steps, so
+// that a large layout can be interleaved with other work on the same thread.
+// The layout is calculated on private copies of the nodes it changes, and is
+// copied into the tree only once it is complete. Until then, the tree keeps
+// its previous layout.
+//
+// The tree and its configs must not be changed while the layout is in
+// progress. After any change, the job must be freed with YGLayoutFree, and a
+// new one begun. Publishing a layout asserts that nodes still have as many
+// children as when they were copied, but cannot detect other changes. Measure
+// and baseline functions are called with the private copies, which have the
+// same context and config as the nodes they copy.
+WIN_EXPORT YGLayoutJobRef YGLayoutBegin(
+    const YGNodeRef node,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection ownerDirection);
+
+// Continues the layout for about `budgetNs` nanoseconds, and returns whether
+// it is done. Work is interrupted between nodes, so a step can take longer
+// than its budget. The n-th step lays out or measures at least n nodes, so a
+// layout completes even with a budget of 0. Every step reports a layout
+// marker.
+WIN_EXPORT bool YGLayoutStep(const YGLayoutJobRef job, const uint64_t budgetNs);
+
+WIN_EXPORT bool YGLayoutIsDone(const YGLayoutJobRef job);
+
+// Frees the job. A layout that is not done yet is discarded.
+WIN_EXPORT void YGLayoutFree(const YGLayoutJobRef job);
+
 // Mark a node as dirty. Only valid for nodes with a custom measure function
 // set.
 //
@@ -108,6 +196,42 @@ WIN_EXPORT void YGNodeMarkDirtyAndPropogateToDescendants(const YGNodeRef node);
 
 WIN_EXPORT void YGNodePrint(const YGNodeRef node, const YGPrintOptions options);
 
+// Writes a binary snapshot of the tree rooted at `root` to `buffer`, and
+// returns its size in bytes. Nothing is written if `bufferSize` is smaller
+// than that, so calling it with a NULL buffer returns the size to allocate.
+// Snapshots contain the structure, styles, node types and measure content keys
+// of the tree, its computed layout with YGSnapshotOptionsLayout, and the layout
+// caches of its nodes with YGSnapshotOptionsLayoutCache.
+WIN_EXPORT size_t YGNodeSnapshotSave(
+    const YGNodeRef root,
+    const YGSnapshotOptions options,
+    void* buffer,
+    const size_t bufferSize);
+
+// Creates the tree saved in a snapshot with nodes of the given config, and
+// returns its root, or NULL if `data` is not a snapshot saved by this build of
+// Yoga. Nodes with equal styles share them. `data` can be mapped from a file,
+// and is not referenced after loading. Contexts and measure, baseline, dirtied
+// and print functions are not part of snapshots, and need to be set again.
+WIN_EXPORT YGNodeRef YGNodeSnapshotLoad(
+    const void* data,
+    const size_t size,
+    const YGConfigRef config);
+
+// Restores the layout caches saved in a snapshot onto the tree rooted at
+// `root`, so that laying it out again with the constraints it was saved with
+// does not recompute anything. Caches are only restored onto nodes whose
+// style, node type, measure content key, child count and config match the
+// saved ones, and nodes whose caches are not restored are marked dirty along
+// with their ancestors. Measure functions are assumed to measure as they did
+// when the snapshot was saved. Returns whether the caches of all nodes were
+// restored, or false without changing the tree if `data` is not a snapshot
+// with layout caches.
+WIN_EXPORT bool YGNodeSnapshotRestoreLayoutCache(
+    const YGNodeRef root,
+    const void* data,
+    const size_t size);
+
 WIN_EXPORT bool YGFloatIsUndefined(const float value);
 
 WIN_EXPORT bool YGNodeCanUseCachedMeasurement(
@@ -138,6 +262,26 @@ bool YGNodeHasBaselineFunc(YGNodeRef node);
 void YGNodeSetBaselineFunc(YGNodeRef node, YGBaselineFunc baselineFunc);
 YGDirtiedFunc YGNodeGetDirtiedFunc(YGNodeRef node);
 void YGNodeSetDirtiedFunc(YGNodeRef node, YGDirtiedFunc dirtiedFunc);
+// Identifies what the measure function of the node measures, e.g. a hash of
+// its text and font. Nodes with the same non-zero key must measure the same
+// for the same constraints, and share results through the measure memo of
+// their config (see YGConfigSetMeasureMemoCapacity). Zero opts out.
+WIN_EXPORT void YGNodeSetMeasureContentKey(YGNodeRef node, uint64_t key);
+WIN_EXPORT uint64_t YGNodeGetMeasureContentKey(YGNodeRef node);
+// Only lays out the children of a column which intersect the window from
+// offset to offset + extent along its main axis, widened by overscan on both
+// sides. Other children keep the size they were last laid out with, or
+// estimatedItemSize if they never were, so that the window can move without
+// shifting the children before it. Children outside the window are positioned
+// but not laid out. Ignored unless the node is a non-wrapping column whose
+// children neither flex nor are positioned absolutely.
+WIN_EXPORT void YGNodeSetVirtualizedWindow(
+    YGNodeRef node,
+    float offset,
+    float extent,
+    float estimatedItemSize,
+    float overscan);
+WIN_EXPORT void YGNodeClearVirtualizedWindow(YGNodeRef node);
 void YGNodeSetPrintFunc(YGNodeRef node, YGPrintFunc printFunc);
 WIN_EXPORT bool YGNodeGetHasNewLayout(YGNodeRef node);
 WIN_EXPORT void YGNodeSetHasNewLayout(YGNodeRef node, bool hasNewLayout);
@@ -399,6 +543,92 @@ WIN_EXPORT void YGConfigSetCloneNodeFunc(
     const YGConfigRef config,
     const YGCloneNodeFunc callback);
 
+// Lets layout measure the children of a container with a single call. Children
+// with measure functions which need to be measured when computing their flex
+// basis, or when being laid out by their parent, are collected, and the batch
+// measure function must set `size` of every request to what the measure
+// function of `node` would return for the given constraints. The results feed
+// the measurement cache as usual. Measurements not known in advance still use
+// the measure functions of the nodes. With a layout executor, the batch
+// measure function may be called concurrently.
+WIN_EXPORT void YGConfigSetBatchMeasureFunc(
+    const YGConfigRef config,
+    const YGBatchMeasureFunc batchMeasure);
+
+// Keeps up to `capacity` measure results of nodes with a measure content key,
+// least recently used first out, and reuses them for any node of any tree
+// using this config (or a copy of it) with the same key and constraints. The
+// memo is consulted before calling measure functions and may be used from
+// concurrent layouts. Setting a capacity replaces the memo, 0 removes it.
+WIN_EXPORT void YGConfigSetMeasureMemoCapacity(
+    const YGConfigRef config,
+    const uint32_t capacity);
+
+// Keeps up to `capacity` layout results of subtrees, least recently used first
+// out, and copies them into structurally identical subtrees of any tree using
+// this config (or a copy of it) laid out with the same constraints. Subtrees
+// are identical if their nodes have equal styles, node types and measure
+// content keys. Subtrees with measure functions but no measure content key, or
+// with baseline functions, are never memoized. Setting a capacity replaces the
+// memo, 0 removes it.
+//
+// Subtrees are looked up by a 64-bit hash of these properties. Results are
+// only used if the subtree also has the same shape and root style, but two
+// subtrees differing only in other properties of their descendants would
+// share results if their hashes collided.
+WIN_EXPORT void YGConfigSetLayoutMemoCapacity(
+    const YGConfigRef config,
+    const uint32_t capacity);
+
+// Called at the end of every layout calculation for each node whose computed
+// frame (left, top, width, height) differs from the frame it had when it was
+// last reported, with the changed parts as YGLayoutChange flags. Nodes are
+// reported the first time they are laid out. Nodes are not reported in any
+// particular order, and the tree must not be modified from the callback.
+WIN_EXPORT void YGConfigSetLayoutChangedFunc(
+    const YGConfigRef config,
+    const YGLayoutChangedFunc callback);
+
+// Lets layout fan out independent child subtrees to an executor. The executor
+// must call `runTask(tasks, i)` exactly once for every `i` in
+// [0, taskCount), possibly concurrently, and return once all calls finished.
+// It is never re-entered from one of these calls. While an executor is set,
+// measure, baseline and clone callbacks may be invoked from several threads.
+// Passing nullptr restores serial layout.
+WIN_EXPORT void YGConfigSetLayoutExecutor(
+    const YGConfigRef config,
+    const YGLayoutExecutorFunc executor);
+
+// Subtrees with fewer nodes than this are always laid out on the calling
+// thread, as handing them to the executor costs more than it saves.
+WIN_EXPORT void YGConfigSetLayoutExecutorMinSubtreeSize(
+    const YGConfigRef config,
+    const uint32_t minSubtreeSize);
+
+// Measurement caches of nodes start with `initialCapacity` entries. Once all
+// are in use, new measurements replace the least recently used ones, and nodes
+// that keep missing double the capacity of their cache, up to `maxCapacity`.
+// Hits, misses and evictions are reported in YGMarkerLayoutData.
+WIN_EXPORT void YGConfigSetMeasureCacheCapacity(
+    const YGConfigRef config,
+    const uint32_t initialCapacity,
+    const uint32_t maxCapacity);
+
+// Nodes created with (or cloned from a node using) a config that has a node
+// arena are allocated from that arena instead of the heap. Several configs may
+// share an arena. Configs do not own their arena.
+WIN_EXPORT void YGConfigSetNodeArena(
+    const YGConfigRef config,
+    const YGNodeArenaRef arena);
+
+// YGNodeArena
+WIN_EXPORT YGNodeArenaRef YGNodeArenaNew(void);
+// Frees the arena and every node still allocated from it, without walking any
+// tree. References to those nodes must not be used afterwards.
+WIN_EXPORT void YGNodeArenaFree(const YGNodeArenaRef arena);
+// Like YGNodeArenaFree, but keeps the arena's memory around for new nodes.
+WIN_EXPORT void YGNodeArenaReset(const YGNodeArenaRef arena);
+
 // Export only for C#
 WIN_EXPORT YGConfigRef YGConfigGetDefault(void);
 